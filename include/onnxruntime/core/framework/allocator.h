@@ -21,16 +21,21 @@ struct OrtArenaCfg {
                   initial_chunk_size_bytes(-1),
                   max_dead_bytes_per_chunk(-1),
                   initial_growth_chunk_size_bytes(-1),
-                  max_power_of_two_extend_bytes(-1) {}
+                  max_power_of_two_extend_bytes(-1),
+                  thread_local_cache_bytes(-1),
+                  huge_pages(-1) {}
   OrtArenaCfg(size_t max_mem, int arena_extend_strategy, int initial_chunk_size_bytes,
               int max_dead_bytes_per_chunk, int initial_growth_chunk_size_bytes,
-              int64_t max_power_of_two_extend_bytes)
+              int64_t max_power_of_two_extend_bytes, int64_t thread_local_cache_bytes = -1,
+              int huge_pages = -1)
       : max_mem(max_mem),
         arena_extend_strategy(arena_extend_strategy),
         initial_chunk_size_bytes(initial_chunk_size_bytes),
         max_dead_bytes_per_chunk(max_dead_bytes_per_chunk),
         initial_growth_chunk_size_bytes(initial_growth_chunk_size_bytes),
-        max_power_of_two_extend_bytes(max_power_of_two_extend_bytes) {}
+        max_power_of_two_extend_bytes(max_power_of_two_extend_bytes),
+        thread_local_cache_bytes(thread_local_cache_bytes),
+        huge_pages(huge_pages) {}
 
   size_t max_mem;                         // use 0 to allow ORT to choose the default
   int arena_extend_strategy;              // use -1 to allow ORT to choose the default, 0 = kNextPowerOfTwo, 1 = kSameAsRequested
@@ -38,13 +43,17 @@ struct OrtArenaCfg {
   int max_dead_bytes_per_chunk;           // use -1 to allow ORT to choose the default
   int initial_growth_chunk_size_bytes;    // use -1 to allow ORT to choose the default
   int64_t max_power_of_two_extend_bytes;  // use -1 to allow ORT to choose the default
+  int64_t thread_local_cache_bytes;       // use -1 to allow ORT to choose the default (disabled), see BFCArena
+  int huge_pages;                         // CPU arenas only. 0 = off, 1 = transparent, 2 = hugetlbfs. -1 = default (off)
 
   bool IsValid() {
     return arena_extend_strategy >= -1 && arena_extend_strategy <= 1 &&
            initial_chunk_size_bytes >= -1 &&
            max_dead_bytes_per_chunk >= -1 &&
            initial_growth_chunk_size_bytes >= -1 &&
-           max_power_of_two_extend_bytes >= -1;
+           max_power_of_two_extend_bytes >= -1 &&
+           thread_local_cache_bytes >= -1 &&
+           huge_pages >= -1 && huge_pages <= 2;
   }
 
   // config key names that we parse in FromKeyValuePairs
@@ -55,6 +64,8 @@ struct OrtArenaCfg {
     static constexpr const char* InitialGrowthChunkSizeBytes = "arena.initial_growth_chunk_size_bytes";
     static constexpr const char* MaxPowerOfTwoExtendBytes = "arena.max_power_of_two_extend_bytes";
     static constexpr const char* MaxMem = "arena.max_mem";
+    static constexpr const char* ThreadLocalCacheBytes = "arena.thread_local_cache_bytes";
+    static constexpr const char* HugePages = "arena.huge_pages";
   };
 
   static onnxruntime::common::Status FromKeyValuePairs(const OrtKeyValuePairs& kvps, OrtArenaCfg& cfg);
@@ -161,6 +172,10 @@ class IAllocator {
 
   const OrtMemoryInfo& Info() const { return memory_info_; };
 
+  // Returns any memory cached for the calling thread to the allocator's shared pool.
+  // Allocators without per-thread caches do nothing.
+  virtual void FlushCurrentThreadCache() {}
+
   // Each implementation of IAllocator can override and provide their own implementation
   virtual void GetStats(AllocatorStats* stats) {
     *stats = {};
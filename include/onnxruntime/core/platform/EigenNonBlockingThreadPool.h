@@ -39,7 +39,9 @@
 #pragma warning(disable : 4127)
 #pragma warning(disable : 4805)
 #endif
+#include <algorithm>
 #include <memory>
+#include <vector>
 #include "unsupported/Eigen/CXX11/ThreadPool"
 
 #if defined(__GNUC__)
@@ -789,6 +791,8 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
       ComputeCoprimes(i, &all_coprimes_.back());
     }
 
+    InitializeNumaNodes(thread_options.numa_nodes);
+
     // Eigen::MaxSizeVector has neither essential exception safety features
     // such as swap, nor it is movable. So we have to join threads right here
     // on exception
@@ -1323,6 +1327,36 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     return -1;
   }
 
+  // Number of NUMA nodes the workers are partitioned into.  1 unless the pool
+  // was created with ThreadOptions::numa_nodes spanning several nodes.
+  unsigned NumNumaNodes() const {
+    return static_cast<unsigned>(numa_node_workers_.size());
+  }
+
+  // Dense index in [0,NumNumaNodes()) of the node of worker q_idx.
+  unsigned NumaNodeOfWorker(unsigned q_idx) const {
+    assert(q_idx < num_threads_);
+    return worker_numa_node_[q_idx];
+  }
+
+  unsigned NumWorkersOnNumaNode(unsigned node) const {
+    assert(node < numa_node_workers_.size());
+    return static_cast<unsigned>(numa_node_workers_[node].size());
+  }
+
+  // RunInParallel, but with par_idx values [1,n) first pushed to the
+  // workers in node order, so that consecutive indices start on the
+  // same node rather than wherever the previous loop ran them.
+
+  void RunInParallelByNumaNode(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdiff_t block_size) {
+    PerThread* pt = GetPerThread();
+    InitializePreferredWorkers(pt->preferred_workers);
+    for (unsigned par_idx = 1; par_idx < n; ++par_idx) {
+      pt->preferred_workers[par_idx] = static_cast<int>(numa_ordered_workers_[(par_idx - 1) % num_threads_]);
+    }
+    RunInParallel(std::move(fn), n, block_size);
+  }
+
   void EnableSpinning() {
     spin_loop_status_ = SpinLoopStatus::kBusy;
   }
@@ -1498,6 +1532,31 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   const bool set_denormal_as_zero_;
   Eigen::MaxSizeVector<WorkerData> worker_data_;
   Eigen::MaxSizeVector<Eigen::MaxSizeVector<unsigned>> all_coprimes_;
+
+  // NUMA topology of the workers.  Node ids are remapped to dense indices,
+  // and every worker is on node 0 if the pool is not NUMA aware.
+  std::vector<unsigned> worker_numa_node_;                // node of each worker
+  std::vector<std::vector<unsigned>> numa_node_workers_;  // workers of each node
+  std::vector<unsigned> numa_ordered_workers_;            // all workers, grouped by node
+
+  void InitializeNumaNodes(const std::vector<int>& numa_nodes) {
+    std::vector<int> node_ids;
+    worker_numa_node_.resize(num_threads_);
+    for (unsigned i = 0; i < num_threads_; ++i) {
+      const int node_id = i < numa_nodes.size() ? std::max(numa_nodes[i], 0) : 0;
+      auto it = std::find(node_ids.begin(), node_ids.end(), node_id);
+      if (it == node_ids.end()) {
+        it = node_ids.insert(node_ids.end(), node_id);
+        numa_node_workers_.emplace_back();
+      }
+      const auto node = static_cast<unsigned>(it - node_ids.begin());
+      worker_numa_node_[i] = node;
+      numa_node_workers_[node].push_back(i);
+    }
+    for (const auto& workers : numa_node_workers_) {
+      numa_ordered_workers_.insert(numa_ordered_workers_.end(), workers.begin(), workers.end());
+    }
+  }
   std::atomic<unsigned> blocked_;  // Count of blocked workers, used as a termination condition
   std::atomic<bool> done_;
 
@@ -1651,9 +1710,34 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   // is that the thread is busy with other work, and we will avoid
   // "snatching" work from a thread which is just about to notice the
   // work itself.
+  //
+  // In a NUMA aware pool, a worker first tries every thread on its own
+  // node, and only moves on to the rest of the pool when its node has
+  // nothing left to steal.
 
   Task Steal(StealAttemptKind steal_kind) {
     PerThread* pt = GetPerThread();
+    if (numa_node_workers_.size() > 1 && pt->pool == this) {
+      const auto& node_workers = numa_node_workers_[worker_numa_node_[pt->thread_id]];
+      const unsigned node_size = static_cast<unsigned>(node_workers.size());
+      unsigned r = Rand(&pt->rand);
+      unsigned inc = all_coprimes_[node_size - 1][r % all_coprimes_[node_size - 1].size()];
+      unsigned victim = r % node_size;
+      for (unsigned i = 0; i < node_size; i++) {
+        WorkerData& td = worker_data_[node_workers[victim]];
+        if (td.GetStatus() == WorkerData::ThreadStatus::Active) {
+          Task t = td.queue.PopBack();
+          if (t) {
+            return t;
+          }
+        }
+        victim += inc;
+        if (victim >= node_size) {
+          victim -= node_size;
+        }
+      }
+    }
+
     unsigned size = num_threads_;
     unsigned num_attempts = (steal_kind == StealAttemptKind::TRY_ALL) ? size : 1;
     unsigned r = Rand(&pt->rand);
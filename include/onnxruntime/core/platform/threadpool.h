@@ -254,6 +254,22 @@ class ThreadPool {
   static void TryParallelFor(ThreadPool* tp, std::ptrdiff_t total, const TensorOpCost& cost_per_unit,
                              const std::function<void(std::ptrdiff_t first, std::ptrdiff_t last)>& fn);
 
+  // Number of NUMA nodes the threads of the pool are partitioned into.  This
+  // is 1 unless the pool was created NUMA aware (OrtThreadPoolParams::numa_aware)
+  // on a machine with several NUMA nodes.
+  static int NumNumaNodes(const ThreadPool* tp);
+
+  // Divides [0, total) into one contiguous slice per NUMA node, sized by the
+  // node's share of the threads, and calls fn(first, last) over blocks of
+  // block_size iterations.  Threads work through the slice of their own node
+  // before helping with the slices of other nodes.  The partition only depends
+  // on total, block_size and the pool, so a kernel that runs the same loop
+  // repeatedly, such as a GEMM partitioned over N, keeps each node streaming
+  // the same slice of the data.  Without several nodes this behaves like a
+  // parallel loop with a fixed block size.
+  static void TryParallelForByNumaNode(ThreadPool* tp, std::ptrdiff_t total, std::ptrdiff_t block_size,
+                                       const std::function<void(std::ptrdiff_t first, std::ptrdiff_t last)>& fn);
+
   // Directly schedule the 'total' tasks to the underlying threadpool, without
   // cutting them by halves
 
@@ -409,6 +425,9 @@ class ThreadPool {
 
   void SimpleParallelFor(std::ptrdiff_t total, const std::function<void(std::ptrdiff_t)>& fn);
 
+  void ParallelForByNumaNode(std::ptrdiff_t total, std::ptrdiff_t block_size,
+                             const std::function<void(std::ptrdiff_t first, std::ptrdiff_t last)>& fn);
+
   void Schedule(std::function<void()> fn);
 
   void StartProfiling();
@@ -3043,6 +3043,12 @@ struct OrtApi {
    *  Use -1 to allow ORT to choose the default 1GB for max_power_of_two_extend_bytes.
    *  Ultimately, the allocation size is determined by the allocation memory request.
    *  Further allocation sizes are governed by the arena extend strategy.
+   * "thread_local_cache_bytes": Size of the per-thread caches of small free chunks, which let threads reuse their own
+   *  freed chunks without taking the arena lock. Use 0 to disable the caches and -1 to allow ORT to choose the
+   *  default (disabled). Only used by arenas over CPU memory, and not by stream aware arenas.
+   * "huge_pages": Linux only, CPU arenas only. 1 = back arena regions with transparent huge pages,
+   *  2 = use hugetlbfs huge pages (MAP_HUGETLB), falling back to transparent huge pages when none are available.
+   *  Pages are placed on the NUMA node of the thread that first touches them. 0 or -1 (default) = disabled.
    *
    * \param[in] arena_config_keys Keys to configure the arena
    * \param[in] arena_config_values Values to configure the arena
@@ -67,6 +67,16 @@ static const char* const kOrtSessionOptionsEnableQuantQDQCleanup = "session.enab
 // GeluApproximation has side effects which may change the inference results. It is disabled by default due to this.
 static const char* const kOrtSessionOptionsEnableGeluApproximation = "optimization.enable_gelu_approximation";
 
+// Domain of the FastGelu node emitted by the FastGelu fusion in graph optimization.
+// "com.microsoft": fuse into the contrib FastGelu (default).
+// "com.my_virtual_npu": fuse into the my_cpu FastGelu. Only subgraphs assigned to the CPU EP are fused in this mode.
+static const char* const kOrtSessionOptionsFastGeluFusionDomain = "optimization.fast_gelu_fusion_domain";
+
+// Enable or disable fusing MatMul with a following activation on the CPU EP. "0": disable; "1": enable.
+// The default is "0". The fused kernel applies GELU, Relu, Sigmoid or Tanh to each GEMM tile while it is in cache.
+// The DML EP fuses MatMul with Softmax regardless of this setting.
+static const char* const kOrtSessionOptionsEnableMatMulActivationFusion = "optimization.enable_matmul_activation_fusion";
+
 // Enable or disable Cast chain elimination in graph optimization. "0": disable; "1": enable. The default is "0".
 // CastElimination with chain elimination has side effects which may change the inference results. It is disabled by default due to this.
 static const char* const kOrtSessionOptionsEnableCastChainElimination = "optimization.enable_cast_chain_elimination";
@@ -154,6 +164,15 @@ static const char* const kOrtSessionOptionsUseDeviceAllocatorForInitializers = "
 static const char* const kOrtSessionOptionsConfigAllowInterOpSpinning = "session.inter_op.allow_spinning";
 static const char* const kOrtSessionOptionsConfigAllowIntraOpSpinning = "session.intra_op.allow_spinning";
 
+// Configure whether the per session intra_op thread pool is partitioned by NUMA node.
+// Each thread is assigned to the NUMA node of its affinity. Idle threads steal work from threads on their own node
+// first and only move to other nodes when their node has nothing left, and kernels can partition loops by node so
+// that each node streams its own slice of the data. The threads are pinned to physical cores if the pool size is not
+// set and no affinities are given. Thread affinities are required; without them the option has no effect.
+// "0": flat thread pool [DEFAULT]
+// "1": NUMA aware thread pool
+static const char* const kOrtSessionOptionsConfigIntraOpNumaAware = "session.intra_op.numa_aware";
+
 // Key for using model bytes directly for ORT format
 // If a session is created using an input byte array contains the ORT format model data,
 // By default we will copy the model bytes at the time of session creation to ensure the model bytes
@@ -409,6 +428,91 @@ static const char* const kOrtSessionOptionsDisableModelCompile = "session.disabl
 static const char* const kOrtSessionOptionsFailOnSuboptimalCompiledModel =
     "session.fail_on_suboptimal_compiled_model";
 
+// Enables dynamic batching of RunAsync requests.
+// Concurrent RunAsync calls with the same input/output names, element types and shapes (other than the batch axis)
+// are concatenated along the batch axis and executed as a single Run. Each output is split back along the same axis
+// and every caller's callback receives its own slice. Requests with non-CPU or string inputs run unbatched.
+// The run options of the first request in a batch apply to the whole batch.
+// Option values:
+// - "0" or "1": Dynamic batching is disabled. [DEFAULT]
+// - ">1": Maximum combined batch size of a single Run.
+static const char* const kOrtSessionOptionsDynamicBatchingMaxBatchSize = "session.dynamic_batching_max_batch_size";
+
+// Maximum time in microseconds a queued RunAsync request waits for more requests before its batch is run.
+// Only used when dynamic batching is enabled. Default is "1000".
+static const char* const kOrtSessionOptionsDynamicBatchingTimeoutUs = "session.dynamic_batching_timeout_us";
+
+// Axis along which inputs are concatenated and outputs are split when dynamic batching is enabled.
+// Every input and output of a batched model must have this axis. Default is "0".
+static const char* const kOrtSessionOptionsDynamicBatchingAxis = "session.dynamic_batching_axis";
+
+// Enables record-and-replay execution for fixed-shape models that run entirely on the CPU EP in a single stream.
+// The first run with a given set of input shapes executes normally and produces the memory pattern for them.
+// The second run records it: the node order, the values released after each node and the activation buffers are
+// frozen. Later runs with the same input shapes replay that recording with minimal per-node bookkeeping. A change of
+// input shapes drops the recording. Runs with profiling enabled, and runs concurrent with a replay, use the regular
+// executor. Models with control flow nodes or nodes assigned to other EPs are not replayed.
+// Option values:
+// - "0": Replay is disabled. [DEFAULT]
+// - "1": Replay is enabled.
+static const char* const kOrtSessionOptionsEnableCpuReplay = "session.enable_cpu_replay";
+
+// Size in bytes of the per-thread caches of small free chunks in the CPU EP arena.
+// Chunks freed by a thread are kept in its cache and reused by its next allocations of a similar size without taking
+// the arena lock, which reduces contention between concurrent Run calls. Cached chunks are returned to the arena when
+// a cache is full, before an allocation would fail for lack of memory, and, for the thread that called Run, at the end
+// of the run.
+// Only used if the CPU memory arena is enabled. Use "0" to disable the caches. [DEFAULT: "0"]
+static const char* const kOrtSessionOptionsCpuArenaThreadLocalCacheBytes = "session.cpu_arena_thread_local_cache_bytes";
+
+// Backs the regions of the CPU EP arena with huge pages on Linux, which reduces dTLB misses for large weights and
+// activations. Regions are left untouched by the arena, so each page is placed on the NUMA node of the thread that
+// first writes it. Only used if the CPU memory arena is enabled.
+// Option values:
+// - "0": Regular pages. [DEFAULT]
+// - "1": Transparent huge pages (madvise(MADV_HUGEPAGE)).
+// - "2": hugetlbfs huge pages (MAP_HUGETLB), falling back to transparent huge pages if the pool is exhausted.
+static const char* const kOrtSessionOptionsCpuArenaHugePages = "session.cpu_arena_huge_pages";
+
+// Runs models with ExecutionMode::ORT_PARALLEL on a critical-path-aware executor. Ready nodes are ordered by the
+// estimated time from the node to the end of the graph, so the longest chain of nodes is started first, and idle
+// threads steal ready nodes from busy ones. Node costs start from a FLOP estimate of the static shapes and are
+// replaced by the measured node times after the first run. Branches run on the intra-op thread pool so that they
+// share the cores with the intra-op parallelism of the kernels. Only used for models whose nodes all run on the CPU
+// EP without control flow; others, and runs with profiling enabled, use the regular parallel executor.
+// Option values:
+// - "0": Use the regular parallel executor. [DEFAULT]
+// - "1": Use the critical-path-aware executor.
+static const char* const kOrtSessionOptionsCriticalPathExecutor = "session.inter_op.critical_path_executor";
+
+// Uses the intra-op thread pool during session initialization to create the kernels of the CPU EP and to pre-pack
+// their constant initializers concurrently, which reduces the load time of large models.
+// Kernels of other EPs are created and pre-packed on the calling thread.
+// Option values:
+// - "0": Initialize on the calling thread. [DEFAULT]
+// - "1": Initialize concurrently.
+static const char* const kOrtSessionOptionsParallelInitialization = "session.parallel_initialization";
+
+// Shares the pre-packed weights of the CPU EP between processes that load the same model on a host (Linux only).
+// The value is a prefix for the names of the shared memory segments in /dev/shm, e.g. "ort-my-model".
+// Each pre-packed weight is stored in a segment named after the prefix and a hash of its contents. The first process
+// to pre-pack a weight creates the segment and later processes map it read-only instead of keeping their own copy.
+// Segments are kept after the processes exit so that restarted processes reuse them; remove them with
+// `rm /dev/shm/<prefix>-*` when the model is retired.
+// Initializers stored in external data files are already memory mapped and shared through the page cache.
+// Not used if pre-packed weights are saved with the model. [DEFAULT: "" (disabled)]
+static const char* const kOrtSessionOptionsSharedMemoryPrepackedWeightsPrefix =
+    "session.shared_memory_prepacked_weights_prefix";
+
+// Pages in the CPU initializers of the main graph on a background thread once the session is initialized.
+// Initializers in external data files are memory mapped and are otherwise read from disk when a kernel first touches
+// them. The prefetch follows the execution plan order, so the first Run can overlap with loading the later weights.
+// Initializers only used by subgraphs, e.g. a rarely taken If branch, are still loaded on demand.
+// Option values:
+// - "0": Initializers are paged in on first use. [DEFAULT]
+// - "1": Initializers are prefetched in the background.
+static const char* const kOrtSessionOptionsPrefetchInitializers = "session.prefetch_initializers";
+
 // THIS OPTION IS NOT A REGULAR SESSION OPTION SINCE IT CAN BE MODIFIED AT ANY TIME
 // Meant to be used with SetEpDynamicOptions
 // options for HTP performance mode: "burst", "balanced", "default", "high_performance",
@@ -50,6 +50,18 @@ class GQAAttentionBase {
 
   bool use_smooth_softmax_;
 
+  // int8 past/present key and value, with one float scale per (batch, kv head, position) row. Only for T = float.
+  struct QuantizedKVCache {
+    const int8_t* past_key;
+    const int8_t* past_value;
+    const float* past_key_scale;
+    const float* past_value_scale;
+    int8_t* present_key;
+    int8_t* present_value;
+    float* present_key_scale;
+    float* present_value_scale;
+  };
+
   template <typename T>
   Status ApplyAttention(const T* Q,                                 // Q data with shape BxNxSxH
                         const T* K,                                 // K data with shape BxN_kvxSxH
@@ -65,7 +77,8 @@ class GQAAttentionBase {
                         const Tensor* seqlens_k,                    // past sequence lengths tensor
                         GroupQueryAttentionParameters& parameters,  // attention parameters
                         AllocatorPtr allocator,                     // allocator for temporary tensors
-                        OpKernelContext* context) const {
+                        OpKernelContext* context,
+                        const QuantizedKVCache* quantized_cache = nullptr) const {  // int8 cache, if used
     const bool is_prompt = parameters.is_first_prompt;
     const int batch_size = parameters.batch_size;
     const int sequence_length = parameters.sequence_length;
@@ -89,10 +102,18 @@ class GQAAttentionBase {
     auto attention_probs = allocator->Alloc(bytes);
     BufferUniquePtr scratch_buffer(attention_probs, BufferDeleter(allocator));
 
-    const T* past_key_data = past_key != nullptr ? past_key->Data<T>() : nullptr;
-    T* present_key_data = present_key != nullptr ? present_key->MutableData<T>() : nullptr;
-    const T* past_value_data = past_value != nullptr ? past_value->Data<T>() : nullptr;
-    T* present_value_data = present_value != nullptr ? present_value->MutableData<T>() : nullptr;
+    // With an int8 cache the new rows are appended to the cache up front, and the cache is dequantized per head
+    // as it is consumed, so the T typed past and present pointers stay null.
+    const T* past_key_data = nullptr;
+    T* present_key_data = nullptr;
+    const T* past_value_data = nullptr;
+    T* present_value_data = nullptr;
+    if (quantized_cache == nullptr) {
+      past_key_data = past_key != nullptr ? past_key->Data<T>() : nullptr;
+      present_key_data = present_key != nullptr ? present_key->MutableData<T>() : nullptr;
+      past_value_data = past_value != nullptr ? past_value->Data<T>() : nullptr;
+      present_value_data = present_value != nullptr ? present_value->MutableData<T>() : nullptr;
+    }
 
     const T* attention_bias_data = attention_bias != nullptr ? attention_bias->Data<T>() : nullptr;
     auto attention_bias_shape = attention_bias != nullptr ? attention_bias->Shape().GetDims() : gsl::span<const int64_t>{};
@@ -100,6 +121,30 @@ class GQAAttentionBase {
     bool past_present_share_buffer = past_key_data == present_key_data && past_value_data == present_value_data;
 
     const T* k = packed_qkv ? Q + num_heads_ * sequence_length * head_size : K;
+    const T* v = packed_qkv ? Q + (num_heads_ + kv_num_heads_) * sequence_length * head_size : V;
+
+    const int8_t* present_key_quant = nullptr;
+    const float* present_key_scale = nullptr;
+    const int8_t* present_value_quant = nullptr;
+    const float* present_value_scale = nullptr;
+    if constexpr (std::is_same_v<T, float>) {
+      if (quantized_cache != nullptr) {
+        AppendToQuantizedCache(k, quantized_cache->past_key, quantized_cache->past_key_scale,
+                               quantized_cache->present_key, quantized_cache->present_key_scale,
+                               seqlens_k->Data<int32_t>(), batch_size, sequence_length, seqlen_past_kv_cache,
+                               seqlen_present_kv_cache, head_size, packed_qkv, is_prompt, tp);
+        AppendToQuantizedCache(v, quantized_cache->past_value, quantized_cache->past_value_scale,
+                               quantized_cache->present_value, quantized_cache->present_value_scale,
+                               seqlens_k->Data<int32_t>(), batch_size, sequence_length, seqlen_past_kv_cache,
+                               seqlen_present_kv_cache, head_size, packed_qkv, is_prompt, tp);
+        present_key_quant = quantized_cache->present_key;
+        present_key_scale = quantized_cache->present_key_scale;
+        present_value_quant = quantized_cache->present_value;
+        present_value_scale = quantized_cache->present_value_scale;
+      }
+    } else {
+      ORT_RETURN_IF(quantized_cache != nullptr, "An int8 key/value cache is only supported with float inputs");
+    }
 
     T* output_qk_buffer = output_qk != nullptr ? output_qk->MutableData<T>() : nullptr;
 
@@ -107,34 +152,232 @@ class GQAAttentionBase {
       ComputeAttentionProbs(static_cast<T*>(attention_probs), Q, k, head_sink, seqlens_k->Data<int32_t>(), attention_bias_data,
                             batch_size, sequence_length, total_sequence_length, attention_bias_shape, seqlen_past_kv_cache,
                             seqlen_present_kv_cache, head_size, past_key_data, present_key_data, output_qk_buffer,
-                            past_present_share_buffer, packed_qkv, is_prompt, tp, allocator);
+                            past_present_share_buffer, packed_qkv, is_prompt, tp, allocator,
+                            present_key_quant, present_key_scale);
 
       // Compute the attentionScore * Value: out(B, N, S, H_v) = attention_probs(B, N, S, T) x V(B, N, T, H_v)
-      const T* v = packed_qkv ? Q + (num_heads_ + kv_num_heads_) * sequence_length * head_size : V;
       ComputeVxAttentionScore(output->MutableData<T>(), static_cast<T*>(attention_probs), v,
                               seqlens_k->Data<int32_t>(),
                               batch_size, sequence_length, seqlen_past_kv_cache, seqlen_present_kv_cache, head_size,
                               hidden_size, past_value_data, present_value_data, past_present_share_buffer, packed_qkv,
-                              is_prompt, tp, allocator);
+                              is_prompt, tp, allocator, present_value_quant, present_value_scale);
     } else {
       ComputeAttentionProbs(static_cast<float*>(attention_probs), Q, k, head_sink, seqlens_k->Data<int32_t>(), attention_bias_data,
                             batch_size, sequence_length, total_sequence_length, attention_bias_shape, seqlen_past_kv_cache,
                             seqlen_present_kv_cache, head_size, past_key_data, present_key_data, output_qk_buffer,
-                            past_present_share_buffer, packed_qkv, is_prompt, tp, allocator);
+                            past_present_share_buffer, packed_qkv, is_prompt, tp, allocator,
+                            present_key_quant, present_key_scale);
 
       // Compute the attentionScore * Value: out(B, N, S, H_v) = attention_probs(B, N, S, T) x V(B, N, T, H_v)
-      const T* v = packed_qkv ? Q + (num_heads_ + kv_num_heads_) * sequence_length * head_size : V;
       ComputeVxAttentionScore(output->MutableData<T>(), static_cast<float*>(attention_probs), v,
                               seqlens_k->Data<int32_t>(),
                               batch_size, sequence_length, seqlen_past_kv_cache, seqlen_present_kv_cache, head_size,
                               hidden_size, past_value_data, present_value_data, past_present_share_buffer, packed_qkv,
-                              is_prompt, tp, allocator);
+                              is_prompt, tp, allocator, present_value_quant, present_value_scale);
     }
 
     return Status::OK();
   }
 
  private:
+  // Appends the new rows of K or V (B x N_kv x S x H, or packed QKV) to the int8 cache after the past rows of each
+  // sequence, quantized to symmetric int8 with one scale per row. The past rows are copied first when past and
+  // present are separate buffers.
+  void AppendToQuantizedCache(const float* chunk,            // new rows
+                              const int8_t* past,            // past cache, or nullptr
+                              const float* past_scale,       // past cache scales, or nullptr
+                              int8_t* present,               // present cache
+                              float* present_scale,          // present cache scales
+                              const int32_t* seqlens_k,      // total - 1 sequence lengths
+                              const size_t batch_size,       // batch size
+                              const size_t sequence_length,  // new rows per sequence (S)
+                              const size_t past_buffer_sequence_length,
+                              const size_t present_buffer_sequence_length,
+                              const size_t head_size,
+                              const bool packed_qkv,
+                              const bool is_prompt,
+                              ThreadPool* tp) const {
+    const ptrdiff_t packed_batch_stride =
+        packed_qkv ? SafeInt<ptrdiff_t>(num_heads_ + 2 * kv_num_heads_) * sequence_length * head_size
+                   : SafeInt<ptrdiff_t>(0);
+    const size_t kv_input_chunk_length = sequence_length * head_size;
+    const bool past_present_share_buffer = past == present;
+
+    TensorOpCost unit_cost;
+    unit_cost.bytes_loaded = static_cast<double>(kv_input_chunk_length * sizeof(float));
+    unit_cost.bytes_stored = static_cast<double>(kv_input_chunk_length);
+    unit_cost.compute_cycles = static_cast<double>(3 * kv_input_chunk_length);
+
+    ThreadPool::TryParallelFor(tp, batch_size * kv_num_heads_, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      for (std::ptrdiff_t i = begin; i != end; ++i) {
+        const size_t batch_index = i / kv_num_heads_;
+        const size_t head_index = i % kv_num_heads_;
+        const size_t total_seqlen = static_cast<size_t>(seqlens_k[batch_index]) + 1;
+        const size_t past_seqlen = is_prompt ? 0 : total_seqlen - sequence_length;
+
+        int8_t* present_chunk = present + i * present_buffer_sequence_length * head_size;
+        float* present_scale_chunk = present_scale + i * present_buffer_sequence_length;
+        if (!past_present_share_buffer) {
+          memset(present_chunk, 0, present_buffer_sequence_length * head_size);
+          memset(present_scale_chunk, 0, present_buffer_sequence_length * sizeof(float));
+          if (past != nullptr && past_seqlen > 0) {
+            memcpy(present_chunk, past + i * past_buffer_sequence_length * head_size, past_seqlen * head_size);
+            memcpy(present_scale_chunk, past_scale + i * past_buffer_sequence_length, past_seqlen * sizeof(float));
+          }
+        }
+
+        const float* src = packed_qkv ? chunk + packed_batch_stride * batch_index + kv_input_chunk_length * head_index
+                                      : chunk + kv_input_chunk_length * i;
+        for (size_t row = 0; row < sequence_length; ++row) {
+          const float* src_row = src + row * head_size;
+          const size_t position = past_seqlen + row;
+
+          float min_value, max_value;
+          MlasFindMinMaxElement(src_row, &min_value, &max_value, head_size);
+          const float max_abs = std::max(-min_value, max_value);
+          const float scale = max_abs > 0.0f ? max_abs / 127.0f : 1.0f;
+
+          MlasQuantizeLinear<int8_t>(src_row, present_chunk + position * head_size, head_size, scale, 0);
+          present_scale_chunk[position] = scale;
+        }
+      }
+    });
+  }
+
+  // fp32 bytes of int8 cache rows dequantized at a time, so a tile stays in L1 while the heads of its group use it
+  static constexpr size_t kQuantizedCacheTileBytes = 16 * 1024;
+
+  static size_t QuantizedCacheTileRows(size_t head_size) {
+    return std::max<size_t>(1, kQuantizedCacheTileBytes / (head_size * sizeof(float)));
+  }
+
+  // Dequantizes `rows` rows of the int8 cache into `output`.
+  static void DequantizeCacheRows(const int8_t* cache, const float* scale, size_t rows, size_t head_size,
+                                  float* output) {
+    for (size_t row = 0; row < rows; ++row) {
+      MlasDequantizeLinear<int8_t>(cache + row * head_size, output + row * head_size, head_size, scale[row], 0);
+    }
+  }
+
+  // attention_probs(B, N, S, T) = alpha x Q(B, N, S, H) x K'(B, N_kv, H, T) with an int8 key cache.
+  // Runs per (batch, kv head): each L1-sized tile of K is dequantized once and multiplied with the queries of
+  // all the heads that share the kv head.
+  void ComputeQuantizedAttentionProbs(float* attention_probs,                     // output buffer with size BxNxSxT
+                                      const float* Q,                             // Q data, or packed QKV
+                                      const int8_t* present_key,                  // int8 present key BxN_kvxTxH
+                                      const float* present_key_scale,             // scales of present key BxN_kvxT
+                                      const int32_t* seqlens_k,                   // total - 1 sequence lengths
+                                      const size_t batch_size,
+                                      const size_t sequence_length,               // S
+                                      const size_t present_buffer_sequence_length,
+                                      const size_t head_size,
+                                      const float alpha,
+                                      const bool packed_qkv,
+                                      ThreadPool* tp,
+                                      AllocatorPtr allocator) const {
+    const ptrdiff_t packed_batch_stride =
+        packed_qkv ? SafeInt<ptrdiff_t>(num_heads_ + 2 * kv_num_heads_) * sequence_length * head_size
+                   : SafeInt<ptrdiff_t>(0);
+    const size_t kv_num_heads_factor = num_heads_ / kv_num_heads_;
+    const size_t q_input_chunk_length = sequence_length * head_size;
+    const size_t tile_rows = QuantizedCacheTileRows(head_size);
+
+    TensorOpCost unit_cost;
+    unit_cost.compute_cycles = static_cast<double>(SafeInt<ptrdiff_t>(2) * kv_num_heads_factor * sequence_length *
+                                                   head_size * present_buffer_sequence_length);
+    unit_cost.bytes_loaded = static_cast<double>(present_buffer_sequence_length * (head_size + sizeof(float)) +
+                                                 kv_num_heads_factor * q_input_chunk_length * sizeof(float));
+    unit_cost.bytes_stored = static_cast<double>(kv_num_heads_factor * sequence_length *
+                                                 present_buffer_sequence_length * sizeof(float));
+
+    ThreadPool::TryParallelFor(tp, batch_size * kv_num_heads_, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      float* tile = static_cast<float*>(allocator->Alloc(tile_rows * head_size * sizeof(float)));
+      BufferUniquePtr tile_buffer(tile, BufferDeleter(allocator));
+
+      for (std::ptrdiff_t i = begin; i != end; ++i) {
+        const size_t batch_index = i / kv_num_heads_;
+        const size_t kv_head_index = i % kv_num_heads_;
+        const size_t total_seqlen = static_cast<size_t>(seqlens_k[batch_index]) + 1;
+        const int8_t* k = present_key + i * present_buffer_sequence_length * head_size;
+        const float* k_scale = present_key_scale + i * present_buffer_sequence_length;
+
+        for (size_t row = 0; row < total_seqlen; row += tile_rows) {
+          const size_t rows = std::min(tile_rows, total_seqlen - row);
+          DequantizeCacheRows(k + row * head_size, k_scale + row, rows, head_size, tile);
+
+          for (size_t group_index = 0; group_index < kv_num_heads_factor; ++group_index) {
+            const size_t head_index = kv_head_index * kv_num_heads_factor + group_index;
+            const float* q = packed_qkv ? Q + packed_batch_stride * batch_index + q_input_chunk_length * head_index
+                                        : Q + q_input_chunk_length * (batch_index * num_heads_ + head_index);
+            const ptrdiff_t output_offset = SafeInt<ptrdiff_t>(batch_index * num_heads_ + head_index) *
+                                            sequence_length * present_buffer_sequence_length;
+            float* output = attention_probs + output_offset + row;
+            math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, rows, head_size, alpha, q,
+                                            static_cast<int>(head_size), tile, static_cast<int>(head_size),
+                                            0.0f /*beta*/, output, static_cast<int>(present_buffer_sequence_length),
+                                            nullptr);
+          }
+        }
+      }
+    });
+  }
+
+  // output(B, S, N, H) = attention_probs(B, N, S, T) x V(B, N_kv, T, H) with an int8 value cache.
+  // Runs per (batch, kv head) like ComputeQuantizedAttentionProbs, accumulating the products of the V tiles.
+  void ComputeQuantizedVxAttentionScore(float* output,                           // output buffer with size BxSxNxH
+                                        const float* attention_probs,            // Attention probs with size BxNxSxT
+                                        const int8_t* present_value,             // int8 present value BxN_kvxTxH
+                                        const float* present_value_scale,        // scales of present value BxN_kvxT
+                                        const int32_t* seqlens_k,                // total - 1 sequence lengths
+                                        const size_t batch_size,
+                                        const size_t sequence_length,            // S
+                                        const size_t present_buffer_sequence_length,
+                                        const size_t head_size,
+                                        const size_t hidden_size,                // hidden size of output
+                                        ThreadPool* tp,
+                                        AllocatorPtr allocator) const {
+    const size_t kv_num_heads_factor = num_heads_ / kv_num_heads_;
+    const size_t tile_rows = QuantizedCacheTileRows(head_size);
+
+    TensorOpCost unit_cost;
+    unit_cost.compute_cycles = static_cast<double>(SafeInt<ptrdiff_t>(2) * kv_num_heads_factor * sequence_length *
+                                                   head_size * present_buffer_sequence_length);
+    unit_cost.bytes_loaded = static_cast<double>(present_buffer_sequence_length * (head_size + sizeof(float)) +
+                                                 kv_num_heads_factor * sequence_length *
+                                                     present_buffer_sequence_length * sizeof(float));
+    unit_cost.bytes_stored = static_cast<double>(kv_num_heads_factor * sequence_length * head_size * sizeof(float));
+
+    ThreadPool::TryParallelFor(tp, batch_size * kv_num_heads_, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      float* tile = static_cast<float*>(allocator->Alloc(tile_rows * head_size * sizeof(float)));
+      BufferUniquePtr tile_buffer(tile, BufferDeleter(allocator));
+
+      for (std::ptrdiff_t i = begin; i != end; ++i) {
+        const size_t batch_index = i / kv_num_heads_;
+        const size_t kv_head_index = i % kv_num_heads_;
+        const size_t total_seqlen = static_cast<size_t>(seqlens_k[batch_index]) + 1;
+        const int8_t* v = present_value + i * present_buffer_sequence_length * head_size;
+        const float* v_scale = present_value_scale + i * present_buffer_sequence_length;
+
+        for (size_t row = 0; row < total_seqlen; row += tile_rows) {
+          const size_t rows = std::min(tile_rows, total_seqlen - row);
+          DequantizeCacheRows(v + row * head_size, v_scale + row, rows, head_size, tile);
+
+          for (size_t group_index = 0; group_index < kv_num_heads_factor; ++group_index) {
+            const size_t head_index = kv_head_index * kv_num_heads_factor + group_index;
+            const ptrdiff_t probs_offset = SafeInt<ptrdiff_t>(batch_index * num_heads_ + head_index) *
+                                           sequence_length * present_buffer_sequence_length;
+            const float* probs = attention_probs + probs_offset + row;
+            float* output_current = output + (batch_index * sequence_length * num_heads_ + head_index) * head_size;
+            math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasNoTrans, sequence_length, head_size, rows, 1.0f, probs,
+                                            static_cast<int>(present_buffer_sequence_length), tile,
+                                            static_cast<int>(head_size), row == 0 ? 0.0f : 1.0f, output_current,
+                                            static_cast<int>(hidden_size), nullptr);
+          }
+        }
+      }
+    });
+  }
+
   // Helper function to compute the attention probs. It does 2 things:
   //  attention_probs(B, N, S, T) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, T, H -> B, N, H, T)
   //  attention_probs(B, N, S, T) = Softmax(attention_probs)
@@ -160,7 +403,9 @@ class GQAAttentionBase {
                              const bool packed_qkv,                                // whether Q, K, V are packed
                              const bool is_prompt,                                 // whether it is prompt
                              ThreadPool* tp,                                       // thread pool
-                             AllocatorPtr allocator) const {                       // allocator for temporary buffer
+                             AllocatorPtr allocator,                               // allocator for temporary buffer
+                             const int8_t* present_key_quant = nullptr,            // int8 present key, if quantized
+                             const float* present_key_scale = nullptr) const {     // scales of the int8 present key
     const ptrdiff_t packed_batch_stride =
         packed_qkv ? SafeInt<ptrdiff_t>(num_heads_ + 2 * kv_num_heads_) * sequence_length * head_size
                    : SafeInt<ptrdiff_t>(0);
@@ -170,7 +415,7 @@ class GQAAttentionBase {
     const size_t past_buff_chunk_length = past_buffer_sequence_length * head_size;        // L x H
     const size_t present_buff_chunk_length = present_buffer_sequence_length * head_size;  // T x H
 
-    if (!past_present_share_buffer) {
+    if (!past_present_share_buffer && present_key != nullptr) {
       memset((void*)present_key,
              0,
              batch_size * kv_num_heads_ * present_buffer_sequence_length * head_size * sizeof(T));
@@ -197,6 +442,14 @@ class GQAAttentionBase {
       unit_cost.bytes_stored += bytes_to_copy_key;
     }
 
+    if constexpr (std::is_same_v<T, float> && std::is_same_v<U, float>) {
+      if (nullptr != present_key_quant) {
+        ComputeQuantizedAttentionProbs(attention_probs, Q, present_key_quant, present_key_scale, seqlens_k,
+                                       batch_size, sequence_length, present_buffer_sequence_length, head_size, alpha,
+                                       packed_qkv, tp, allocator);
+      }
+    }
+
     ThreadPool::TryParallelFor(tp, loop_len, unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
       for (std::ptrdiff_t i = begin; i != end; ++i) {
         const size_t batch_index = i / num_heads_;
@@ -255,7 +508,9 @@ class GQAAttentionBase {
           q = Q + q_input_chunk_length * i;
         }
 
-        if constexpr (std::is_same<T, float>::value) {
+        if (nullptr != present_key_quant) {
+          // Q*K' was computed by ComputeQuantizedAttentionProbs
+        } else if constexpr (std::is_same<T, float>::value) {
           math::GemmEx<float, ThreadPool>(CblasNoTrans, CblasTrans, sequence_length, total_seqlen, head_size, alpha, q,
                                           static_cast<int>(head_size), k, static_cast<int>(head_size), 0.0f /*bata*/,
                                           output, static_cast<int>(present_buffer_sequence_length), nullptr);
@@ -388,7 +643,18 @@ class GQAAttentionBase {
                                const bool packed_qkv,                        // whether Q, K, V are packed
                                const bool is_prompt,                         // whether it is prompt
                                ThreadPool* tp,
-                               AllocatorPtr allocator) const {
+                               AllocatorPtr allocator,
+                               const int8_t* present_value_quant = nullptr,  // int8 present value, if quantized
+                               const float* present_value_scale = nullptr) const {
+    if constexpr (std::is_same_v<T, float> && std::is_same_v<U, float>) {
+      if (nullptr != present_value_quant) {
+        ComputeQuantizedVxAttentionScore(output, attention_probs, present_value_quant, present_value_scale, seqlens_k,
+                                         batch_size, sequence_length, present_buffer_sequence_length, head_size,
+                                         hidden_size, tp, allocator);
+        return;
+      }
+    }
+
     const ptrdiff_t packed_batch_stride =
         packed_qkv ? SafeInt<ptrdiff_t>(num_heads_ + 2 * kv_num_heads_) * sequence_length * head_size
                    : SafeInt<ptrdiff_t>(0);
@@ -397,7 +663,7 @@ class GQAAttentionBase {
     const size_t past_buff_chunk_length = past_buffer_sequence_length * head_size;        // L x H
     const size_t present_buff_chunk_length = present_buffer_sequence_length * head_size;  // T x H
 
-    if (!past_present_share_buffer) {
+    if (!past_present_share_buffer && present_value != nullptr) {
       memset((void*)present_value,
              0,
              batch_size * kv_num_heads_ * present_buffer_sequence_length * head_size * sizeof(T));
@@ -22,20 +22,22 @@ namespace onnxruntime {
 namespace contrib {
 
 // These ops are internal-only, so register outside of onnx
-#define REGISTER_KERNEL_TYPED(T)                                        \
-  ONNX_OPERATOR_TYPED_KERNEL_EX(                                        \
-      GroupQueryAttention,                                              \
-      kMSDomain,                                                        \
-      1,                                                                \
-      T,                                                                \
-      kCpuExecutionProvider,                                            \
-      KernelDefBuilder()                                                \
-          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())        \
-          .TypeConstraint("M", DataTypeImpl::GetTensorType<int32_t>()), \
+#define REGISTER_KERNEL_TYPED(T, ...)                                          \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                               \
+      GroupQueryAttention,                                                     \
+      kMSDomain,                                                               \
+      1,                                                                       \
+      T,                                                                       \
+      kCpuExecutionProvider,                                                   \
+      KernelDefBuilder()                                                       \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())               \
+          .TypeConstraint("T_CACHE", BuildKernelDefConstraints<__VA_ARGS__>()) \
+          .TypeConstraint("M", DataTypeImpl::GetTensorType<int32_t>()),        \
       GroupQueryAttention<T>);
 
-REGISTER_KERNEL_TYPED(float)
-REGISTER_KERNEL_TYPED(MLFloat16)
+// An int8 key/value cache is supported with float inputs
+REGISTER_KERNEL_TYPED(float, float, int8_t)
+REGISTER_KERNEL_TYPED(MLFloat16, MLFloat16)
 
 template <typename T>
 GroupQueryAttention<T>::GroupQueryAttention(const OpKernelInfo& info)
@@ -100,6 +102,45 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
 
   ORT_RETURN_IF_ERROR(group_query_attention_helper::CheckOutputs(output_qk, qk_output_));
 
+  // An int8 cache carries one scale per (batch, kv head, position) row
+  const Tensor* past_key_scale = context->Input<Tensor>(12);
+  const Tensor* past_value_scale = context->Input<Tensor>(13);
+  QuantizedKVCache quantized_cache = {};
+  const bool is_quantized_cache = present_k->IsDataType<int8_t>();
+  if (is_quantized_cache) {
+    if (past_key == nullptr || past_key_scale == nullptr || past_value_scale == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "past_key, past_value, past_key_scale and past_value_scale are required with an int8 "
+                             "key/value cache");
+    }
+    const TensorShape past_scale_shape({batch_size, kv_num_heads_, parameters.seqlen_past_kv_cache});
+    if (past_key_scale->Shape() != past_scale_shape || past_value_scale->Shape() != past_scale_shape) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "past_key_scale and past_value_scale are expected to have shape ", past_scale_shape,
+                             ", got ", past_key_scale->Shape(), " and ", past_value_scale->Shape());
+    }
+
+    const TensorShape present_scale_shape({batch_size, kv_num_heads_, present_kv_seqlen});
+    Tensor* present_key_scale = context->Output(4, present_scale_shape);
+    Tensor* present_value_scale = context->Output(5, present_scale_shape);
+    if (present_key_scale == nullptr || present_value_scale == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "present_key_scale and present_value_scale are required with an int8 key/value cache");
+    }
+
+    quantized_cache.past_key = past_key->Data<int8_t>();
+    quantized_cache.past_value = past_value->Data<int8_t>();
+    quantized_cache.past_key_scale = past_key_scale->Data<float>();
+    quantized_cache.past_value_scale = past_value_scale->Data<float>();
+    quantized_cache.present_key = present_k->MutableData<int8_t>();
+    quantized_cache.present_value = present_v->MutableData<int8_t>();
+    quantized_cache.present_key_scale = present_key_scale->MutableData<float>();
+    quantized_cache.present_value_scale = present_value_scale->MutableData<float>();
+  } else if (past_key_scale != nullptr || past_value_scale != nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "past_key_scale and past_value_scale are only used with an int8 key/value cache");
+  }
+
   AllocatorPtr allocator;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
 
@@ -216,7 +257,8 @@ Status GroupQueryAttention<T>::Compute(OpKernelContext* context) const {
   // Compute the attention score and apply the score to V
   return ApplyAttention(q_rotary, packed_qkv ? nullptr : k_rotary, packed_qkv ? nullptr : V.Get<Tensor>().Data<T>(),
                         head_sink_data, attention_bias, past_key, past_value, output, present_k, present_v,
-                        output_qk, seqlens_k, parameters, allocator, context);
+                        output_qk, seqlens_k, parameters, allocator, context,
+                        is_quantized_cache ? &quantized_cache : nullptr);
 }
 }  // namespace contrib
 }  // namespace onnxruntime
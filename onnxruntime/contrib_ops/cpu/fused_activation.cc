@@ -17,6 +17,12 @@ common::Status GetFusedActivationAttr(const OpKernelInfo& info, MLAS_ACTIVATION&
       activation.ActivationKind = MlasTanhActivation;
     } else if (activation_type == "Sigmoid") {
       activation.ActivationKind = MlasLogisticActivation;
+    } else if (activation_type == "Gelu") {
+      activation.ActivationKind = MlasGeluErfActivation;
+    } else if (activation_type == "FastGelu") {
+      activation.ActivationKind = MlasGeluTanhActivation;
+    } else if (activation_type == "Silu") {
+      activation.ActivationKind = MlasSiluActivation;
     } else {
       // The remaining activation types have additional parameters to be pulled out.
       size_t activation_params_count;
@@ -29,6 +35,9 @@ common::Status GetFusedActivationAttr(const OpKernelInfo& info, MLAS_ACTIVATION&
       } else if (activation_type == "HardSigmoid") {
         activation.ActivationKind = MlasHardSigmoidActivation;
         activation_params_count = 2;
+      } else if (activation_type == "QuickGelu") {
+        activation.ActivationKind = MlasQuickGeluActivation;
+        activation_params_count = 1;
       } else {
         return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT, "unimplemented activation: " + activation_type);
       }
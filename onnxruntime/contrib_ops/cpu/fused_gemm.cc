@@ -2,24 +2,26 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/math/gemm.h"
+#include "core/providers/cpu/math/gemm_matmul_common.h"
 
 namespace onnxruntime {
 namespace contrib {
 
-constexpr const char* ACTIVATION_NAME_PREFIX = "activation_";
-constexpr size_t ACTIVATION_NAME_PREFIX_LEN = 11;
-
 template <typename T>
 class FusedGemm final : public Gemm<T> {
  public:
   FusedGemm(const OpKernelInfo& info) : Gemm<T>(info) {
     std::string activation = info.GetAttrOrDefault<std::string>("activation", "");
-    NodeAttributes attrs;
-    for (const auto& p : info.node().GetAttributes()) {
-      if (p.first.size() > ACTIVATION_NAME_PREFIX_LEN && p.first.compare(0, ACTIVATION_NAME_PREFIX_LEN, ACTIVATION_NAME_PREFIX) == 0) {
-        attrs[p.first.substr(ACTIVATION_NAME_PREFIX_LEN)] = p.second;
+    NodeAttributes attrs = GetFusedActivationAttributes(info.node());
+
+    if constexpr (std::is_same_v<T, float>) {
+      MLAS_ACTIVATION mlas_activation;
+      if (GetMlasActivation(activation, attrs, mlas_activation)) {
+        this->mlas_activation_ = mlas_activation;
+        return;
       }
     }
+
     ORT_THROW_IF_ERROR(functors::ElementWiseRangedTransform<T>::Create(activation, attrs, this->activation_));
   }
 };
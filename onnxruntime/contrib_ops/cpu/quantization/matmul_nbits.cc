@@ -15,6 +15,7 @@
 #include "core/mlas/inc/mlas_q4.h"
 #include "core/providers/cpu/math/matmul_helper.h"
 #include "core/providers/common.h"
+#include "contrib_ops/cpu/fused_activation.h"
 #include "contrib_ops/cpu/quantization/matmul_nbits_helper.h"
 
 namespace onnxruntime {
@@ -72,6 +73,14 @@ GetComputeType<MLFloat16>(size_t nbits, size_t block_size, int64_t accuracy_leve
   // if HQNBIT_CompFp16 is not supported, will fallback to unpacked computation.
   return HQNBIT_CompFp16;
 }
+
+// The fp16 kernels have no fp32 output tiles to process, so the activation is applied to their output afterwards.
+void ApplyActivation(const MLAS_ACTIVATION& activation, MLFloat16* data, size_t size, AllocatorPtr& allocator) {
+  auto tmp_data_ptr = IAllocator::MakeUniquePtr<float>(allocator, size, true);
+  MlasConvertHalfToFloatBuffer(data, tmp_data_ptr.get(), size);
+  MlasActivation(&activation, tmp_data_ptr.get(), nullptr, 1, size, size);
+  MlasConvertFloatToHalfBuffer(tmp_data_ptr.get(), data, size);
+}
 #endif  // !MLAS_F16VEC_INTRINSICS_SUPPORTED || !MLAS_TARGET_ARM64
 
 }  // namespace
@@ -116,6 +125,8 @@ class MatMulNBits final : public OpKernel {
                 "Only 2b, 4b and 8b quantization is supported for MatMulNBits op, additional bits support is planned.");
     const Tensor* tensor_zero_point = nullptr;
     has_zp_input_ = info.TryGetConstantInput(InputIndex::zero_points, &tensor_zero_point);
+
+    ORT_ENFORCE(GetFusedActivationAttr(info, activation_).IsOK());
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -145,6 +156,11 @@ class MatMulNBits final : public OpKernel {
 
   bool has_zp_input_{false};
 
+  // applied by MLAS to each output tile
+  MLAS_ACTIVATION activation_;
+
+  bool HasActivation() const { return activation_.ActivationKind != MlasIdentityActivation; }
+
   // dequantize B first and then compute float gemm
   Status ComputeBUnpacked(const Tensor* a,
                           const Tensor* b,
@@ -344,6 +360,8 @@ Status MatMulNBits<T1>::ComputeBPacked(const Tensor* a,
     workspace = IAllocator::MakeUniquePtr<std::byte>(allocator, workspace_size, true);
   }
 
+  MLAS_GEMM_ACTIVATION_PROCESSOR output_processor(activation_);
+
   InlinedVector<MLAS_QNBIT_GEMM_DATA_PARAMS<T1>> data(batch_count);
   for (size_t i = 0; i < batch_count; ++i) {
     data[i].A = a_data + helper.LeftOffsets()[i];
@@ -357,9 +375,20 @@ Status MatMulNBits<T1>::ComputeBPacked(const Tensor* a,
     data[i].Bias = bias_data;
     data[i].C = y_data + helper.OutputOffsets()[i];
     data[i].ldc = N;
+    if constexpr (std::is_same_v<T1, float>) {
+      data[i].PostProcessor = HasActivation() ? &output_processor : nullptr;
+    }
   }
   MlasQNBitGemmBatch(M, N, K, batch_count, nbits_, block_size_, compute_type_, data.data(), workspace.get(),
                      thread_pool);
+
+#if defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) && defined(MLAS_TARGET_ARM64)
+  if constexpr (std::is_same_v<T1, MLFloat16>) {
+    if (HasActivation()) {
+      ApplyActivation(activation_, y_data, static_cast<size_t>(y->Shape().Size()), allocator);
+    }
+  }
+#endif
   return Status::OK();
 }
 
@@ -420,6 +449,8 @@ Status MatMulNBits<MLFloat16>::ComputeBPacked(const Tensor* a,
   size_t c_size = static_cast<size_t>(y->Shape().Size());
   std::vector<float> c_v(c_size);
 
+  MLAS_GEMM_ACTIVATION_PROCESSOR output_processor(activation_);
+
   InlinedVector<MLAS_QNBIT_GEMM_DATA_PARAMS<float>> data(batch_count);
   for (size_t i = 0; i < batch_count; ++i) {
     data[i].A = tmp_a_data_ptr.get() + helper.LeftOffsets()[i];
@@ -435,6 +466,7 @@ Status MatMulNBits<MLFloat16>::ComputeBPacked(const Tensor* a,
     data[i].Bias = bias ? bias_ptr : nullptr;
     data[i].C = c_v.data() + helper.OutputOffsets()[i];
     data[i].ldc = N;
+    data[i].PostProcessor = HasActivation() ? &output_processor : nullptr;
   }
   MlasQNBitGemmBatch(M, N, K, batch_count, nbits_, block_size_, compute_type_, data.data(), workspace.get(),
                      thread_pool);
@@ -547,6 +579,8 @@ Status MatMulNBits<float>::ComputeBUnpacked(const Tensor* a,
   MlasTranspose(tmp_b_data_ptr.get(), tm_b_data_ptr_trans.get(), N_, K_);
 #endif
 
+  const MLAS_GEMM_ACTIVATION_PROCESSOR output_processor(activation_);
+
   std::vector<MLAS_SGEMM_DATA_PARAMS> data(batch_count);
   for (size_t i = 0; i < batch_count; i++) {
     data[i].BIsPacked = false;
@@ -558,6 +592,7 @@ Status MatMulNBits<float>::ComputeBUnpacked(const Tensor* a,
     data[i].ldc = N;
     data[i].alpha = 1.f;
     data[i].beta = 0.0f;
+    data[i].OutputProcessor = HasActivation() ? &output_processor : nullptr;
   }
 
   // if there is a bias input, copy bias values into C and set beta to 1.0f
@@ -693,6 +728,8 @@ Status MatMulNBits<MLFloat16>::ComputeBUnpacked(const Tensor* a,
   auto c_size = static_cast<size_t>(y->Shape().Size());
   auto tmp_c_ptr = IAllocator::MakeUniquePtr<float>(allocator, c_size, true);
 
+  const MLAS_GEMM_ACTIVATION_PROCESSOR output_processor(activation_);
+
   for (size_t i = 0; i < batch_count; i++) {
     data[i].BIsPacked = false;
     data[i].A = tmp_a_data_ptr.get() + helper.LeftOffsets()[i];
@@ -703,6 +740,7 @@ Status MatMulNBits<MLFloat16>::ComputeBUnpacked(const Tensor* a,
     data[i].ldc = N;
     data[i].alpha = 1.f;
     data[i].beta = 0.0f;
+    data[i].OutputProcessor = HasActivation() ? &output_processor : nullptr;
   }
 
   // if there is a bias input, copy bias values into C and set beta to 1.0f
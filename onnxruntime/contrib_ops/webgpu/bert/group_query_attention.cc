@@ -348,6 +348,7 @@ KernelCreateInfo CreateGroupQueryAttentionKernelInfo(bool enable_graph_capture)
       .SinceVersion(1)
       .Provider(kWebGpuExecutionProvider)
       .TypeConstraint("T", WebGpuSupportedFloatTypes())
+      .TypeConstraint("T_CACHE", WebGpuSupportedFloatTypes())
       .MayInplace(3, 1)
       .MayInplace(4, 2);
 
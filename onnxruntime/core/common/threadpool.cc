@@ -389,6 +389,9 @@ ThreadPool::ThreadPool(Env* env,
       thread_options_.affinities.erase(thread_options_.affinities.begin());
       assert(thread_options_.affinities.size() >= size_t(threads_to_create));
     }
+    if (!thread_options_.numa_nodes.empty()) {
+      thread_options_.numa_nodes.erase(thread_options_.numa_nodes.begin());
+    }
 
     extended_eigen_threadpool_ =
         std::make_unique<ThreadPoolTempl<Env> >(name,
@@ -472,6 +475,53 @@ void ThreadPool::SimpleParallelFor(std::ptrdiff_t total, const std::function<voi
   });
 }
 
+// Loop over one contiguous slice of blocks per NUMA node.  Each work item claims blocks from
+// the slice of the node it runs on, and then from the other slices in node order.
+void ThreadPool::ParallelForByNumaNode(std::ptrdiff_t total, std::ptrdiff_t block_size,
+                                       const std::function<void(std::ptrdiff_t, std::ptrdiff_t)>& fn) {
+  auto& pool = *extended_eigen_threadpool_;
+  const unsigned num_nodes = pool.NumNumaNodes();
+  const auto num_threads_inc_main = static_cast<unsigned>(NumThreads() + 1);
+
+  // The caller runs work item 0 and counts towards its own node, or node 0 if it is not a worker.
+  const int caller_id = CurrentThreadId();
+  const unsigned caller_node = caller_id >= 0 ? pool.NumaNodeOfWorker(static_cast<unsigned>(caller_id)) : 0;
+
+  struct NodeSlice {
+    alignas(CACHE_LINE_BYTES) std::atomic<std::ptrdiff_t> next_block{0};
+    std::ptrdiff_t end_block{0};
+  };
+  auto slices = std::make_unique<NodeSlice[]>(num_nodes);
+  const std::ptrdiff_t num_blocks = (total + block_size - 1) / block_size;
+  std::ptrdiff_t threads_before = 0;
+  std::ptrdiff_t begin_block = 0;
+  for (unsigned node = 0; node < num_nodes; ++node) {
+    threads_before += pool.NumWorkersOnNumaNode(node) + (node == caller_node ? 1 : 0);
+    const std::ptrdiff_t end_block = num_blocks * threads_before / num_threads_inc_main;
+    slices[node].next_block.store(begin_block, std::memory_order_relaxed);
+    slices[node].end_block = end_block;
+    begin_block = end_block;
+  }
+
+  std::function<void(unsigned)> run_work = [&](unsigned /*idx*/) {
+    const int thread_id = CurrentThreadId();
+    const unsigned home_node = thread_id >= 0 ? pool.NumaNodeOfWorker(static_cast<unsigned>(thread_id)) : caller_node;
+    for (unsigned i = 0; i < num_nodes; ++i) {
+      NodeSlice& slice = slices[(home_node + i) % num_nodes];
+      for (;;) {
+        const std::ptrdiff_t block = slice.next_block.fetch_add(1, std::memory_order_relaxed);
+        if (block >= slice.end_block) {
+          break;
+        }
+        fn(block * block_size, std::min(total, (block + 1) * block_size));
+      }
+    }
+  };
+  const auto num_work_items = static_cast<unsigned>(
+      std::min(static_cast<std::ptrdiff_t>(num_threads_inc_main), num_blocks));
+  pool.RunInParallelByNumaNode(run_work, num_work_items, block_size);
+}
+
 void ThreadPool::Schedule(std::function<void()> fn) {
   if (underlying_threadpool_) {
     underlying_threadpool_->Schedule(std::move(fn));
@@ -695,6 +745,28 @@ int ThreadPool::CurrentThreadId() const {
   }
 }
 
+int ThreadPool::NumNumaNodes(const concurrency::ThreadPool* tp) {
+  if (tp && tp->extended_eigen_threadpool_) {
+    return static_cast<int>(tp->extended_eigen_threadpool_->NumNumaNodes());
+  }
+  return 1;
+}
+
+void ThreadPool::TryParallelForByNumaNode(concurrency::ThreadPool* tp, std::ptrdiff_t total, std::ptrdiff_t block_size,
+                                          const std::function<void(std::ptrdiff_t first, std::ptrdiff_t last)>& fn) {
+  if (tp == nullptr) {
+    fn(0, total);
+    return;
+  }
+  // Parallel sections keep their own assignment of work items to threads.
+  if (NumNumaNodes(tp) <= 1 || current_parallel_section.has_value() ||
+      !tp->ShouldParallelizeLoop(total, block_size)) {
+    tp->ParallelForFixedBlockSizeScheduling(total, block_size, fn);
+    return;
+  }
+  tp->ParallelForByNumaNode(total, block_size, fn);
+}
+
 void ThreadPool::TryParallelFor(concurrency::ThreadPool* tp, std::ptrdiff_t total, const TensorOpCost& cost_per_unit,
                                 const std::function<void(std::ptrdiff_t first, std::ptrdiff_t last)>& fn) {
   if (tp == nullptr) {
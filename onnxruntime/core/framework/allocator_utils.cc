@@ -13,6 +13,7 @@
 #include "core/common/logging/logging.h"
 #include "core/common/narrow.h"
 #include "core/framework/bfc_arena.h"
+#include "core/framework/huge_page_allocator.h"
 
 namespace onnxruntime {
 using namespace common;
@@ -34,6 +35,9 @@ AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
     int64_t max_power_of_two_extend_bytes = info.arena_cfg.max_power_of_two_extend_bytes == -1
                                                 ? BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES
                                                 : info.arena_cfg.max_power_of_two_extend_bytes;
+    int64_t thread_local_cache_bytes = info.arena_cfg.thread_local_cache_bytes == -1
+                                           ? BFCArena::DEFAULT_THREAD_LOCAL_CACHE_BYTES
+                                           : info.arena_cfg.thread_local_cache_bytes;
     ArenaExtendStrategy arena_extend_str;
     switch (info.arena_cfg.arena_extend_strategy) {
       case static_cast<int>(ArenaExtendStrategy::kSameAsRequested):
@@ -49,6 +53,33 @@ AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
         return nullptr;
     }
 
+    HugePageMode huge_page_mode;
+    switch (info.arena_cfg.huge_pages) {
+      case -1:  // default value supplied by user
+      case static_cast<int>(HugePageMode::kDisabled):
+        huge_page_mode = HugePageMode::kDisabled;
+        break;
+      case static_cast<int>(HugePageMode::kTransparent):
+        huge_page_mode = HugePageMode::kTransparent;
+        break;
+      case static_cast<int>(HugePageMode::kHugeTlb):
+        huge_page_mode = HugePageMode::kHugeTlb;
+        break;
+      default:
+        LOGS_DEFAULT(ERROR) << "Received invalid value of huge_pages " << info.arena_cfg.huge_pages;
+        return nullptr;
+    }
+
+    if (huge_page_mode != HugePageMode::kDisabled) {
+      const auto& device = device_allocator->Info().device;
+      if (device.Type() == OrtDevice::CPU && device.MemType() == OrtDevice::MemType::DEFAULT) {
+        device_allocator = std::make_unique<HugePageCPUAllocator>(device_allocator->Info(), huge_page_mode);
+      } else {
+        LOGS_DEFAULT(WARNING) << "Huge pages are only supported for CPU arenas. Ignoring huge_pages for "
+                              << device_allocator->Info().name;
+      }
+    }
+
     if (info.use_stream_aware_arena) {
 #ifdef ORT_ENABLE_STREAM
       return AllocatorPtr(
@@ -69,7 +100,8 @@ AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
                                      initial_chunk_size_bytes,
                                      max_dead_bytes_per_chunk,
                                      initial_growth_chunk_size_bytes,
-                                     max_power_of_two_extend_bytes));
+                                     max_power_of_two_extend_bytes,
+                                     thread_local_cache_bytes));
     }
   } else {
     return device_allocator;
@@ -35,7 +35,7 @@ struct AllocatorCreationInfo {
 };
 
 // Returns an allocator (an instance of IAllocator) based on the creation info provided.
-// Returns nullptr if an invalid value of info.arena_cfg.arena_extend_strategy is supplied.
+// Returns nullptr if an invalid value of info.arena_cfg.arena_extend_strategy or info.arena_cfg.huge_pages is supplied.
 // Valid values can be found in onnxruntime_c_api.h.
 AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info);
 
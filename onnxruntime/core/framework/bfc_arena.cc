@@ -3,6 +3,7 @@
 
 #include "core/framework/allocator.h"
 #include "core/framework/bfc_arena.h"
+#include <thread>
 #include <type_traits>
 
 namespace onnxruntime {
@@ -12,7 +13,8 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
                    int initial_chunk_size_bytes,
                    int max_dead_bytes_per_chunk,
                    int initial_growth_chunk_size_bytes,
-                   int64_t max_power_of_two_extend_bytes)
+                   int64_t max_power_of_two_extend_bytes,
+                   int64_t thread_local_cache_bytes)
     : IAllocator(OrtMemoryInfo(resource_allocator->Info().name.c_str(),
                                OrtAllocatorType::OrtArenaAllocator,
                                resource_allocator->Info().device,
@@ -25,11 +27,22 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
       max_dead_bytes_per_chunk_(max_dead_bytes_per_chunk),
       initial_growth_chunk_size_bytes_(initial_growth_chunk_size_bytes),
       max_power_of_two_extend_bytes_(max_power_of_two_extend_bytes) {
+  if (thread_local_cache_bytes > 0) {
+    // The chunk size is stored in front of every allocation, which needs memory the host can write.
+    if (device_allocator_->Info().device.Type() == OrtDevice::CPU) {
+      thread_local_cache_bytes_ = static_cast<size_t>(thread_local_cache_bytes);
+    } else {
+      LOGS_DEFAULT(WARNING) << "BFCArena thread local caches are only supported for CPU memory. Ignoring "
+                            << "thread_local_cache_bytes for " << device_allocator_->Info().name;
+    }
+  }
+
   LOGS_DEFAULT(INFO) << "Creating BFCArena for " << device_allocator_->Info().name
                      << " with following configs: initial_chunk_size_bytes: " << initial_chunk_size_bytes_
                      << " max_dead_bytes_per_chunk: " << max_dead_bytes_per_chunk_
                      << " initial_growth_chunk_size_bytes: " << initial_growth_chunk_size_bytes_
                      << " max_power_of_two_extend_bytes: " << max_power_of_two_extend_bytes_
+                     << " thread_local_cache_bytes: " << thread_local_cache_bytes_
                      << " memory limit: " << total_memory
                      << " arena_extend_strategy: " << static_cast<int32_t>(arena_extend_strategy);
 
@@ -42,6 +55,10 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
 
   arena_extend_strategy_ = arena_extend_strategy;
 
+  if (thread_local_cache_bytes_ > 0) {
+    thread_caches_ = std::make_unique<ThreadCache[]>(kNumThreadCacheShards);
+  }
+
   // We never want to shrink the initial allocation if the arena extend strategy is kNextPowerOfTwo.
   // This could seem confusingly arbitrary but the rationale is as follows:
   // The user selected initial allocation chunk is only valid for the arena extend strategy kNextPowerOfTwo
@@ -269,13 +286,145 @@ size_t BFCArena::RoundedBytes(size_t bytes) {
 }
 
 void* BFCArena::Alloc(size_t size) {
+  if (thread_caches_) {
+    return AllocWithHeader(size);
+  }
+
   return AllocateRawInternal(size, false, nullptr);
 }
 
+BFCArena::ThreadCache& BFCArena::ThreadCacheForCurrentThread() {
+  thread_local const size_t shard = std::hash<std::thread::id>{}(std::this_thread::get_id()) % kNumThreadCacheShards;
+  return thread_caches_[shard];
+}
+
+void* BFCArena::AllocWithHeader(size_t size) {
+  if (size == 0) {
+    return nullptr;
+  }
+
+  const size_t num_bytes = size + kAllocationHeaderBytes;
+  const size_t rounded_bytes = RoundedBytes(num_bytes);
+  const BinNum bin_num = BinNumForSize(rounded_bytes);
+
+  void* chunk_ptr = nullptr;
+  size_t chunk_size = 0;
+  if (bin_num < kNumThreadCacheBins) {
+    {
+      ThreadCache& cache = ThreadCacheForCurrentThread();
+      std::lock_guard<std::mutex> lock(cache.lock);
+      auto& cached_chunks = cache.bins[bin_num];
+      for (auto it = cached_chunks.begin(); it != cached_chunks.end(); ++it) {
+        if (it->second >= rounded_bytes) {
+          chunk_ptr = it->first;
+          chunk_size = it->second;
+          cache.cached_bytes -= chunk_size;
+          cached_chunks.erase(it);
+          break;
+        }
+      }
+    }
+
+    if (chunk_ptr != nullptr) {
+      num_thread_cache_hits_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      num_thread_cache_misses_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  if (chunk_ptr == nullptr) {
+    chunk_ptr = AllocateRawInternal(num_bytes, false, nullptr, &chunk_size);
+  }
+
+  auto* header = static_cast<AllocationHeader*>(chunk_ptr);
+  header->chunk_size = chunk_size;
+  header->requested_size = size;
+  return static_cast<char*>(chunk_ptr) + kAllocationHeaderBytes;
+}
+
+void BFCArena::FreeWithHeader(void* p) {
+  const AllocationHeader* header = HeaderOf(p);
+  void* chunk_ptr = static_cast<char*>(p) - kAllocationHeaderBytes;
+  const size_t chunk_size = header->chunk_size;
+
+  if (chunk_size == 0) {
+    std::lock_guard<std::mutex> lock(lock_);
+    auto it = reserved_chunks_.find(chunk_ptr);
+    ORT_ENFORCE(it != reserved_chunks_.end(), "Freeing a pointer that was not allocated by this arena");
+    FreeReservedChunk(it);
+    return;
+  }
+
+  const BinNum bin_num = BinNumForSize(chunk_size);
+  if (bin_num < kNumThreadCacheBins) {
+    ThreadCache& cache = ThreadCacheForCurrentThread();
+    std::lock_guard<std::mutex> lock(cache.lock);
+    auto& cached_chunks = cache.bins[bin_num];
+    if (cached_chunks.size() < kMaxThreadCacheChunksPerBin &&
+        cache.cached_bytes + chunk_size <= thread_local_cache_bytes_) {
+      cached_chunks.emplace_back(chunk_ptr, chunk_size);
+      cache.cached_bytes += chunk_size;
+      return;
+    }
+  }
+
+  // the chunk is too large for the cache or the cache is full, so it goes back to the shared arena
+  std::lock_guard<std::mutex> lock(lock_);
+  DeallocateRawInternal(chunk_ptr);
+}
+
+void BFCArena::TakeCachedChunks(ThreadCache& cache, std::vector<void*>& chunks) {
+  std::lock_guard<std::mutex> lock(cache.lock);
+  for (auto& cached_chunks : cache.bins) {
+    for (const auto& cached_chunk : cached_chunks) {
+      chunks.push_back(cached_chunk.first);
+    }
+    cached_chunks.clear();
+  }
+  cache.cached_bytes = 0;
+}
+
+void BFCArena::FlushThreadCaches() {
+  if (!thread_caches_) {
+    return;
+  }
+
+  std::vector<void*> chunks;
+  for (size_t i = 0; i < kNumThreadCacheShards; ++i) {
+    TakeCachedChunks(thread_caches_[i], chunks);
+  }
+
+  std::lock_guard<std::mutex> lock(lock_);
+  for (void* chunk : chunks) {
+    DeallocateRawInternal(chunk);
+  }
+}
+
+void BFCArena::FlushCurrentThreadCache() {
+  if (!thread_caches_) {
+    return;
+  }
+
+  std::vector<void*> chunks;
+  TakeCachedChunks(ThreadCacheForCurrentThread(), chunks);
+  if (chunks.empty()) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(lock_);
+  for (void* chunk : chunks) {
+    DeallocateRawInternal(chunk);
+  }
+}
+
 void* BFCArena::Reserve(size_t size) {
   if (size == 0)
     return nullptr;
 
+  if (thread_caches_) {
+    return ReserveWithHeader(size);
+  }
+
   std::lock_guard<std::mutex> lock(lock_);
 
   LOGS_DEFAULT(INFO) << "Reserving memory in BFCArena for " << device_allocator_->Info().name << " size: " << size;
@@ -292,7 +441,40 @@ void* BFCArena::Reserve(size_t size) {
   return ptr;
 }
 
+void* BFCArena::ReserveWithHeader(size_t size) {
+  void* chunk_ptr = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(lock_);
+    const size_t num_bytes = size + kAllocationHeaderBytes;
+    chunk_ptr = device_allocator_->Alloc(num_bytes);
+    ORT_ENFORCE(reserved_chunks_.find(chunk_ptr) == reserved_chunks_.end());
+    reserved_chunks_.insert(std::pair<void*, size_t>(chunk_ptr, num_bytes));
+    stats_.bytes_in_use += num_bytes;
+    stats_.num_reserves += 1;
+    stats_.num_allocs += 1;
+    stats_.max_alloc_size = std::max<size_t>(static_cast<size_t>(stats_.max_alloc_size), num_bytes);
+    stats_.max_bytes_in_use = std::max<int64_t>(static_cast<int64_t>(stats_.max_bytes_in_use), stats_.bytes_in_use);
+    stats_.total_allocated_bytes += num_bytes;
+  }
+
+  auto* header = static_cast<AllocationHeader*>(chunk_ptr);
+  header->chunk_size = 0;
+  header->requested_size = size;
+  return static_cast<char*>(chunk_ptr) + kAllocationHeaderBytes;
+}
+
+void BFCArena::FreeReservedChunk(std::unordered_map<void*, size_t>::iterator it) {
+  device_allocator_->Free(it->first);
+  stats_.bytes_in_use -= it->second;
+  stats_.total_allocated_bytes -= it->second;
+  reserved_chunks_.erase(it);
+}
+
 size_t BFCArena::RequestedSize(const void* ptr) {
+  if (thread_caches_) {
+    return HeaderOf(ptr)->requested_size;
+  }
+
   std::lock_guard<std::mutex> lock(lock_);
   BFCArena::ChunkHandle h = region_manager_.get_handle(ptr);
   ORT_ENFORCE(h != kInvalidChunkHandle);
@@ -301,6 +483,12 @@ size_t BFCArena::RequestedSize(const void* ptr) {
 }
 
 size_t BFCArena::AllocatedSize(const void* ptr) {
+  if (thread_caches_) {
+    // the usable size, which for a cache hit is that of the cached chunk rather than of the original request
+    const AllocationHeader* header = HeaderOf(ptr);
+    return header->chunk_size == 0 ? header->requested_size : header->chunk_size - kAllocationHeaderBytes;
+  }
+
   std::lock_guard<std::mutex> lock(lock_);
   BFCArena::ChunkHandle h = region_manager_.get_handle(ptr);
   ORT_ENFORCE(h != kInvalidChunkHandle);
@@ -310,7 +498,8 @@ size_t BFCArena::AllocatedSize(const void* ptr) {
 
 void* BFCArena::AllocateRawInternal(size_t num_bytes,
                                     bool dump_log_on_failure,
-                                    Stream* stream) {
+                                    Stream* stream,
+                                    size_t* chunk_size) {
   if (num_bytes == 0) {
     return nullptr;
   }
@@ -323,28 +512,22 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   // The BFC allocator tries to find the best fit first.
   BinNum bin_num = BinNumForSize(rounded_bytes);
 
-  std::lock_guard<std::mutex> lock(lock_);
-  // search for a valid chunk
-  auto* chunk = FindChunkPtr(bin_num, rounded_bytes, num_bytes, stream);
-
-  if (chunk != nullptr) {
-    return chunk->ptr;
+  std::unique_lock<std::mutex> lock(lock_);
+  Chunk* chunk = nullptr;
+  auto status = FindOrExtendChunk(bin_num, rounded_bytes, num_bytes, stream, chunk);
+  if (chunk == nullptr && thread_caches_) {
+    // The chunks held in the thread caches may satisfy the request once they are back in the bins.
+    lock.unlock();
+    FlushThreadCaches();
+    lock.lock();
+    status = FindOrExtendChunk(bin_num, rounded_bytes, num_bytes, stream, chunk);
   }
 
-  LOGS_DEFAULT(INFO) << "Extending BFCArena for " << device_allocator_->Info().name
-                     << ". bin_num:" << bin_num << " (requested) num_bytes: " << num_bytes << " (actual) rounded_bytes:" << rounded_bytes;
-
-  // Try to extend
-  auto status = Extend(rounded_bytes);
-  if (status.IsOK()) {
-    chunk = FindChunkPtr(bin_num, rounded_bytes, num_bytes, stream);
-    if (chunk != nullptr) {
-      return chunk->ptr;
-    } else {
-      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
-                               "Failed to find a free memory block despite calling Extend. rounded_bytes=",
-                               rounded_bytes);
+  if (chunk != nullptr) {
+    if (chunk_size != nullptr) {
+      *chunk_size = chunk->size;
     }
+    return chunk->ptr;
   }
 
   // We searched all bins for an existing free chunk to use and
@@ -359,9 +542,33 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   ORT_THROW(status.ErrorMessage());
 }
 
+Status BFCArena::FindOrExtendChunk(BinNum bin_num, size_t rounded_bytes, size_t num_bytes, Stream* stream,
+                                   Chunk*& chunk) {
+  // search for a valid chunk
+  chunk = FindChunkPtr(bin_num, rounded_bytes, num_bytes, stream);
+  if (chunk != nullptr) {
+    return Status::OK();
+  }
+
+  LOGS_DEFAULT(INFO) << "Extending BFCArena for " << device_allocator_->Info().name
+                     << ". bin_num:" << bin_num << " (requested) num_bytes: " << num_bytes << " (actual) rounded_bytes:" << rounded_bytes;
+
+  // Try to extend
+  ORT_RETURN_IF_ERROR(Extend(rounded_bytes));
+  chunk = FindChunkPtr(bin_num, rounded_bytes, num_bytes, stream);
+  if (chunk == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                           "Failed to find a free memory block despite calling Extend. rounded_bytes=",
+                           rounded_bytes);
+  }
+  return Status::OK();
+}
+
 void BFCArena::GetStats(AllocatorStats* stats) {
   std::lock_guard<std::mutex> lock(lock_);
   *stats = stats_;
+  stats->num_thread_cache_hits = num_thread_cache_hits_.load(std::memory_order_relaxed);
+  stats->num_thread_cache_misses = num_thread_cache_misses_.load(std::memory_order_relaxed);
 }
 
 BFCArena::Chunk* BFCArena::SplitFreeChunkFromBin(BFCArena::Bin::FreeChunkSet* free_chunks,
@@ -474,19 +681,22 @@ void BFCArena::Free(void* p) {
   if (p == nullptr) {
     return;
   }
+  if (thread_caches_) {
+    FreeWithHeader(p);
+    return;
+  }
   std::lock_guard<std::mutex> lock(lock_);
   auto it = reserved_chunks_.find(p);
   if (it != reserved_chunks_.end()) {
-    device_allocator_->Free(it->first);
-    stats_.bytes_in_use -= it->second;
-    stats_.total_allocated_bytes -= it->second;
-    reserved_chunks_.erase(it);
+    FreeReservedChunk(it);
   } else {
     DeallocateRawInternal(p);
   }
 }
 
 Status BFCArena::Shrink() {
+  FlushThreadCaches();
+
   std::lock_guard<std::mutex> lock(lock_);
   auto num_regions = region_manager_.regions().size();
   std::vector<void*> region_ptrs;
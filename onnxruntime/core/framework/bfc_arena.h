@@ -16,9 +16,12 @@ limitations under the License.
 
 #pragma once
 #include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <unordered_map>
+#include <utility>
 
 #include "onnxruntime_config.h"
 
@@ -59,6 +62,7 @@ class BFCArena : public IAllocator {
   static const int DEFAULT_MAX_DEAD_BYTES_PER_CHUNK = 128 * 1024 * 1024;
   static const int DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES = 2 * 1024 * 1024;
   static const int64_t DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES = 1024 * 1024 * 1024;  // 1GB
+  static const int64_t DEFAULT_THREAD_LOCAL_CACHE_BYTES = 0;                        // disabled
   static const size_t DEFAULT_MAX_MEM = std::numeric_limits<size_t>::max();
 
   enum ArenaType {
@@ -72,7 +76,8 @@ class BFCArena : public IAllocator {
            int initial_chunk_size_bytes = DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
            int max_dead_bytes_per_chunk = DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
            int initial_growth_chunk_size_bytes = DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
-           int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES);
+           int64_t max_power_of_two_extend_bytes = DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+           int64_t thread_local_cache_bytes = DEFAULT_THREAD_LOCAL_CACHE_BYTES);
 
   ~BFCArena() override;
 
@@ -84,7 +89,14 @@ class BFCArena : public IAllocator {
   // If p is NULL, no operation is performed.
   void Free(void* p) override;
 
+  // Returns every chunk held in the thread caches to the shared arena.
+  void FlushThreadCaches();
+
+  // Returns the chunks held in the calling thread's cache shard to the shared arena.
+  void FlushCurrentThreadCache() override;
+
   // Frees all allocation regions in which no chunk is in use.
+  // Flushes the thread caches first.
   // Does not free any reserved chunks.
   // Resets the size that the arena will grow by in the next allocation to
   // `initial_growth_chunk_size_bytes_` but ultimately all
@@ -103,9 +115,11 @@ class BFCArena : public IAllocator {
   ArenaType GetArenaType() const { return arena_type_; }
 
  protected:
+  // If `chunk_size` is not null it receives the size of the chunk backing the returned pointer.
   void* AllocateRawInternal(size_t num_bytes,
                             bool dump_log_on_failure,
-                            Stream* stream);
+                            Stream* stream,
+                            size_t* chunk_size = nullptr);
 
 #ifdef ORT_ENABLE_STREAM
   // for any chunk that associated with target stream, reset it to default (nullptr in stream, sync id 0)
@@ -421,6 +435,62 @@ class BFCArena : public IAllocator {
   // Computes and returns a BinDebugInfo for each Bin.
   std::array<BinDebugInfo, kNumBins> get_bin_debug_info();
 
+  // Thread cache fast path, enabled when thread_local_cache_bytes > 0 for an arena over CPU memory.
+  //
+  // Small chunks freed by a thread are kept in that thread's cache instead of being returned to the bins, and are
+  // handed back out by the next Alloc of a similar size from the same thread. Cached chunks stay in use as far as
+  // the arena is concerned, so neither path takes lock_. A cache returns chunks to the shared arena when it would
+  // exceed thread_local_cache_bytes, on FlushThreadCaches/Shrink, and before an allocation fails for lack of memory.
+  // FlushCurrentThreadCache returns only the calling thread's shard, so it does not disturb concurrent runs.
+  //
+  // Caches are sharded by thread id, so threads only contend with the few others that share their shard. As a
+  // chunk may be freed on a different thread than the one that allocated it, every pointer handed out while the
+  // caches are enabled is preceded by an AllocationHeader that records the size of its chunk.
+  static constexpr size_t kNumThreadCacheShards = 64;
+  // chunks smaller than BinNumToSize(kNumThreadCacheBins), i.e. 128KB, are cacheable
+  static constexpr BinNum kNumThreadCacheBins = 9;
+  static constexpr size_t kMaxThreadCacheChunksPerBin = 16;
+  // keeps the returned pointers aligned for the CPU kernels
+  static constexpr size_t kAllocationHeaderBytes = 64;
+
+  struct AllocationHeader {
+    // size of the arena chunk that starts at the header, or 0 for a buffer from Reserve()
+    size_t chunk_size;
+    size_t requested_size;
+  };
+  static_assert(sizeof(AllocationHeader) <= kAllocationHeaderBytes);
+
+  struct ThreadCache {
+    std::mutex lock;
+    // (chunk ptr, chunk size) of the cached chunks in each bin
+    std::array<std::vector<std::pair<void*, size_t>>, kNumThreadCacheBins> bins;
+    size_t cached_bytes = 0;
+  };
+
+  static AllocationHeader* HeaderOf(const void* ptr) {
+    return reinterpret_cast<AllocationHeader*>(static_cast<char*>(const_cast<void*>(ptr)) - kAllocationHeaderBytes);
+  }
+
+  ThreadCache& ThreadCacheForCurrentThread();
+
+  // Moves the chunks of `cache` to `chunks` and empties it.
+  static void TakeCachedChunks(ThreadCache& cache, std::vector<void*>& chunks);
+
+  void* AllocWithHeader(size_t size);
+  void* ReserveWithHeader(size_t size);
+  void FreeWithHeader(void* p);
+
+  // Returns the reserved chunk `it` to the device allocator. Requires lock_.
+  void FreeReservedChunk(std::unordered_map<void*, size_t>::iterator it);
+
+  // Looks for a free chunk and extends the arena if there is none. Requires lock_.
+  Status FindOrExtendChunk(BinNum bin_num, size_t rounded_bytes, size_t num_bytes, Stream* stream, Chunk*& chunk);
+
+  size_t thread_local_cache_bytes_ = 0;
+  std::unique_ptr<ThreadCache[]> thread_caches_;
+  std::atomic<int64_t> num_thread_cache_hits_{0};
+  std::atomic<int64_t> num_thread_cache_misses_{0};
+
   // Structures immutable after construction
   size_t memory_limit_ = 0;
   ArenaExtendStrategy arena_extend_strategy_ = ArenaExtendStrategy::kNextPowerOfTwo;
@@ -0,0 +1,197 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/cpu_replay_executor.h"
+
+#include "core/common/make_string.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/sequential_execution_plan.h"
+#include "core/framework/session_state.h"
+#include "core/graph/constants.h"
+
+namespace onnxruntime {
+
+std::unique_ptr<CpuReplayExecutor> CpuReplayExecutor::Create(const SessionState& session_state) {
+  const auto* plan = session_state.GetExecutionPlan();
+  if (plan == nullptr || session_state.GetGraphViewer().ParentNode() != nullptr) {
+    return nullptr;
+  }
+
+  // Without notifications and barriers a logic stream is a plain sequence of kernel launches.
+  if (!plan->notification_owner_stream.empty() || plan->num_barriers != 0) {
+    return nullptr;
+  }
+
+  const SequentialExecutionPlan::LogicStream* logic_stream = nullptr;
+  for (const auto& stream : plan->execution_plan) {
+    if (stream->steps_.empty()) {
+      continue;
+    }
+    if (logic_stream != nullptr) {
+      return nullptr;
+    }
+    logic_stream = stream.get();
+  }
+
+  if (logic_stream == nullptr) {
+    return nullptr;
+  }
+
+  // Freeze the release plan. With a single stream, a value is released after the last node that counts it down.
+  std::vector<size_t> ref_counts;
+  ref_counts.reserve(plan->release_actions.size());
+  for (const auto& release_action : plan->release_actions) {
+    ref_counts.push_back(release_action.ref_count);
+  }
+
+  std::vector<Step> steps;
+  steps.reserve(logic_stream->steps_.size());
+  for (const auto& execution_step : logic_stream->steps_) {
+    const NodeIndex node_index = execution_step->GetNodeIndex();
+    const OpKernel* kernel = session_state.GetKernel(node_index);
+    if (kernel == nullptr) {
+      return nullptr;
+    }
+
+    const Node& node = kernel->Node();
+    if (node.GetExecutionProviderType() != kCpuExecutionProvider || kernel->IsAsync() || node.ContainsSubgraph()) {
+      return nullptr;
+    }
+
+    Step step{kernel, {}};
+    for (auto idx : plan->node_release_list[node_index]) {
+      if (ref_counts[idx] > 0 && --ref_counts[idx] == 0) {
+        step.values_to_release.push_back(static_cast<int>(plan->release_actions[idx].value_index));
+      }
+    }
+    steps.push_back(std::move(step));
+  }
+
+  return std::unique_ptr<CpuReplayExecutor>(new CpuReplayExecutor(session_state, std::move(steps)));
+}
+
+CpuReplayExecutor::CpuReplayExecutor(const SessionState& session_state, std::vector<Step> steps)
+    : session_state_(session_state), steps_(std::move(steps)) {
+}
+
+bool CpuReplayExecutor::TryReplay(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                                  gsl::span<const int> fetch_mlvalue_idxs, std::vector<OrtValue>& fetches,
+                                  const logging::Logger& logger, const bool& terminate_flag, Status& status) {
+  // profiling and node stats need the per-kernel hooks of the regular executor.
+  if (session_state_.Profiler().IsEnabled()) {
+    return false;
+  }
+#if !defined(ORT_MINIMAL_BUILD)
+  if (session_state_.GetNodeStatsRecorder() != nullptr) {
+    return false;
+  }
+#endif
+
+  std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+  if (!lock.owns_lock() || !Record(feed_mlvalue_idxs, feeds)) {
+    return false;
+  }
+
+  status = Replay(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches, logger, terminate_flag);
+  replay_count_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+bool CpuReplayExecutor::Record(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds) {
+  InlinedVector<TensorShape> shapes;
+  shapes.reserve(feeds.size());
+  for (const auto& feed : feeds) {
+    if (!feed.IsTensor()) {
+      return false;
+    }
+    shapes.push_back(feed.Get<Tensor>().Shape());
+  }
+
+  if (recorded_ && shapes == recorded_shapes_) {
+    return true;
+  }
+
+  // the first run with new shapes is the warm-up: it goes through the regular executor and generates the memory
+  // pattern for those shapes.
+  if (shapes != seen_shapes_) {
+    seen_shapes_ = std::move(shapes);
+    recorded_ = false;
+    memory_pattern_ = PersistentMemoryPattern{};
+    buffers_.clear();
+    return false;
+  }
+
+  memory_pattern_ = PersistentMemoryPattern{};
+  buffers_.clear();
+
+  if (session_state_.GetEnableMemoryPattern()) {
+    memory_pattern_.patterns = session_state_.GetMemoryPatternGroup(feeds, feed_mlvalue_idxs,
+                                                                    memory_pattern_.inferred_shapes);
+    if (memory_pattern_.patterns != nullptr) {
+      const auto& patterns = *memory_pattern_.patterns;
+      for (size_t i = 0; i < patterns.locations.size(); ++i) {
+        const auto peak_size = patterns.patterns[i].PeakSize();
+        if (peak_size == 0) {
+          continue;
+        }
+
+        AllocatorPtr alloc = session_state_.GetAllocator(patterns.locations[i]);
+        void* buffer = alloc ? alloc->Alloc(peak_size) : nullptr;
+        if (buffer != nullptr) {
+          buffers_.emplace_back(buffer, BufferDeleter(std::move(alloc)));
+          memory_pattern_.buffers[patterns.locations[i]] = buffer;
+        }
+      }
+    }
+  }
+
+  recorded_shapes_ = seen_shapes_;
+  recorded_ = true;
+  return true;
+}
+
+Status CpuReplayExecutor::Replay(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                                 gsl::span<const int> fetch_mlvalue_idxs, std::vector<OrtValue>& fetches,
+                                 const logging::Logger& logger, const bool& terminate_flag) {
+  const std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
+  ExecutionFrame frame(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches, fetch_allocators,
+#ifdef ORT_ENABLE_STREAM
+                       nullptr,
+#endif
+                       session_state_, &memory_pattern_);
+
+  for (const auto& step : steps_) {
+    if (terminate_flag) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
+    }
+
+    const OpKernel& kernel = *step.kernel;
+    OpKernelContextInternal kernel_ctx(session_state_, frame, kernel, logger, terminate_flag, nullptr);
+
+    Status status;
+    ORT_TRY {
+      status = kernel.Compute(&kernel_ctx);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+      });
+    }
+
+    if (!status.IsOK()) {
+      const auto& node = kernel.Node();
+      const auto msg_string = MakeString("Non-zero status code returned while running ", node.OpType(),
+                                         " node. Name:'", node.Name(), "' Status Message: ", status.ErrorMessage());
+      LOGS(logger, ERROR) << msg_string;
+      return Status(status.Category(), status.Code(), msg_string);
+    }
+
+    for (int ort_value_idx : step.values_to_release) {
+      ORT_RETURN_IF_ERROR(frame.ReleaseMLValue(ort_value_idx));
+    }
+  }
+
+  return frame.GetOutputs(fetches);
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/logging/logging.h"
+#include "core/framework/buffer_deleter.h"
+#include "core/framework/execution_frame.h"
+#include "core/framework/ort_value.h"
+
+namespace onnxruntime {
+
+class OpKernel;
+class SessionState;
+
+/**
+ * Record-and-replay execution for fixed-shape graphs that run entirely on the CPU EP
+ * (kOrtSessionOptionsEnableCpuReplay).
+ *
+ * The node order and the values released after each node are frozen when the executor is created. The first run
+ * with a new set of input shapes goes through the regular executor, which produces the memory pattern for those
+ * shapes. The next run with the same shapes records the pattern and allocates its activation buffers once. From
+ * then on, runs with those shapes replay the frozen node list directly on the recorded buffers, without the stream
+ * execution context, step dispatch, pattern cache lookup or per-run activation allocation. A change of input shapes
+ * drops the recording and starts over.
+ */
+class CpuReplayExecutor {
+ public:
+  // Returns nullptr if the main graph of `session_state` cannot be replayed.
+  static std::unique_ptr<CpuReplayExecutor> Create(const SessionState& session_state);
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CpuReplayExecutor);
+
+  /**
+   * Replays the graph for `feeds`. Returns false without running anything if there is no recording for the feed
+   * shapes yet, or if another run is replaying; the caller must then execute the plan itself.
+   * When true is returned, `status` holds the result of the run.
+   */
+  bool TryReplay(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                 gsl::span<const int> fetch_mlvalue_idxs, std::vector<OrtValue>& fetches,
+                 const logging::Logger& logger, const bool& terminate_flag, Status& status);
+
+  // Number of runs that were replayed rather than executed by the regular executor.
+  size_t ReplayCount() const { return replay_count_.load(std::memory_order_relaxed); }
+
+ private:
+  struct Step {
+    const OpKernel* kernel;
+    // values whose last consumer is this node
+    InlinedVector<int> values_to_release;
+  };
+
+  CpuReplayExecutor(const SessionState& session_state, std::vector<Step> steps);
+
+  // Returns true if the recording matches `feeds`, recording them first if they were seen on the previous run.
+  bool Record(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds);
+
+  Status Replay(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                gsl::span<const int> fetch_mlvalue_idxs, std::vector<OrtValue>& fetches,
+                const logging::Logger& logger, const bool& terminate_flag);
+
+  const SessionState& session_state_;
+  const std::vector<Step> steps_;
+  std::atomic<size_t> replay_count_{0};
+
+  // Only one run can use the recorded buffers at a time.
+  std::mutex mutex_;
+  InlinedVector<TensorShape> seen_shapes_;      // GUARDED_BY(mutex_)
+  InlinedVector<TensorShape> recorded_shapes_;  // GUARDED_BY(mutex_)
+  bool recorded_ = false;                       // GUARDED_BY(mutex_)
+  PersistentMemoryPattern memory_pattern_;      // GUARDED_BY(mutex_)
+  InlinedVector<BufferUniquePtr> buffers_;      // GUARDED_BY(mutex_)
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,532 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/critical_path_executor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <optional>
+
+#include "core/common/make_string.h"
+#include "core/framework/execution_frame.h"
+#include "core/framework/op_kernel_context_internal.h"
+#include "core/framework/sequential_execution_plan.h"
+#include "core/framework/session_state.h"
+#include "core/graph/constants.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// number of elements of `arg`, counting unknown dimensions as 1
+double NumElements(const NodeArg& arg) {
+  double num_elements = 1.0;
+  if (const auto* shape = arg.Shape(); shape != nullptr) {
+    for (const auto& dim : shape->dim()) {
+      if (dim.has_dim_value() && dim.dim_value() > 0) {
+        num_elements *= static_cast<double>(dim.dim_value());
+      }
+    }
+  }
+  return num_elements;
+}
+
+// multiply-adds per output element of the ops whose cost is dominated by a reduction
+double ReductionSize(const onnxruntime::Node& node) {
+  const auto& op_type = node.OpType();
+  const auto& inputs = node.InputDefs();
+
+  if ((op_type == "MatMul" || op_type == "FusedMatMul" || op_type == "Gemm") && !inputs.empty()) {
+    // the last dimension of A, ignoring any transpose
+    const auto* shape = inputs[0]->Shape();
+    if (shape != nullptr && shape->dim_size() > 0) {
+      const auto& dim = shape->dim(shape->dim_size() - 1);
+      if (dim.has_dim_value() && dim.dim_value() > 0) {
+        return static_cast<double>(dim.dim_value());
+      }
+    }
+  } else if ((op_type == "Conv" || op_type == "FusedConv") && inputs.size() > 1) {
+    // C / group * kernel spatial size, from the weight shape
+    const auto* shape = inputs[1]->Shape();
+    if (shape != nullptr) {
+      double size = 1.0;
+      for (int i = 1; i < shape->dim_size(); ++i) {
+        const auto& dim = shape->dim(i);
+        if (dim.has_dim_value() && dim.dim_value() > 0) {
+          size *= static_cast<double>(dim.dim_value());
+        }
+      }
+      return size;
+    }
+  }
+
+  return 1.0;
+}
+
+double EstimateCost(const onnxruntime::Node& node) {
+  double output_elements = 0.0;
+  for (const auto* output : node.OutputDefs()) {
+    if (output->Exists()) {
+      output_elements += NumElements(*output);
+    }
+  }
+  return std::max(output_elements, 1.0) * ReductionSize(node);
+}
+
+}  // namespace
+
+struct CriticalPathExecutor::RunState {
+  struct Lane {
+    std::mutex mutex;
+    // max-heap of ready nodes by rank
+    std::vector<size_t> ready;  // GUARDED_BY(mutex)
+  };
+
+  RunState(size_t num_nodes, size_t num_release_actions, size_t num_lanes_in)
+      : pending_predecessors(std::make_unique<std::atomic<size_t>[]>(num_nodes)),
+        release_counts(std::make_unique<std::atomic<size_t>[]>(num_release_actions)),
+        lanes(std::make_unique<Lane[]>(num_lanes_in)),
+        num_lanes(num_lanes_in) {
+  }
+
+  bool HigherRanked(size_t a, size_t b) const { return (*ranks)[a] < (*ranks)[b]; }
+
+  std::optional<ExecutionFrame> frame;
+  const logging::Logger* logger = nullptr;
+  const bool* terminate_flag = nullptr;
+  std::shared_ptr<const std::vector<double>> ranks;
+
+  std::unique_ptr<std::atomic<size_t>[]> pending_predecessors;
+  std::unique_ptr<std::atomic<size_t>[]> release_counts;
+  std::unique_ptr<Lane[]> lanes;
+  const size_t num_lanes;
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  size_t num_queued = 0;         // GUARDED_BY(mutex) nodes in the lanes that no lane has claimed
+  size_t num_running = 0;        // GUARDED_BY(mutex) lanes that claimed a node
+  size_t num_done = 0;           // GUARDED_BY(mutex)
+  bool finished = false;         // GUARDED_BY(mutex)
+  Status status;                 // GUARDED_BY(mutex)
+  std::vector<size_t> free_lanes;  // GUARDED_BY(mutex) lanes other than the caller's without a lane task
+  bool caller_waiting = false;   // GUARDED_BY(mutex) the caller's lane waits for a queued node
+  size_t num_lanes_used = 0;     // GUARDED_BY(mutex) lanes that claimed at least one node
+};
+
+std::unique_ptr<CriticalPathExecutor> CriticalPathExecutor::Create(const SessionState& session_state) {
+  const auto* plan = session_state.GetExecutionPlan();
+  auto* thread_pool = session_state.GetThreadPool();
+  if (plan == nullptr || session_state.GetGraphViewer().ParentNode() != nullptr ||
+      concurrency::ThreadPool::DegreeOfParallelism(thread_pool) < 2) {
+    return nullptr;
+  }
+
+  if (!plan->notification_owner_stream.empty() || plan->num_barriers != 0) {
+    return nullptr;
+  }
+
+  const SequentialExecutionPlan::LogicStream* logic_stream = nullptr;
+  for (const auto& stream : plan->execution_plan) {
+    if (stream->steps_.empty()) {
+      continue;
+    }
+    if (logic_stream != nullptr) {
+      return nullptr;
+    }
+    logic_stream = stream.get();
+  }
+
+  if (logic_stream == nullptr) {
+    return nullptr;
+  }
+
+  InlinedHashMap<NodeIndex, size_t> node_positions;
+  node_positions.reserve(logic_stream->steps_.size());
+  std::vector<Node> nodes;
+  std::vector<double> static_costs;
+  nodes.reserve(logic_stream->steps_.size());
+  static_costs.reserve(logic_stream->steps_.size());
+  for (const auto& execution_step : logic_stream->steps_) {
+    const NodeIndex node_index = execution_step->GetNodeIndex();
+    const OpKernel* kernel = session_state.GetKernel(node_index);
+    if (kernel == nullptr) {
+      return nullptr;
+    }
+
+    const auto& node = kernel->Node();
+    if (node.GetExecutionProviderType() != kCpuExecutionProvider || kernel->IsAsync() || node.ContainsSubgraph()) {
+      return nullptr;
+    }
+
+    Node info{kernel, {}, 0, {}};
+    node_positions.emplace(node_index, nodes.size());
+    nodes.push_back(std::move(info));
+    static_costs.push_back(EstimateCost(node));
+  }
+
+  // The plan order is topological, so every producer is visited before its consumers.
+  // The width of the graph is the largest number of nodes at the same depth.
+  std::vector<size_t> depths(nodes.size(), 0);
+  InlinedHashMap<size_t, size_t> nodes_per_depth;
+  size_t max_width = 1;
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    const auto& node = nodes[i].kernel->Node();
+    InlinedHashSet<size_t> predecessors;
+    for (auto edge = node.InputEdgesBegin(), end = node.InputEdgesEnd(); edge != end; ++edge) {
+      auto it = node_positions.find(edge->GetNode().Index());
+      if (it != node_positions.end() && predecessors.insert(it->second).second) {
+        ORT_ENFORCE(it->second < i, "Execution plan is not in topological order.");
+        nodes[it->second].successors.push_back(i);
+        depths[i] = std::max(depths[i], depths[it->second] + 1);
+      }
+    }
+    nodes[i].num_predecessors = predecessors.size();
+    max_width = std::max(max_width, ++nodes_per_depth[depths[i]]);
+  }
+
+  // The plan attaches each release to the last consumer in plan order, which only holds when the nodes run in that
+  // order. Here they run by rank across lanes, so like the multi-stream plans a value is counted down by every
+  // consumer and released after the last one to run.
+  InlinedHashMap<size_t, size_t> release_action_of_value;
+  for (size_t idx = 0; idx < plan->release_actions.size(); ++idx) {
+    if (plan->release_actions[idx].ref_count > 0) {
+      release_action_of_value.emplace(plan->release_actions[idx].value_index, idx);
+    }
+  }
+
+  const auto& ort_value_name_idx_map = session_state.GetOrtValueNameIdxMap();
+  auto find_release_action = [&](const NodeArg& arg) -> std::optional<size_t> {
+    int ort_value_idx;
+    if (!arg.Exists() || !ort_value_name_idx_map.GetIdx(arg.Name(), ort_value_idx).IsOK()) {
+      return std::nullopt;
+    }
+    auto it = release_action_of_value.find(static_cast<size_t>(ort_value_idx));
+    return it != release_action_of_value.end() ? std::optional<size_t>{it->second} : std::nullopt;
+  };
+
+  std::vector<size_t> release_counts(plan->release_actions.size(), 0);
+  for (auto& node_info : nodes) {
+    const auto& node = node_info.kernel->Node();
+    auto count_consumer = [&](const NodeArg* arg) {
+      auto idx = find_release_action(*arg);
+      // a node that consumes a value more than once counts it down once
+      if (idx && std::find(node_info.release_actions.begin(), node_info.release_actions.end(), *idx) ==
+                     node_info.release_actions.end()) {
+        node_info.release_actions.push_back(*idx);
+        ++release_counts[*idx];
+      }
+    };
+    for (const auto* arg : node.InputDefs()) {
+      count_consumer(arg);
+    }
+    for (const auto* arg : node.ImplicitInputDefs()) {
+      count_consumer(arg);
+    }
+  }
+
+  // values that no node consumes are released after their producer
+  for (auto& node_info : nodes) {
+    for (const auto* arg : node_info.kernel->Node().OutputDefs()) {
+      auto idx = find_release_action(*arg);
+      if (idx && release_counts[*idx] == 0) {
+        node_info.release_actions.push_back(*idx);
+        release_counts[*idx] = 1;
+      }
+    }
+  }
+
+  return std::unique_ptr<CriticalPathExecutor>(
+      new CriticalPathExecutor(session_state, *thread_pool, std::move(nodes), std::move(static_costs),
+                               std::move(release_counts), max_width));
+}
+
+CriticalPathExecutor::CriticalPathExecutor(const SessionState& session_state, concurrency::ThreadPool& thread_pool,
+                                           std::vector<Node> nodes, std::vector<double> static_costs,
+                                           std::vector<size_t> release_counts, size_t max_width)
+    : session_state_(session_state),
+      thread_pool_(thread_pool),
+      nodes_(std::move(nodes)),
+      release_counts_(std::move(release_counts)),
+      max_width_(max_width),
+      measured_costs_(std::make_unique<std::atomic<double>[]>(nodes_.size())),
+      ranks_(ComputeRanks(static_costs)) {
+}
+
+std::shared_ptr<const std::vector<double>> CriticalPathExecutor::ComputeRanks(const std::vector<double>& costs) const {
+  auto ranks = std::make_shared<std::vector<double>>(nodes_.size(), 0.0);
+  for (size_t i = nodes_.size(); i-- > 0;) {
+    double successor_rank = 0.0;
+    for (size_t successor : nodes_[i].successors) {
+      successor_rank = std::max(successor_rank, (*ranks)[successor]);
+    }
+    (*ranks)[i] = costs[i] + successor_rank;
+  }
+  return ranks;
+}
+
+void CriticalPathExecutor::UpdateRanks() {
+  std::vector<double> costs(nodes_.size());
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    costs[i] = measured_costs_[i].load(std::memory_order_relaxed);
+    if (costs[i] == 0.0) {
+      return;
+    }
+  }
+
+  auto ranks = ComputeRanks(costs);
+  std::lock_guard<std::mutex> lock(ranks_mutex_);
+  ranks_ = std::move(ranks);
+}
+
+bool CriticalPathExecutor::TryExecute(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                                      gsl::span<const int> fetch_mlvalue_idxs, std::vector<OrtValue>& fetches,
+                                      const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
+                                      const logging::Logger& logger, const bool& terminate_flag, Status& status) {
+  if (session_state_.Profiler().IsEnabled()) {
+    return false;
+  }
+#if !defined(ORT_MINIMAL_BUILD)
+  if (session_state_.GetNodeStatsRecorder() != nullptr) {
+    return false;
+  }
+#endif
+
+  const auto* plan = session_state_.GetExecutionPlan();
+  const size_t num_lanes = std::min(max_width_,
+                                    static_cast<size_t>(concurrency::ThreadPool::DegreeOfParallelism(&thread_pool_)));
+
+  // Lanes that start after the run has finished only look at the counters, so the state is shared with them.
+  auto state = std::make_shared<RunState>(nodes_.size(), plan->release_actions.size(), num_lanes);
+  state->logger = &logger;
+  state->terminate_flag = &terminate_flag;
+  {
+    std::lock_guard<std::mutex> lock(ranks_mutex_);
+    state->ranks = ranks_;
+  }
+  state->frame.emplace(feed_mlvalue_idxs, feeds, fetch_mlvalue_idxs, fetches, fetch_allocators,
+#ifdef ORT_ENABLE_STREAM
+                       nullptr,
+#endif
+                       session_state_);
+
+  for (size_t i = 0; i < release_counts_.size(); ++i) {
+    state->release_counts[i].store(release_counts_[i], std::memory_order_relaxed);
+  }
+
+  auto& first_lane = state->lanes[0].ready;
+  for (size_t i = 0; i < nodes_.size(); ++i) {
+    state->pending_predecessors[i].store(nodes_[i].num_predecessors, std::memory_order_relaxed);
+    if (nodes_[i].num_predecessors == 0) {
+      first_lane.push_back(i);
+      std::push_heap(first_lane.begin(), first_lane.end(),
+                     [&](size_t a, size_t b) { return state->HigherRanked(a, b); });
+    }
+  }
+  state->num_queued = first_lane.size();
+  state->finished = nodes_.empty();
+
+  // The caller takes one of the roots; start a lane task for each of the others, as far as there are lanes.
+  for (size_t lane = num_lanes; lane-- > 1;) {
+    state->free_lanes.push_back(lane);
+  }
+  InlinedVector<size_t> start_lanes;
+  while (start_lanes.size() + 1 < first_lane.size() && !state->free_lanes.empty()) {
+    start_lanes.push_back(state->free_lanes.back());
+    state->free_lanes.pop_back();
+  }
+  for (size_t lane : start_lanes) {
+    StartLane(state, lane);
+  }
+  RunLane(state, 0);
+
+  {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cv.wait(lock, [&]() { return state->finished && state->num_running == 0; });
+    status = state->status;
+    last_run_lane_count_.store(state->num_lanes_used, std::memory_order_relaxed);
+  }
+
+  if (status.IsOK()) {
+    status = state->frame->GetOutputs(fetches);
+  }
+  state->frame.reset();
+
+  if (status.IsOK()) {
+    UpdateRanks();
+  }
+  return true;
+}
+
+void CriticalPathExecutor::StartLane(const std::shared_ptr<RunState>& state, size_t lane) {
+  concurrency::ThreadPool::Schedule(&thread_pool_, [this, state, lane]() { RunLane(state, lane); });
+}
+
+void CriticalPathExecutor::RunLane(const std::shared_ptr<RunState>& state_ptr, size_t lane) {
+  RunState& state = *state_ptr;
+  const auto higher_ranked = [&state](size_t a, size_t b) { return state.HigherRanked(a, b); };
+
+  size_t node_idx = 0;
+  bool has_node = false;
+  bool claimed = false;
+  for (;;) {
+    if (!has_node) {
+      // Claim a queued node. The caller waits for one; a lane task returns its thread to the pool instead and
+      // is started again when a node becomes ready.
+      {
+        std::unique_lock<std::mutex> lock(state.mutex);
+        if (lane == 0) {
+          state.caller_waiting = true;
+          state.cv.wait(lock, [&]() { return state.finished || state.num_queued > 0; });
+          state.caller_waiting = false;
+        }
+        if (state.finished || state.num_queued == 0) {
+          if (lane != 0) {
+            state.free_lanes.push_back(lane);
+          }
+          return;
+        }
+        --state.num_queued;
+        ++state.num_running;
+        if (!claimed) {
+          claimed = true;
+          ++state.num_lanes_used;
+        }
+      }
+
+      // The claim guarantees a node in some lane. Take the best one of our own lane, or steal the best one of
+      // another lane.
+      while (!has_node) {
+        for (size_t i = 0; i < state.num_lanes && !has_node; ++i) {
+          auto& victim = state.lanes[(lane + i) % state.num_lanes];
+          std::lock_guard<std::mutex> lock(victim.mutex);
+          if (!victim.ready.empty()) {
+            std::pop_heap(victim.ready.begin(), victim.ready.end(), higher_ranked);
+            node_idx = victim.ready.back();
+            victim.ready.pop_back();
+            has_node = true;
+          }
+        }
+      }
+    }
+
+    Status status = RunNode(state, node_idx);
+
+    // Continue with the highest ranked successor that became ready and queue the others in our lane.
+    InlinedVector<size_t> ready;
+    if (status.IsOK()) {
+      for (size_t successor : nodes_[node_idx].successors) {
+        if (state.pending_predecessors[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+          ready.push_back(successor);
+        }
+      }
+    }
+
+    has_node = false;
+    if (!ready.empty()) {
+      auto best = std::max_element(ready.begin(), ready.end(), higher_ranked);
+      node_idx = *best;
+      has_node = true;
+      ready.erase(best);
+    }
+
+    if (!ready.empty()) {
+      auto& own = state.lanes[lane];
+      std::lock_guard<std::mutex> lock(own.mutex);
+      for (size_t successor : ready) {
+        own.ready.push_back(successor);
+        std::push_heap(own.ready.begin(), own.ready.end(), higher_ranked);
+      }
+    }
+
+    InlinedVector<size_t> start_lanes;
+    {
+      std::lock_guard<std::mutex> lock(state.mutex);
+      if (!status.IsOK()) {
+        if (state.status.IsOK()) {
+          state.status = status;
+        }
+        state.finished = true;
+      } else {
+        state.num_queued += ready.size();
+        if (++state.num_done == nodes_.size()) {
+          state.finished = true;
+        }
+      }
+
+      if (state.finished) {
+        has_node = false;
+      } else if (!ready.empty()) {
+        // A waiting caller takes one of the queued nodes; start lane tasks for the rest.
+        size_t num_to_start = ready.size();
+        if (state.caller_waiting) {
+          state.caller_waiting = false;
+          --num_to_start;
+        }
+        while (start_lanes.size() < num_to_start && !state.free_lanes.empty()) {
+          start_lanes.push_back(state.free_lanes.back());
+          state.free_lanes.pop_back();
+        }
+      }
+      if (!has_node) {
+        --state.num_running;
+      }
+    }
+
+    for (size_t new_lane : start_lanes) {
+      StartLane(state_ptr, new_lane);
+    }
+    if (!has_node || !ready.empty()) {
+      state.cv.notify_all();
+    }
+  }
+}
+
+Status CriticalPathExecutor::RunNode(RunState& state, size_t node_idx) {
+  if (*state.terminate_flag) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Exiting due to terminate flag being set to true.");
+  }
+
+  const auto& node_info = nodes_[node_idx];
+  const OpKernel& kernel = *node_info.kernel;
+  auto& frame = *state.frame;
+  OpKernelContextInternal kernel_ctx(session_state_, frame, kernel, *state.logger, *state.terminate_flag, nullptr);
+
+  const auto start = std::chrono::steady_clock::now();
+  Status status;
+  ORT_TRY {
+    status = kernel.Compute(&kernel_ctx);
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+    });
+  }
+
+  if (!status.IsOK()) {
+    const auto& node = kernel.Node();
+    const auto msg_string = MakeString("Non-zero status code returned while running ", node.OpType(),
+                                       " node. Name:'", node.Name(), "' Status Message: ", status.ErrorMessage());
+    LOGS(*state.logger, ERROR) << msg_string;
+    return Status(status.Category(), status.Code(), msg_string);
+  }
+
+  const double elapsed_ns = static_cast<double>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+  auto& measured = measured_costs_[node_idx];
+  const double previous = measured.load(std::memory_order_relaxed);
+  measured.store(previous == 0.0 ? std::max(elapsed_ns, 1.0) : 0.9 * previous + 0.1 * elapsed_ns,
+                 std::memory_order_relaxed);
+
+  const auto& release_actions = session_state_.GetExecutionPlan()->release_actions;
+  for (size_t idx : node_info.release_actions) {
+    if (state.release_counts[idx].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      ORT_RETURN_IF_ERROR(frame.ReleaseMLValue(static_cast<int>(release_actions[idx].value_index)));
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/logging/logging.h"
+#include "core/framework/iexecutor.h"
+#include "core/framework/ort_value.h"
+
+namespace onnxruntime {
+
+class OpKernel;
+class SessionState;
+namespace concurrency {
+class ThreadPool;
+}
+
+/**
+ * DAG executor for ExecutionMode::ORT_PARALLEL that schedules ready nodes by their distance to the end of the graph
+ * (kOrtSessionOptionsCriticalPathExecutor).
+ *
+ * Each node has a cost estimate. The first run uses a FLOP estimate from the static shapes in the graph; later runs
+ * use a moving average of the measured node times. A node's rank is its cost plus the largest rank of its
+ * successors, so the nodes on the critical path have the highest rank.
+ *
+ * A run uses up to as many lanes as the graph is wide. The caller is the first lane and the others are tasks on the
+ * intra-op thread pool, so branch parallelism and intra-op loops share one set of threads instead of
+ * oversubscribing the cores. Each lane keeps a deque of ready nodes ordered by rank. When a lane finishes a node, it
+ * continues with the highest ranked successor that became ready and pushes the others to its deque. An idle lane
+ * steals the highest ranked node from another lane.
+ *
+ * A lane task returns its thread to the pool as soon as no node is queued, and new lane tasks are started when
+ * nodes become ready, so the narrow parts of the graph leave the pool to the intra-op loops of the running nodes.
+ */
+class CriticalPathExecutor {
+ public:
+  // Returns nullptr if the main graph of `session_state` cannot be run by this executor.
+  static std::unique_ptr<CriticalPathExecutor> Create(const SessionState& session_state);
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CriticalPathExecutor);
+
+  /**
+   * Runs the graph for `feeds`. Returns false without running anything if profiling or node stats are enabled, as
+   * they need the hooks of the regular executor; the caller must then execute the plan itself.
+   * When true is returned, `status` holds the result of the run.
+   */
+  bool TryExecute(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
+                  gsl::span<const int> fetch_mlvalue_idxs, std::vector<OrtValue>& fetches,
+                  const std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators,
+                  const logging::Logger& logger, const bool& terminate_flag, Status& status);
+
+  // Number of lanes that ran at least one node in the last completed run.
+  size_t LastRunLaneCount() const { return last_run_lane_count_.load(std::memory_order_relaxed); }
+
+ private:
+  struct Node {
+    const OpKernel* kernel;
+    InlinedVector<size_t> successors;
+    size_t num_predecessors = 0;
+    // indices into SequentialExecutionPlan::release_actions of the values this node consumes, or produces without
+    // consumers, counted down after this node
+    InlinedVector<size_t> release_actions;
+  };
+
+  struct RunState;
+
+  CriticalPathExecutor(const SessionState& session_state, concurrency::ThreadPool& thread_pool,
+                       std::vector<Node> nodes, std::vector<double> static_costs,
+                       std::vector<size_t> release_counts, size_t max_width);
+
+  std::shared_ptr<const std::vector<double>> ComputeRanks(const std::vector<double>& costs) const;
+
+  // Recomputes the ranks from the measured node times.
+  void UpdateRanks();
+
+  void StartLane(const std::shared_ptr<RunState>& state, size_t lane);
+
+  void RunLane(const std::shared_ptr<RunState>& state, size_t lane);
+
+  Status RunNode(RunState& state, size_t node_idx);
+
+  const SessionState& session_state_;
+  concurrency::ThreadPool& thread_pool_;
+  // in plan order, which is a topological order
+  const std::vector<Node> nodes_;
+  // per release action, the number of nodes that count it down before the value is released
+  const std::vector<size_t> release_counts_;
+  const size_t max_width_;
+
+  // moving average of the measured time of each node, in nanoseconds. 0 until the node has run once.
+  std::unique_ptr<std::atomic<double>[]> measured_costs_;
+
+  mutable std::mutex ranks_mutex_;
+  std::shared_ptr<const std::vector<double>> ranks_;  // GUARDED_BY(ranks_mutex_)
+
+  std::atomic<size_t> last_run_lane_count_{0};
+};
+
+}  // namespace onnxruntime
@@ -340,7 +340,8 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
 #ifdef ORT_ENABLE_STREAM
                                const DeviceStreamCollection* device_streams,
 #endif
-                               const SessionState& session_state)
+                               const SessionState& session_state,
+                               const PersistentMemoryPattern* persistent_memory_pattern)
     : IExecutionFrame(session_state.GetOrtValueNameIdxMap(), session_state.GetNodeIndexInfo(), fetch_mlvalue_idxs),
 #ifdef ORT_ENABLE_STREAM
       device_streams_(device_streams),
@@ -380,10 +381,18 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
     }
   }
 
-  // If the session enable memory pattern optimization
-  // and we have execution plan generated, try to setup
-  // memory pattern optimization.
-  if (session_state.GetEnableMemoryPattern() && session_state.GetExecutionPlan()) {
+  if (persistent_memory_pattern != nullptr) {
+    // the caller owns the buffers, so they are wrapped with a deleter that does not free them.
+    mem_patterns_ = persistent_memory_pattern->patterns;
+    inferred_shapes_ = persistent_memory_pattern->inferred_shapes;
+    buffers_.reserve(persistent_memory_pattern->buffers.size());
+    for (const auto& [location, buffer] : persistent_memory_pattern->buffers) {
+      buffers_[location] = BufferUniquePtr(buffer, BufferDeleter());
+    }
+  } else if (session_state.GetEnableMemoryPattern() && session_state.GetExecutionPlan()) {
+    // If the session enable memory pattern optimization
+    // and we have execution plan generated, try to setup
+    // memory pattern optimization.
     bool all_tensors = true;
     // Reserve mem to avoid re-allocation.
     for (const auto& feed : feeds) {
@@ -139,6 +139,15 @@ class IExecutionFrame {
   const OrtValueNameIdxMap& ort_value_idx_map_;
 };
 
+// A memory pattern together with buffers that outlive a single run. The buffers are owned by the caller and must
+// hold at least PeakSize() bytes for every location in `patterns`. Used by CpuReplayExecutor so a replayed run
+// neither looks up the pattern cache nor allocates the activation buffers.
+struct PersistentMemoryPattern {
+  const MemoryPatternGroup* patterns{nullptr};
+  const InlinedHashMap<int, TensorShape>* inferred_shapes{nullptr};
+  InlinedHashMap<OrtDevice, void*> buffers;
+};
+
 class ExecutionFrame final : public IExecutionFrame {
  public:
   ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span<const OrtValue> feeds,
@@ -148,7 +157,9 @@ class ExecutionFrame final : public IExecutionFrame {
 #ifdef ORT_ENABLE_STREAM
                  const DeviceStreamCollection* device_streams,
 #endif
-                 const SessionState& session_state);
+                 const SessionState& session_state,
+                 // optional memory pattern to use instead of the session state's pattern cache
+                 const PersistentMemoryPattern* persistent_memory_pattern = nullptr);
   ~ExecutionFrame() override;
 
   // TODO: These two AllocateMLValue... methods are in the API purely for unit test usage.
@@ -0,0 +1,129 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/huge_page_allocator.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "core/common/logging/logging.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+
+#if defined(__linux__)
+namespace {
+
+constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+
+// from <linux/mempolicy.h>, which needs libnuma's headers to be installed
+constexpr int kMpolLocal = 4;
+
+size_t RoundUpToHugePage(size_t size) {
+  return (size + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+}
+
+void* MapTransparentHugePages(size_t length) {
+  // over-map by one huge page so the region can be aligned to a huge page boundary
+  const size_t mapped_length = length + kHugePageSize;
+  void* mapped = mmap(nullptr, mapped_length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (mapped == MAP_FAILED) {
+    return nullptr;
+  }
+
+  auto* begin = static_cast<char*>(mapped);
+  auto* aligned = reinterpret_cast<char*>(
+      RoundUpToHugePage(reinterpret_cast<std::uintptr_t>(begin)));
+  if (aligned != begin) {
+    munmap(begin, aligned - begin);
+  }
+  const size_t tail = (begin + mapped_length) - (aligned + length);
+  if (tail != 0) {
+    munmap(aligned + length, tail);
+  }
+
+  if (madvise(aligned, length, MADV_HUGEPAGE) != 0) {
+    LOGS_DEFAULT(VERBOSE) << "madvise(MADV_HUGEPAGE) failed with errno " << errno
+                          << ". Transparent huge pages may be disabled.";
+  }
+  return aligned;
+}
+
+}  // namespace
+#endif
+
+HugePageCPUAllocator::HugePageCPUAllocator(const OrtMemoryInfo& memory_info, HugePageMode mode)
+    : IAllocator(memory_info), mode_(mode) {
+}
+
+void* HugePageCPUAllocator::Alloc(size_t size) {
+  if (size == 0) {
+    return nullptr;
+  }
+
+#if defined(__linux__)
+  if (mode_ != HugePageMode::kDisabled) {
+    const size_t length = RoundUpToHugePage(size + MLAS_SYMM_QGEMM_BUF_OVERRUN);
+
+    void* p = nullptr;
+    if (mode_ == HugePageMode::kHugeTlb) {
+      p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      if (p == MAP_FAILED) {
+        LOGS_DEFAULT(VERBOSE) << "mmap(MAP_HUGETLB) of " << length << " bytes failed with errno " << errno
+                              << ". Falling back to transparent huge pages.";
+        p = nullptr;
+      }
+    }
+    if (p == nullptr) {
+      p = MapTransparentHugePages(length);
+    }
+    if (p == nullptr) {
+      ORT_THROW_EX(std::bad_alloc);
+    }
+
+    // Place pages on the node of the thread that first touches them, overriding any process wide policy.
+    // Failures are ignored as the policy is only an optimization.
+    syscall(SYS_mbind, p, length, kMpolLocal, nullptr, 0, 0);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    region_lengths_[p] = length;
+    return p;
+  }
+#endif
+
+  const auto alignment = std::max(Info().device.GetAlignment(), MlasGetPreferredBufferAlignment());
+  return AllocatorDefaultAllocAligned(size, alignment);
+}
+
+void HugePageCPUAllocator::Free(void* p) {
+  if (p == nullptr) {
+    return;
+  }
+
+#if defined(__linux__)
+  if (mode_ != HugePageMode::kDisabled) {
+    size_t length = 0;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = region_lengths_.find(p);
+      ORT_ENFORCE(it != region_lengths_.end(), "Freeing a pointer not allocated by HugePageCPUAllocator");
+      length = it->second;
+      region_lengths_.erase(it);
+    }
+    munmap(p, length);
+    return;
+  }
+#endif
+
+  const auto alignment = std::max(Info().device.GetAlignment(), MlasGetPreferredBufferAlignment());
+  AllocatorDefaultFreeAligned(p, alignment);
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,46 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+
+#include "core/framework/allocator.h"
+
+namespace onnxruntime {
+
+// Values of OrtArenaCfg::huge_pages.
+enum class HugePageMode : int {
+  kDisabled = 0,
+  // anonymous mmap regions aligned to 2MB with madvise(MADV_HUGEPAGE), so transparent huge pages back them
+  kTransparent = 1,
+  // mmap(MAP_HUGETLB) from the preallocated huge page pool, falling back to kTransparent if the pool is exhausted
+  kHugeTlb = 2,
+};
+
+/**
+ * CPU device allocator for arena regions that are backed by huge pages, which cuts the dTLB misses of kernels
+ * streaming through multi-GB weights and activations.
+ *
+ * Regions are never touched here, so with the local NUMA policy set on them every page is placed on the node of the
+ * (intra-op) thread that first writes it, even if the process runs under an interleave policy.
+ *
+ * Only available on Linux; elsewhere it behaves like CPUAllocator.
+ */
+class HugePageCPUAllocator : public IAllocator {
+ public:
+  HugePageCPUAllocator(const OrtMemoryInfo& memory_info, HugePageMode mode);
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+
+ private:
+  const HugePageMode mode_;
+
+  // mapping length of every region, which munmap needs
+  std::mutex mutex_;
+  std::unordered_map<void*, size_t> region_lengths_;  // GUARDED_BY(mutex_)
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,147 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/initializer_prefetcher.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "core/common/inlined_containers.h"
+#include "core/framework/sequential_execution_plan.h"
+#include "core/framework/session_state.h"
+#include "core/platform/EigenNonBlockingThreadPool.h"
+
+namespace onnxruntime {
+
+namespace {
+
+constexpr size_t kPageSize = 4096;
+// touched between checks of the stop flag
+constexpr size_t kChunkSize = 1024 * 1024;
+
+}  // namespace
+
+// Env::CreateThread hands its start routine a thread pool interface. The prefetcher is not a pool, so this adapter
+// only forwards the start routine to Prefetch, and a cancellation to the stop flag.
+class InitializerPrefetcher::ThreadParam final : public Eigen::ThreadPoolInterface {
+ public:
+  explicit ThreadParam(InitializerPrefetcher& prefetcher) : prefetcher_(prefetcher) {}
+
+  static unsigned ThreadMain(int /*id*/, Eigen::ThreadPoolInterface* param) {
+    static_cast<ThreadParam*>(param)->prefetcher_.Prefetch();
+    return 0;
+  }
+
+  void Schedule(std::function<void()> fn) override { fn(); }
+  void Cancel() override { prefetcher_.stop_.store(true, std::memory_order_relaxed); }
+  int NumThreads() const override { return 1; }
+  int CurrentThreadId() const override { return -1; }
+
+ private:
+  InitializerPrefetcher& prefetcher_;
+};
+
+InitializerPrefetcher::InitializerPrefetcher(const SessionState& session_state, const logging::Logger& logger,
+                                             const ThreadOptions& thread_options)
+    : logger_(logger) {
+  const auto& initializers = session_state.GetInitializedTensors();
+  const auto& name_idx_map = session_state.GetOrtValueNameIdxMap();
+  const auto& graph_viewer = session_state.GetGraphViewer();
+
+  InlinedHashSet<const void*> seen;
+  auto add_initializers = [&](const Node& node) {
+    for (const auto* input_def : node.InputDefs()) {
+      int ort_value_idx = 0;
+      if (!input_def->Exists() || !name_idx_map.GetIdx(input_def->Name(), ort_value_idx).IsOK()) {
+        continue;
+      }
+
+      auto it = initializers.find(ort_value_idx);
+      if (it == initializers.end() || !it->second.IsTensor()) {
+        continue;
+      }
+
+      const auto& tensor = it->second.Get<Tensor>();
+      if (tensor.Location().device.Type() != OrtDevice::CPU || tensor.SizeInBytes() == 0 || tensor.IsDataTypeString()) {
+        continue;
+      }
+
+      if (seen.insert(tensor.DataRaw()).second) {
+        ranges_.emplace_back(tensor.DataRaw(), tensor.SizeInBytes());
+      }
+    }
+  };
+
+  if (const auto* plan = session_state.GetExecutionPlan(); plan != nullptr) {
+    for (const auto& stream : plan->execution_plan) {
+      for (const auto& step : stream->steps_) {
+        if (const auto* node = graph_viewer.GetNode(step->GetNodeIndex()); node != nullptr) {
+          add_initializers(*node);
+        }
+      }
+    }
+  }
+
+  // nodes that are not in the plan, e.g. when it has not been created
+  for (const auto& node : graph_viewer.Nodes()) {
+    add_initializers(node);
+  }
+
+  thread_param_ = std::make_unique<ThreadParam>(*this);
+  thread_.reset(Env::Default().CreateThread(ORT_TSTR("ort_prefetch"), 0, ThreadParam::ThreadMain, thread_param_.get(),
+                                            thread_options));
+}
+
+InitializerPrefetcher::~InitializerPrefetcher() {
+  stop_.store(true, std::memory_order_relaxed);
+  Wait();
+}
+
+void InitializerPrefetcher::Wait() {
+  // EnvThread joins the thread when it is destroyed
+  thread_.reset();
+}
+
+void InitializerPrefetcher::Prefetch() {
+  const auto start = std::chrono::steady_clock::now();
+
+#if defined(__linux__)
+  // Start the reads of all regions right away; the loop below waits for them in order.
+  const auto page_size = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+  for (const auto& [data, size] : ranges_) {
+    const auto begin = reinterpret_cast<uintptr_t>(data) & ~(page_size - 1);
+    const auto end = reinterpret_cast<uintptr_t>(data) + size;
+    madvise(reinterpret_cast<void*>(begin), end - begin, MADV_WILLNEED);
+  }
+#endif
+
+  // the page reads go through a volatile sink so that they are not optimized away
+  volatile uint8_t sink = 0;
+  for (const auto& [data, size] : ranges_) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t chunk = 0; chunk < size; chunk += kChunkSize) {
+      if (stop_.load(std::memory_order_relaxed)) {
+        return;
+      }
+
+      // reading one byte of every page faults it in
+      const size_t chunk_end = std::min(size, chunk + kChunkSize);
+      for (size_t offset = chunk; offset < chunk_end; offset += kPageSize) {
+        sink = bytes[offset];
+      }
+      num_prefetched_bytes_.fetch_add(chunk_end - chunk, std::memory_order_relaxed);
+    }
+  }
+
+  const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+  LOGS(logger_, VERBOSE) << "Prefetched " << ranges_.size() << " initializers (" << NumPrefetchedBytes()
+                         << " bytes) in " << elapsed.count() << " ms";
+}
+
+}  // namespace onnxruntime
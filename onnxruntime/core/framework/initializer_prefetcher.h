@@ -0,0 +1,58 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/logging/logging.h"
+#include "core/platform/env.h"
+
+namespace onnxruntime {
+
+class SessionState;
+
+/**
+ * Pages in the CPU initializers of a session on a background thread (kOrtSessionOptionsPrefetchInitializers).
+ *
+ * Initializers in external data files are memory mapped and only read from disk when a kernel first touches them,
+ * which makes the first runs after loading a large model slow. The prefetcher touches the initializers of the main
+ * graph in execution plan order, so the first Run can start while the later weights are still being read.
+ * Initializers that are only used by subgraphs, e.g. an If branch, are left to be paged in on demand.
+ */
+class InitializerPrefetcher {
+ public:
+  /// The thread is created with Env::CreateThread, so custom thread creation hooks in thread_options apply to it.
+  InitializerPrefetcher(const SessionState& session_state, const logging::Logger& logger,
+                        const ThreadOptions& thread_options = {});
+
+  /// Stops prefetching and joins the thread.
+  ~InitializerPrefetcher();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(InitializerPrefetcher);
+
+  /// Waits until every initializer has been prefetched.
+  void Wait();
+
+  size_t NumPrefetchedBytes() const { return num_prefetched_bytes_.load(std::memory_order_relaxed); }
+
+ private:
+  // start routine parameter of the EnvThread, see the .cc file
+  class ThreadParam;
+
+  void Prefetch();
+
+  const logging::Logger& logger_;
+  // address and size of every initializer, in execution plan order
+  std::vector<std::pair<const void*, size_t>> ranges_;
+  std::atomic<bool> stop_{false};
+  std::atomic<size_t> num_prefetched_bytes_{0};
+  std::unique_ptr<ThreadParam> thread_param_;
+  std::unique_ptr<EnvThread> thread_;
+};
+
+}  // namespace onnxruntime
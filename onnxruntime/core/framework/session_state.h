@@ -18,6 +18,8 @@
 #include "core/common/logging/logging.h"
 #include "core/common/profiler.h"
 #include "core/framework/allocation_planner.h"
+#include "core/framework/cpu_replay_executor.h"
+#include "core/framework/critical_path_executor.h"
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/external_data_loader_manager.h"
 #include "core/framework/execution_providers.h"
@@ -259,6 +261,28 @@ class SessionState {
   */
   void ResolveMemoryPatternFlag();
 
+  /**
+  Enable record-and-replay execution if the execution plan is eligible. See CpuReplayExecutor.
+  Returns false if the plan cannot be replayed.
+  */
+  bool EnableCpuReplay();
+
+  /**
+  Get the replay executor, or nullptr if replay is not enabled.
+  */
+  CpuReplayExecutor* GetCpuReplayExecutor() const { return cpu_replay_executor_.get(); }
+
+  /**
+  Enable the critical-path-aware executor for ExecutionMode::ORT_PARALLEL if the graph is eligible.
+  See CriticalPathExecutor. Returns false if the graph cannot be run by it.
+  */
+  bool EnableCriticalPathExecutor();
+
+  /**
+  Get the critical-path-aware executor, or nullptr if it is not enabled.
+  */
+  CriticalPathExecutor* GetCriticalPathExecutor() const { return critical_path_executor_.get(); }
+
   struct NodeInfo {
     /**
      *
@@ -397,8 +421,10 @@ class SessionState {
   // Populate OrtValueNameIdxMap and create the graph viewer.
   void CreateGraphInfo(bool save_prepacked_on);
 
-  // create kernels using info in kernel_create_info_map_
-  Status CreateKernels(const KernelRegistryManager& custom_registry_manager);
+  // create kernels using info in kernel_create_info_map_.
+  // kernels of the CPU EP are created concurrently on `thread_pool` if it is not nullptr.
+  Status CreateKernels(const KernelRegistryManager& custom_registry_manager,
+                       concurrency::ThreadPool* thread_pool = nullptr);
 
   // remove TensorProto versions of initializers from Graph instance
   // (replaced byOrtValue instances in initialized_tensors_)
@@ -407,9 +433,11 @@ class SessionState {
   /**
    * Prepack the constant initialized tensors for better performance.
    * The original constant initialized tensors will be removed to save memory.
+   * Kernels of the CPU EP are pre-packed concurrently on `thread_pool` if it is not nullptr.
    */
   Status PrepackConstantInitializedTensors(InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
-                                           const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map);
+                                           const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map,
+                                           concurrency::ThreadPool* thread_pool = nullptr);
 
   SessionState* GetMutableSubgraphSessionState(onnxruntime::NodeIndex index, const std::string& attribute_name);
 
@@ -531,6 +559,12 @@ class SessionState {
   NodeHashMap<int64_t, InlinedHashMap<int, TensorShape>> shape_patterns_;
 #endif
 
+  // set when the session enables replay and the plan is eligible
+  std::unique_ptr<CpuReplayExecutor> cpu_replay_executor_;
+
+  // set when the session enables the critical-path-aware executor and the graph is eligible
+  std::unique_ptr<CriticalPathExecutor> critical_path_executor_;
+
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
 
@@ -0,0 +1,219 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/shared_memory_prepacked_weights.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace onnxruntime {
+
+namespace {
+
+constexpr uint64_t kSegmentMagic = 0x3130575050545230ULL;  // "0RTPPW01"
+constexpr size_t kBufferAlignment = 64;
+
+struct SegmentHeader {
+  uint64_t magic;
+  uint64_t num_buffers;
+};
+
+struct SegmentBufferEntry {
+  uint64_t offset;  // 0 for a null buffer
+  uint64_t size;
+};
+
+size_t AlignUp(size_t value) {
+  return (value + kBufferAlignment - 1) / kBufferAlignment * kBufferAlignment;
+}
+
+}  // namespace
+
+std::string GetSharedMemoryPrepackedWeightsPath(const std::string& segment_prefix, const std::string& key) {
+  std::string name = segment_prefix + "-" + key;
+  for (auto& c : name) {
+    const bool allowed = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                         c == '-' || c == '_' || c == '.';
+    if (!allowed) {
+      c = '_';
+    }
+  }
+  return "/dev/shm/" + name;
+}
+
+#if defined(__linux__)
+namespace {
+
+struct SharedMapping {
+  SharedMapping(void* base_in, size_t length_in) : base(base_in), length(length_in) {}
+  ~SharedMapping() { munmap(base, length); }
+
+  void* const base;
+  const size_t length;
+};
+
+// Writes `weights` to a temporary file and renames it to `path`, so other processes never see a partial segment.
+bool CreateSegment(const std::string& path, const PrePackedWeights& weights, const logging::Logger& logger) {
+  const size_t num_buffers = weights.buffers_.size();
+  std::vector<SegmentBufferEntry> entries(num_buffers);
+  size_t length = AlignUp(sizeof(SegmentHeader) + num_buffers * sizeof(SegmentBufferEntry));
+  for (size_t i = 0; i < num_buffers; ++i) {
+    entries[i].size = weights.buffer_sizes_[i];
+    if (weights.buffers_[i] != nullptr) {
+      entries[i].offset = length;
+      length = AlignUp(length + weights.buffer_sizes_[i]);
+    }
+  }
+
+  // Sessions in the same process may publish the same segment concurrently, so the temporary name carries the
+  // thread and a per-process counter on top of the pid. O_EXCL guarantees that no other writer shares the file.
+  static std::atomic<uint64_t> temp_file_counter{0};
+  const std::string temp_path = path + "." + std::to_string(getpid()) + "." +
+                                std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + "." +
+                                std::to_string(temp_file_counter.fetch_add(1, std::memory_order_relaxed)) + ".tmp";
+  const int fd = open(temp_path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    LOGS(logger, WARNING) << "Failed to create shared memory segment " << temp_path << ". errno: " << errno;
+    return false;
+  }
+
+  void* base = MAP_FAILED;
+  if (ftruncate(fd, static_cast<off_t>(length)) == 0) {
+    base = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (base == MAP_FAILED) {
+    LOGS(logger, WARNING) << "Failed to allocate " << length << " bytes for shared memory segment " << temp_path
+                          << ". errno: " << errno;
+    unlink(temp_path.c_str());
+    return false;
+  }
+
+  auto* bytes = static_cast<uint8_t*>(base);
+  const SegmentHeader header{kSegmentMagic, num_buffers};
+  std::memcpy(bytes, &header, sizeof(header));
+  if (num_buffers != 0) {
+    std::memcpy(bytes + sizeof(header), entries.data(), num_buffers * sizeof(SegmentBufferEntry));
+  }
+  for (size_t i = 0; i < num_buffers; ++i) {
+    if (entries[i].offset != 0) {
+      std::memcpy(bytes + entries[i].offset, weights.buffers_[i].get(), entries[i].size);
+    }
+  }
+  munmap(base, length);
+
+  if (rename(temp_path.c_str(), path.c_str()) != 0) {
+    LOGS(logger, WARNING) << "Failed to publish shared memory segment " << path << ". errno: " << errno;
+    unlink(temp_path.c_str());
+    return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+std::optional<PrePackedWeights> SharePrePackedWeightsAcrossProcesses(const std::string& segment_prefix,
+                                                                     const std::string& key,
+                                                                     const PrePackedWeights& weights,
+                                                                     const logging::Logger& logger) {
+  const std::string path = GetSharedMemoryPrepackedWeightsPath(segment_prefix, key);
+
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+  if (fd < 0 && errno == ENOENT) {
+    if (!CreateSegment(path, weights, logger)) {
+      return std::nullopt;
+    }
+    LOGS(logger, VERBOSE) << "Published pre-packed weight " << key << " to " << path;
+    fd = open(path.c_str(), O_RDONLY | O_CLOEXEC | O_NOFOLLOW);
+  }
+  if (fd < 0) {
+    LOGS(logger, WARNING) << "Failed to open shared memory segment " << path << ". errno: " << errno;
+    return std::nullopt;
+  }
+
+  // The segment name is predictable, so only segments that no other user can have written are trusted.
+  struct stat st {};
+  if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_uid != geteuid() ||
+      (st.st_mode & (S_IWGRP | S_IWOTH)) != 0) {
+    close(fd);
+    LOGS(logger, WARNING) << "Shared memory segment " << path
+                          << " is not a regular file owned and only writable by the current user. Not using it.";
+    return std::nullopt;
+  }
+
+  void* base = MAP_FAILED;
+  if (static_cast<size_t>(st.st_size) >= sizeof(SegmentHeader)) {
+    base = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+  }
+  close(fd);
+  if (base == MAP_FAILED) {
+    LOGS(logger, WARNING) << "Failed to map shared memory segment " << path << ". errno: " << errno;
+    return std::nullopt;
+  }
+
+  auto mapping = std::make_shared<SharedMapping>(base, static_cast<size_t>(st.st_size));
+  const auto* bytes = static_cast<const uint8_t*>(base);
+
+  // The key hashes the contents, but a hash collision must not feed wrong weights to the kernels, so the mapped
+  // buffers are compared with the freshly pre-packed ones too.
+  SegmentHeader header;
+  std::memcpy(&header, bytes, sizeof(header));
+  const size_t num_buffers = weights.buffers_.size();
+  bool valid = header.magic == kSegmentMagic && header.num_buffers == num_buffers &&
+               sizeof(SegmentHeader) + num_buffers * sizeof(SegmentBufferEntry) <= mapping->length;
+
+  PrePackedWeights shared;
+  for (size_t i = 0; valid && i < num_buffers; ++i) {
+    SegmentBufferEntry entry;
+    std::memcpy(&entry, bytes + sizeof(SegmentHeader) + i * sizeof(SegmentBufferEntry), sizeof(entry));
+    valid = entry.size == weights.buffer_sizes_[i] &&
+            (entry.offset != 0) == (weights.buffers_[i] != nullptr) &&
+            entry.offset + entry.size <= mapping->length &&
+            (entry.offset == 0 || std::memcmp(bytes + entry.offset, weights.buffers_[i].get(), entry.size) == 0);
+    if (!valid) {
+      break;
+    }
+
+    if (entry.offset == 0) {
+      shared.buffers_.emplace_back(nullptr, [](void*) {});
+    } else {
+      // Kernels only read pre-packed buffers, so the mapping is exposed as mutable to fit PrePackedWeights.
+      shared.buffers_.emplace_back(const_cast<uint8_t*>(bytes) + entry.offset, [mapping](void*) {});
+    }
+    shared.buffer_sizes_.push_back(static_cast<size_t>(entry.size));
+  }
+
+  if (!valid) {
+    LOGS(logger, WARNING) << "Shared memory segment " << path << " does not match the pre-packed weight " << key
+                          << ". Remove the stale segment to share it again.";
+    return std::nullopt;
+  }
+
+  return shared;
+}
+
+#else
+
+std::optional<PrePackedWeights> SharePrePackedWeightsAcrossProcesses(const std::string& /*segment_prefix*/,
+                                                                     const std::string& /*key*/,
+                                                                     const PrePackedWeights& /*weights*/,
+                                                                     const logging::Logger& /*logger*/) {
+  return std::nullopt;
+}
+
+#endif
+
+}  // namespace onnxruntime
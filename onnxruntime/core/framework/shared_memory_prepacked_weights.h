@@ -0,0 +1,37 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <optional>
+#include <string>
+
+#include "core/common/logging/logging.h"
+#include "core/framework/prepacked_weights.h"
+
+namespace onnxruntime {
+
+/**
+ * Shares pre-packed weights between processes that load the same model
+ * (kOrtSessionOptionsSharedMemoryPrepackedWeightsPrefix).
+ *
+ * Every pre-packed weight is published as a file in /dev/shm named after `segment_prefix` and its key, which
+ * contains a hash of the pre-packed contents. The first process to pre-pack a weight writes the segment; later
+ * processes find it and map it read-only, so the pages of the weight are held once per host. Segments outlive the
+ * processes that created them, so restarted workers reuse them too. They can be removed with
+ * `rm /dev/shm/<segment_prefix>-*` once no process uses them.
+ */
+
+// Returns the path of the shared memory segment for the pre-packed weight `key`.
+std::string GetSharedMemoryPrepackedWeightsPath(const std::string& segment_prefix, const std::string& key);
+
+// Returns a copy of `weights` whose buffers are backed by the read-only shared memory segment for `key`, creating the
+// segment from `weights` if it does not exist yet. The mapping is released with the last buffer of the copy.
+// Returns std::nullopt if the segment cannot be used, e.g. on platforms other than Linux, in which case the caller
+// keeps `weights`.
+std::optional<PrePackedWeights> SharePrePackedWeightsAcrossProcesses(const std::string& segment_prefix,
+                                                                     const std::string& key,
+                                                                     const PrePackedWeights& weights,
+                                                                     const logging::Logger& logger);
+
+}  // namespace onnxruntime
@@ -620,6 +620,28 @@ ExecuteGraphImpl(const SessionState& session_state,
 
   // see if we can skip copies due to the types of execution providers available
   if (device_copy_checks.status == DeviceCopyCheck::NoCopy) {
+    // replay a recorded run if the session has one for these input shapes
+    auto* cpu_replay_executor = session_state.GetCpuReplayExecutor();
+    if (cpu_replay_executor && fetch_allocators.empty() && !only_execute_path_to_fetches) {
+      Status replay_status;
+      if (cpu_replay_executor->TryReplay(feeds_fetches_info.feeds_mlvalue_idxs, feeds,
+                                         feeds_fetches_info.fetches_mlvalue_idxs, fetches,
+                                         logger, terminate_flag, replay_status)) {
+        return replay_status;
+      }
+    }
+
+    // run the graph on the critical-path-aware executor if the session uses it
+    auto* critical_path_executor = session_state.GetCriticalPathExecutor();
+    if (critical_path_executor && !single_thread_mode && !only_execute_path_to_fetches) {
+      Status status;
+      if (critical_path_executor->TryExecute(feeds_fetches_info.feeds_mlvalue_idxs, feeds,
+                                             feeds_fetches_info.fetches_mlvalue_idxs, fetches, fetch_allocators,
+                                             logger, terminate_flag, status)) {
+        return status;
+      }
+    }
+
     // no device copies are needed so simple execute
     auto status = (ExecuteThePlan(session_state,
                                   feeds_fetches_info.feeds_mlvalue_idxs, feeds,
@@ -280,11 +280,17 @@ void BaseGroupQueryAttentionTypeAndShapeInference(ONNX_NAMESPACE::InferenceConte
   }
 
   if (ctx.getNumOutputs() >= 3) {  // has present output
-    // copy the type from query to present key
-    ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, 0, 1);
+    if (past_key_index >= 0 && ctx.hasInput(past_key_index)) {
+      // copy the type from past key/value, which may be a quantized cache, to present key/value
+      ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, past_key_index, 1);
+      ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, static_cast<size_t>(past_key_index) + 1, 2);
+    } else {
+      // copy the type from query to present key
+      ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, 0, 1);
 
-    // copy the type from query to present value
-    ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, 0, 2);
+      // copy the type from query to present value
+      ONNX_NAMESPACE::propagateElemTypeFromInputToOutput(ctx, 0, 2);
+    }
 
     int64_t total_sequence_length_value = 0;
     const auto* total_sequence_length_data = ctx.getInputData(6);
@@ -378,6 +384,13 @@ void GroupQueryAttentionTypeAndShapeInference(ONNX_NAMESPACE::InferenceContext&
   // TODO(aciddelgado): propagate output shapes depending if kv-share buffer is on or not
   constexpr int use_max_past_present_buffer = -1;
   BaseGroupQueryAttentionTypeAndShapeInference(ctx, past_key_index, use_max_past_present_buffer, qk_output_index);
+
+  // present_key_scale and present_value_scale of an int8 cache
+  for (size_t i = static_cast<size_t>(qk_output_index) + 1; i < ctx.getNumOutputs(); ++i) {
+    if (ctx.hasOutput(static_cast<int>(i))) {
+      updateOutputElemType(ctx, i, ONNX_NAMESPACE::TensorProto::FLOAT);
+    }
+  }
 }
 
 void SparseAttentionTypeAndShapeInference(ONNX_NAMESPACE::InferenceContext& ctx, int past_key_index) {
@@ -1129,6 +1142,9 @@ Only supports causal and local attention.
 Supports rotary position embedding for CPU and CUDA.
 Supports packed input for CPU and CUDA.
 Supports continuous decoding for batch_size == 1 for CPU and CUDA.
+Supports an int8 k-v cache for CPU with float inputs: past and present key/value are int8 with one float scale per
+(batch_size, kv_num_heads, sequence position) row, passed in past_key_scale/past_value_scale and returned in
+present_key_scale/present_value_scale. New rows are quantized symmetrically when appended.
 
 )DOC";
 
@@ -1185,13 +1201,13 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                "past_key",
                "past state key with support for format BNSH. When past_key uses same tensor as present_key"
                "(k-v cache), it is of length max_sequence_length... otherwise of length past_sequence_length.",
-               "T",
+               "T_CACHE",
                OpSchema::Optional)
         .Input(4,
                "past_value",
                "past state value with support for format BNSH. When past_value uses same tensor as present_value"
                "(k-v cache), it is of length max_sequence_length... otherwise of length past_sequence_length.",
-               "T",
+               "T_CACHE",
                OpSchema::Optional)
         .Input(5,
                "seqlens_k",
@@ -1228,6 +1244,18 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                "1D tensor with shape (num_heads). Each head has a smooth factor adding to the denominator of softmax.",
                "T",
                OpSchema::Optional)
+        .Input(12,
+               "past_key_scale",
+               "Scales of an int8 past_key with shape (batch_size, kv_num_heads, past_sequence_length), one per row. "
+               "Required with an int8 cache.",
+               "tensor(float)",
+               OpSchema::Optional)
+        .Input(13,
+               "past_value_scale",
+               "Scales of an int8 past_value with shape (batch_size, kv_num_heads, past_sequence_length), one per row. "
+               "Required with an int8 cache.",
+               "tensor(float)",
+               OpSchema::Optional)
         .Output(0,
                 "output",
                 "3D output tensor with shape (batch_size, sequence_length, hidden_size)",
@@ -1237,19 +1265,33 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
                 "present state key with support for format BNSH. When past_key uses same tensor as present_key"
                 "(k-v buffer), it is of length max_sequence_length... otherwise of length past_sequence_length +"
                 "kv_sequence_length.",
-                "T")
+                "T_CACHE")
         .Output(2,
                 "present_value",
                 "present state value with support for format BNSH. When past_value uses same tensor as present_value"
                 "(k-v buffer), it is of length max_sequence_length... otherwise of length past_sequence_length +"
                 "kv_sequence_length.",
-                "T")
+                "T_CACHE")
         .Output(3,
                 "output_qk",
                 "Values of QK matrix multiplication, either before or after softmax normalization",
                 "T",
                 OpSchema::Optional)
+        .Output(4,
+                "present_key_scale",
+                "Scales of an int8 present_key with shape (batch_size, kv_num_heads, present_sequence_length). "
+                "Shares the buffer of past_key_scale when present_key shares the buffer of past_key.",
+                "tensor(float)",
+                OpSchema::Optional)
+        .Output(5,
+                "present_value_scale",
+                "Scales of an int8 present_value with shape (batch_size, kv_num_heads, present_sequence_length). "
+                "Shares the buffer of past_value_scale when present_value shares the buffer of past_value.",
+                "tensor(float)",
+                OpSchema::Optional)
         .TypeConstraint("T", {"tensor(float16)", "tensor(bfloat16)", "tensor(float)"}, "Constrain input and output to float tensors.")
+        .TypeConstraint("T_CACHE", {"tensor(float16)", "tensor(bfloat16)", "tensor(float)", "tensor(int8)"},
+                        "Constrain the k-v cache to T, or to int8 for a quantized cache.")
         .TypeConstraint("M", {"tensor(int32)"}, "Constrain mask to int tensor.")
         .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
           GroupQueryAttentionTypeAndShapeInference(ctx, 3, 3);
@@ -3558,6 +3558,12 @@ For example, for 4 bits, the first 4 bits are stored in the lower 4 bits of a by
             "computation. 4 means input A can be quantized with the same block_size to int8 internally from "
             "type T1.",
             AttributeProto::INT, static_cast<int64_t>(0))
+      .Attr("activation",
+            "Optional activation applied to the output after the bias: Relu, LeakyRelu, Tanh, Sigmoid, HardSigmoid, "
+            "Gelu, FastGelu, QuickGelu or Silu. Only supported by the CPU execution provider.",
+            AttributeProto::STRING, OPTIONAL_VALUE)
+      .Attr("activation_params", "The parameters of the activation, e.g. alpha of LeakyRelu and QuickGelu.",
+            AttributeProto::FLOATS, OPTIONAL_VALUE)
       .Input(0, "A", "The input tensor, not quantized.", "T1")
       .Input(1, "B",
              "Packed uint8 tensor of shape (N, k_blocks, blob_size), "
@@ -3,6 +3,7 @@
 
 #include "core/graph/constants.h"
 #include "core/graph/onnx_protobuf.h"
+#include "core/graph/contrib_ops/onnx_function_util.h"
 
 namespace ONNX_NAMESPACE {
 
@@ -18,13 +19,218 @@ ONNX_OPERATOR_SET_SCHEMA_EX(
         .Output(0, "Y", "Output tensor", "T")
         .TypeConstraint(
             "T",
-            {"tensor(float)", "tensor(float16)", "tensor(double)"},
+            {"tensor(float)", "tensor(float16)", "tensor(bfloat16)", "tensor(double)"},
             "Constrain input and output types to float tensors.")
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
         .SetContextDependentFunctionBodyBuilder(
-            [](const FunctionBodyBuildContext&, const OpSchema&, FunctionProto&) {
+            [](const FunctionBodyBuildContext& ctx, const OpSchema& schema, FunctionProto& functionProto) {
+              // Expansion used by EPs without a kMyCustomDomain kernel. Same constants as the my_cpu kernel:
+              // Y = 0.5 * X * (1 + tanh(X * (0.7978845608 + 0.0356774081 * X * X)))
+              auto* tp = ctx.getInputType(0);
+              if ((tp == nullptr) || (!tp->has_tensor_type()))
+                return false;
+              auto elem_type = (TensorProto_DataType)(tp->tensor_type().elem_type());
+
+              FunctionBuilder builder(functionProto);
+              builder
+                  .AddOpset("", 13)
+                  .Const("half", ToTensor(0.5, elem_type))
+                  .Const("alpha", ToTensor(0.7978845608028654, elem_type))
+                  .Const("beta", ToTensor(0.035677408136300125, elem_type))
+                  .Const("one", ToTensor(1.0, elem_type))
+                  .Add(R"(
+                    T1 = Mul (X, X)
+                    T2 = Mul (beta, T1)
+                    T3 = Add (alpha, T2)
+                    T4 = Mul (X, T3)
+                    T5 = Tanh (T4)
+                    T6 = Add (one, T5)
+                    T7 = Mul (X, T6)
+                    Y = Mul (half, T7)
+                  )");
+
+              schema.BuildFunction(functionProto);
               return true;
             }));
 
+ONNX_OPERATOR_SET_SCHEMA_EX(
+    SkipLayerNormalization,
+    MyVirtualNpu,
+    ::onnxruntime::kMyCustomDomain,
+    1,
+    true,
+    OpSchema()
+        .SetDoc("Fused residual add and layer normalization: output = LayerNorm(input + skip + bias).")
+        .Attr("epsilon", "The epsilon value to use to avoid division by zero.", AttributeProto::FLOAT, 1e-12f)
+        .Input(0, "input", "Input tensor with shape (batch_size, sequence_length, hidden_size)", "T")
+        .Input(1, "skip", "Skip tensor with shape (batch_size, sequence_length, hidden_size), "
+                          "(1, sequence_length, hidden_size), (sequence_length, hidden_size) or (hidden_size)", "T")
+        .Input(2, "gamma", "1D scale tensor with shape (hidden_size)", "T")
+        .Input(3, "beta", "1D shift tensor with shape (hidden_size)", "T", OpSchema::Optional)
+        .Input(4, "bias", "1D bias tensor with shape (hidden_size)", "T", OpSchema::Optional)
+        .Output(0, "output", "Normalized output with the same shape as input", "T")
+        .Output(1, "input_skip_bias_sum", "Sum of input, skip and bias with the same shape as input", "T",
+                OpSchema::Optional)
+        .TypeConstraint(
+            "T",
+            {"tensor(float)"},
+            "Constrain input and output types to float tensors.")
+        .TypeAndShapeInferenceFunction([](InferenceContext& ctx) {
+          propagateShapeAndTypeFromFirstInput(ctx);
+          if (ctx.getNumOutputs() > 1) {
+            propagateElemTypeFromInputToOutput(ctx, 0, 1);
+            if (hasInputShape(ctx, 0)) {
+              propagateShapeFromInputToOutput(ctx, 0, 1);
+            }
+          }
+        }));
+
+ONNX_OPERATOR_SET_SCHEMA_EX(
+    BiasGelu,
+    MyVirtualNpu,
+    ::onnxruntime::kMyCustomDomain,
+    1,
+    true,
+    OpSchema()
+        .SetDoc("Fused bias add and FastGelu: C = FastGelu(A + B), using the tanh approximation.")
+        .Input(0, "A", "Input tensor, typically the output of a MatMul", "T")
+        .Input(1, "B", "1D bias tensor broadcast along the last dimension of A", "T")
+        .Output(0, "C", "Output tensor with the same shape as A", "T")
+        .TypeConstraint(
+            "T",
+            {"tensor(float)"},
+            "Constrain input and output types to float tensors.")
+        .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput));
+
+ONNX_OPERATOR_SET_SCHEMA_EX(
+    Attention,
+    MyVirtualNpu,
+    ::onnxruntime::kMyCustomDomain,
+    1,
+    true,
+    OpSchema()
+        .SetDoc("Fused scaled dot-product attention: Y = Softmax(scale * Q * K^T + causal_mask) * V. "
+                "The output is returned in (batch_size, sequence_length, num_heads, v_head_size) layout, "
+                "i.e. already transposed for the output projection.")
+        .Attr("scale", "Scale applied to Q * K^T. Default value is 1/sqrt(head_size).", AttributeProto::FLOAT, 0.0f)
+        .Attr("unidirectional", "Whether every query position only attends to itself and earlier key positions.",
+              AttributeProto::INT, static_cast<int64_t>(1))
+        .Input(0, "query", "Query with shape (batch_size, num_heads, sequence_length, head_size)", "T")
+        .Input(1, "key", "Key with shape (batch_size, num_heads, kv_sequence_length, head_size)", "T")
+        .Input(2, "value", "Value with shape (batch_size, num_heads, kv_sequence_length, v_head_size)", "T")
+        .Output(0, "output", "Output with shape (batch_size, sequence_length, num_heads, v_head_size)", "T")
+        .TypeConstraint(
+            "T",
+            {"tensor(float)"},
+            "Constrain input and output types to float tensors.")
+        .TypeAndShapeInferenceFunction([](InferenceContext& ctx) {
+          propagateElemTypeFromInputToOutput(ctx, 0, 0);
+          if (!hasInputShape(ctx, 0) || !hasInputShape(ctx, 2)) {
+            return;
+          }
+          const auto& query_shape = getInputShape(ctx, 0);
+          const auto& value_shape = getInputShape(ctx, 2);
+          if (query_shape.dim_size() != 4 || value_shape.dim_size() != 4) {
+            fail_shape_inference("query and value are expected to be 4D");
+          }
+          TensorShapeProto output_shape;
+          *output_shape.add_dim() = query_shape.dim(0);
+          *output_shape.add_dim() = query_shape.dim(2);
+          *output_shape.add_dim() = query_shape.dim(1);
+          *output_shape.add_dim() = value_shape.dim(3);
+          updateOutputShape(ctx, 0, output_shape);
+        }));
+
+ONNX_OPERATOR_SET_SCHEMA_EX(
+    DecoderMaskedAttention,
+    MyVirtualNpu,
+    ::onnxruntime::kMyCustomDomain,
+    1,
+    true,
+    OpSchema()
+        .SetDoc("Causal attention for incremental decoding over a preallocated key/value cache. "
+                "past_key/past_value hold max_sequence_length positions, of which the first past_sequence_length "
+                "are valid. The new key/value rows are written at positions "
+                "[past_sequence_length, past_sequence_length + sequence_length) and the query attends to the valid "
+                "prefix including them. present_key/present_value must share the buffer of past_key/past_value "
+                "(like past_present_share_buffer in com.microsoft DecoderMaskedMultiHeadAttention), so a decode "
+                "step never copies the cache. A graph input is never aliased to an output by the allocation "
+                "planner, so when the cache is fed as a graph input the caller binds present_* onto the past_* "
+                "buffers with IOBinding; the kernel fails if they are not shared. "
+                "With an int8 cache, every (batch, head, position) row of past_key/past_value is stored as "
+                "symmetric int8 with its own float scale in past_key_scale/past_value_scale, which cuts the cache "
+                "footprint and the bytes read per decoded token 4x; the new rows are quantized as they are "
+                "appended and each cache block is dequantized right before it is multiplied.")
+        .Attr("scale", "Scale applied to Q * K^T. Default value is 1/sqrt(head_size).", AttributeProto::FLOAT, 0.0f)
+        .Input(0, "query", "Query with shape (batch_size, num_heads, sequence_length, head_size)", "T")
+        .Input(1, "key", "New key with shape (batch_size, num_heads, sequence_length, head_size)", "T")
+        .Input(2, "value", "New value with shape (batch_size, num_heads, sequence_length, v_head_size)", "T")
+        .Input(3, "past_key", "Key cache with shape (batch_size, num_heads, max_sequence_length, head_size)", "TC")
+        .Input(4, "past_value", "Value cache with shape (batch_size, num_heads, max_sequence_length, v_head_size)",
+               "TC")
+        .Input(5, "past_sequence_length", "Number of valid positions in the cache. Scalar or 1D tensor of size 1.", "M")
+        .Input(6, "past_key_scale",
+               "Per row scales of an int8 key cache with shape (batch_size, num_heads, max_sequence_length). "
+               "Required when TC is int8.",
+               "T", OpSchema::Optional)
+        .Input(7, "past_value_scale",
+               "Per row scales of an int8 value cache with shape (batch_size, num_heads, max_sequence_length). "
+               "Required when TC is int8.",
+               "T", OpSchema::Optional)
+        .Output(0, "output", "Output with shape (batch_size, sequence_length, num_heads, v_head_size)", "T")
+        .Output(1, "present_key", "Updated key cache. Must share the buffer of past_key.", "TC")
+        .Output(2, "present_value", "Updated value cache. Must share the buffer of past_value.", "TC")
+        .Output(3, "present_key_scale", "Updated key cache scales. Must share the buffer of past_key_scale.", "T",
+                OpSchema::Optional)
+        .Output(4, "present_value_scale", "Updated value cache scales. Must share the buffer of past_value_scale.", "T",
+                OpSchema::Optional)
+        .TypeConstraint(
+            "T",
+            {"tensor(float)"},
+            "Constrain input and output types to float tensors.")
+        .TypeConstraint(
+            "TC",
+            {"tensor(float)", "tensor(int8)"},
+            "Constrain the key/value cache to float or int8 tensors.")
+        .TypeConstraint(
+            "M",
+            {"tensor(int32)"},
+            "Constrain past sequence length to int32 tensor.")
+        .TypeAndShapeInferenceFunction([](InferenceContext& ctx) {
+          propagateElemTypeFromInputToOutput(ctx, 0, 0);
+          propagateElemTypeFromInputToOutput(ctx, 3, 1);
+          propagateElemTypeFromInputToOutput(ctx, 4, 2);
+          if (hasInputShape(ctx, 3)) {
+            propagateShapeFromInputToOutput(ctx, 3, 1);
+          }
+          if (hasInputShape(ctx, 4)) {
+            propagateShapeFromInputToOutput(ctx, 4, 2);
+          }
+          for (size_t i = 6; i <= 7 && i < ctx.getNumInputs() && i - 3 < ctx.getNumOutputs(); ++i) {
+            if (ctx.getInputType(i) == nullptr) {
+              continue;
+            }
+            propagateElemTypeFromInputToOutput(ctx, i, i - 3);
+            if (hasInputShape(ctx, i)) {
+              propagateShapeFromInputToOutput(ctx, i, i - 3);
+            }
+          }
+          if (!hasInputShape(ctx, 0) || !hasInputShape(ctx, 2)) {
+            return;
+          }
+          const auto& query_shape = getInputShape(ctx, 0);
+          const auto& value_shape = getInputShape(ctx, 2);
+          if (query_shape.dim_size() != 4 || value_shape.dim_size() != 4) {
+            fail_shape_inference("query and value are expected to be 4D");
+          }
+          TensorShapeProto output_shape;
+          *output_shape.add_dim() = query_shape.dim(0);
+          *output_shape.add_dim() = query_shape.dim(2);
+          *output_shape.add_dim() = query_shape.dim(1);
+          *output_shape.add_dim() = value_shape.dim(3);
+          updateOutputShape(ctx, 0, output_shape);
+        }));
+
 }  // namespace ONNX_NAMESPACE
 
 namespace onnxruntime {
@@ -44,6 +250,22 @@ void RegisterMyVirtualNpuSchemas() {
   auto schema = ONNX_NAMESPACE::GetOpSchema<ONNX_NAMESPACE::ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(MyVirtualNpu, 1, FastGelu)>();
   ONNX_NAMESPACE::RegisterSchema(schema);
 
+  // Register SkipLayerNormalization schema
+  ONNX_NAMESPACE::RegisterSchema(
+      ONNX_NAMESPACE::GetOpSchema<ONNX_NAMESPACE::ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(MyVirtualNpu, 1, SkipLayerNormalization)>());
+
+  // Register BiasGelu schema
+  ONNX_NAMESPACE::RegisterSchema(
+      ONNX_NAMESPACE::GetOpSchema<ONNX_NAMESPACE::ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(MyVirtualNpu, 1, BiasGelu)>());
+
+  // Register Attention schema
+  ONNX_NAMESPACE::RegisterSchema(
+      ONNX_NAMESPACE::GetOpSchema<ONNX_NAMESPACE::ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(MyVirtualNpu, 1, Attention)>());
+
+  // Register DecoderMaskedAttention schema
+  ONNX_NAMESPACE::RegisterSchema(
+      ONNX_NAMESPACE::GetOpSchema<ONNX_NAMESPACE::ONNX_OPERATOR_SET_SCHEMA_CLASS_NAME(MyVirtualNpu, 1, DecoderMaskedAttention)>());
+
   schemas_registered = true;
 }
 
@@ -22,6 +22,8 @@ Abstract:
 #include <cstdint>
 #include <stdexcept>
 
+#include "mlas_gemm_postprocessor.h"
+
 //
 // Define the calling convention for Windows targets.
 //
@@ -168,6 +170,10 @@ enum MLAS_ACTIVATION_KIND {
     MlasLogisticActivation,
     MlasClipActivation,
     MlasHardSigmoidActivation,
+    MlasGeluErfActivation,
+    MlasGeluTanhActivation,
+    MlasSiluActivation,
+    MlasQuickGeluActivation,
     MlasActivationKindCount,
 };
 
@@ -185,6 +191,9 @@ struct MLAS_ACTIVATION {
             float alpha;
             float beta;
         } HardSigmoid;
+        struct {
+            float alpha;
+        } QuickGelu;
         float Values[2];
     } Parameters;
 };
@@ -200,6 +209,22 @@ MlasActivation(
     size_t ldc
     );
 
+/**
+ * @brief Single precision activation functions applied to each tile of a GEMM
+ * output as it is produced, while the tile is still resident in the cache.
+ */
+class MLAS_GEMM_ACTIVATION_PROCESSOR : public MLAS_GEMM_POSTPROCESSOR<float>
+{
+   public:
+    MLAS_GEMM_ACTIVATION_PROCESSOR(const MLAS_ACTIVATION& Activation) : Activation_(Activation) {}
+
+    void Process(float* C, size_t StartM, size_t StartN, size_t CountM, size_t CountN, size_t ldc)
+        const override;
+
+   private:
+    const MLAS_ACTIVATION Activation_;
+};
+
 //
 // Matrix/matrix multiply routines.
 // C := alpha * op(A) * op(B) + beta * C
@@ -219,6 +244,7 @@ struct MLAS_SGEMM_DATA_PARAMS {
     float alpha = 1.0f;       /**< Supplies the scalar alpha multiplier (see SGEMM definition) */
     float beta = 0.0f;        /**< Supplies the scalar beta multiplier (see SGEMM definition) */
     bool BIsPacked = false;   /**< Whether B is pre-packed */
+    const MLAS_GEMM_POSTPROCESSOR<float>* OutputProcessor = nullptr; /**< Optional processor for each output tile */
 };
 
 /**
@@ -1558,6 +1584,42 @@ MlasRotaryEmbedOneRow(
     T* output
 );
 
+/**
+ * @brief Layer normalization of one row, optionally preceded by the addition of a skip row and a bias as in
+ *        SkipLayerNormalization. Computes RMS normalization if Simplified is true.
+ *
+ * @tparam T: data type of the input and outputs. Currently only float32/16 are supported.
+ * @param Input:       input row, of shape [N]
+ * @param Skip:        optional skip row added to the input, of shape [N]
+ * @param Bias:        optional bias added to the input, of shape [N]
+ * @param Gamma:       scale, of shape [N]
+ * @param Beta:        optional shift, of shape [N]. Ignored if Simplified is true.
+ * @param Output:      output row, of shape [N]. Could be the same as the input row.
+ * @param SkipOutput:  optional output of Input + Skip + Bias, of shape [N]
+ * @param N:           number of elements in the row
+ * @param Epsilon:     value added to the variance to avoid dividing by zero
+ * @param Simplified:  whether to compute RMS normalization, which does not subtract the mean
+ * @param Mean:        optional output of the mean of the row. Ignored if Simplified is true.
+ * @param InvStdDev:   optional output of the reciprocal of the standard deviation (root mean square) of the row
+ */
+template <typename T>
+void
+MLASCALL
+MlasLayerNormalization(
+    const T* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    T* Output,
+    T* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+);
+
 /**
  * @brief Supply matrices data information to half precision gemm functions
  */
@@ -1675,6 +1737,14 @@ MlasGemm(
 bool MLASCALL
 MlasFp16AccelerationSupported();
 
+/**
+ * @brief Whether MlasHalfGemmBatch has an accelerated kernel on the current
+ *        CPU, i.e. fp16 NEON on ARM64, or AVX2 with F16C on x64. Otherwise
+ *        MlasHalfGemmBatch falls back to a slow reference implementation.
+*/
+bool MLASCALL
+MlasHalfGemmSupported();
+
 /**
  * @brief Interface for half gemm post processors.
  *
@@ -2091,6 +2161,20 @@ struct MlasFlashAttentionThreadedArgs {
     const float* key;
     const float* value;
     float* output;
+    // When set, query row i attends only to keys j <= i + (kv_sequence_length - q_sequence_length),
+    // i.e. a causal mask aligned to the end of the key sequence. Requires kv_sequence_length >= q_sequence_length.
+    bool is_causal = false;
+    // Sequence positions allocated per (batch, head) in key and value. 0 means kv_sequence_length. A larger value
+    // lets the kernel attend over the valid prefix of a preallocated max-length KV cache without compacting it.
+    int kv_buffer_sequence_length = 0;
+    // Optional int8 KV cache. When key_quant and value_quant are set, key and value are ignored and the row of
+    // (batch, head, position) is key_quant[row] * key_scale[(batch * num_heads + head) * kv_buffer_sequence_length
+    // + position], likewise for value. Each kv block is dequantized into the thread buffer right before it is
+    // multiplied, so buffer_size_per_thread must hold kv_block_size * (qk_head_size + v_head_size) more floats.
+    const int8_t* key_quant = nullptr;
+    const int8_t* value_quant = nullptr;
+    const float* key_scale = nullptr;
+    const float* value_scale = nullptr;
 };
 
 /**
@@ -406,6 +406,301 @@ Return Value:
     }
 }
 
+//
+// Templates for activation functions computed as the product of the input and
+// a gate that is evaluated by one of the elementwise routines. The gate input
+// is staged in a block that stays resident in the L1 cache, so each element of
+// the output matrix is read and written once.
+//
+
+template<MLAS_ACTIVATION_KIND ActivationKind>
+struct MLAS_GATED_ACTIVATION_FUNCTION;
+
+template<>
+struct MLAS_GATED_ACTIVATION_FUNCTION<MlasGeluErfActivation>
+{
+    //
+    // 0.5 * x * (1 + erf(x / sqrt(2)))
+    //
+
+    const MLAS_FLOAT32X4 ScaleBroadcast = MlasBroadcastFloat32x4(0.7071067811865475f);
+    const MLAS_FLOAT32X4 HalfBroadcast = MlasBroadcastFloat32x4(0.5f);
+
+    MLAS_GATED_ACTIVATION_FUNCTION(const MLAS_ACTIVATION* Activation)
+    {
+        MLAS_UNREFERENCED_PARAMETER(Activation);
+    }
+
+    MLAS_FLOAT32X4 GateInput(MLAS_FLOAT32X4 Value)
+    {
+        return MlasMultiplyFloat32x4(Value, ScaleBroadcast);
+    }
+
+    float GateInput(float Value)
+    {
+        return Value * MlasExtractLaneFloat32x4<0>(ScaleBroadcast);
+    }
+
+    void ComputeGate(float* Gate, size_t N)
+    {
+        MlasComputeErf(Gate, Gate, N);
+    }
+
+    MLAS_FLOAT32X4 Combine(MLAS_FLOAT32X4 Value, MLAS_FLOAT32X4 Gate)
+    {
+        MLAS_FLOAT32X4 HalfValue = MlasMultiplyFloat32x4(Value, HalfBroadcast);
+
+        return MlasMultiplyAddFloat32x4(HalfValue, Gate, HalfValue);
+    }
+
+    float Combine(float Value, float Gate)
+    {
+        return 0.5f * Value * (1.0f + Gate);
+    }
+};
+
+template<>
+struct MLAS_GATED_ACTIVATION_FUNCTION<MlasGeluTanhActivation>
+{
+    //
+    // 0.5 * x * (1 + tanh(sqrt(2 / pi) * (x + 0.044715 * x^3)))
+    //
+
+    const MLAS_FLOAT32X4 C0Broadcast = MlasBroadcastFloat32x4(0.7978845608028654f);
+    const MLAS_FLOAT32X4 C1Broadcast = MlasBroadcastFloat32x4(0.7978845608028654f * 0.044715f);
+    const MLAS_FLOAT32X4 HalfBroadcast = MlasBroadcastFloat32x4(0.5f);
+
+    MLAS_GATED_ACTIVATION_FUNCTION(const MLAS_ACTIVATION* Activation)
+    {
+        MLAS_UNREFERENCED_PARAMETER(Activation);
+    }
+
+    MLAS_FLOAT32X4 GateInput(MLAS_FLOAT32X4 Value)
+    {
+        MLAS_FLOAT32X4 ValueSquared = MlasMultiplyFloat32x4(Value, Value);
+
+        return MlasMultiplyFloat32x4(Value, MlasMultiplyAddFloat32x4(ValueSquared, C1Broadcast, C0Broadcast));
+    }
+
+    float GateInput(float Value)
+    {
+        return Value * (MlasExtractLaneFloat32x4<0>(C1Broadcast) * Value * Value +
+                        MlasExtractLaneFloat32x4<0>(C0Broadcast));
+    }
+
+    void ComputeGate(float* Gate, size_t N)
+    {
+        MlasComputeTanh(Gate, Gate, N);
+    }
+
+    MLAS_FLOAT32X4 Combine(MLAS_FLOAT32X4 Value, MLAS_FLOAT32X4 Gate)
+    {
+        MLAS_FLOAT32X4 HalfValue = MlasMultiplyFloat32x4(Value, HalfBroadcast);
+
+        return MlasMultiplyAddFloat32x4(HalfValue, Gate, HalfValue);
+    }
+
+    float Combine(float Value, float Gate)
+    {
+        return 0.5f * Value * (1.0f + Gate);
+    }
+};
+
+template<>
+struct MLAS_GATED_ACTIVATION_FUNCTION<MlasQuickGeluActivation>
+{
+    //
+    // x * sigmoid(alpha * x)
+    //
+
+    const MLAS_FLOAT32X4 AlphaBroadcast;
+
+    MLAS_GATED_ACTIVATION_FUNCTION(const MLAS_ACTIVATION* Activation)
+        : AlphaBroadcast(MlasBroadcastFloat32x4(&Activation->Parameters.QuickGelu.alpha))
+    {
+    }
+
+    MLAS_FLOAT32X4 GateInput(MLAS_FLOAT32X4 Value)
+    {
+        return MlasMultiplyFloat32x4(Value, AlphaBroadcast);
+    }
+
+    float GateInput(float Value)
+    {
+        return Value * MlasExtractLaneFloat32x4<0>(AlphaBroadcast);
+    }
+
+    void ComputeGate(float* Gate, size_t N)
+    {
+        MlasComputeLogistic(Gate, Gate, N);
+    }
+
+    MLAS_FLOAT32X4 Combine(MLAS_FLOAT32X4 Value, MLAS_FLOAT32X4 Gate)
+    {
+        return MlasMultiplyFloat32x4(Value, Gate);
+    }
+
+    float Combine(float Value, float Gate)
+    {
+        return Value * Gate;
+    }
+};
+
+template<>
+struct MLAS_GATED_ACTIVATION_FUNCTION<MlasSiluActivation>
+{
+    //
+    // x * sigmoid(x)
+    //
+
+    MLAS_GATED_ACTIVATION_FUNCTION(const MLAS_ACTIVATION* Activation)
+    {
+        MLAS_UNREFERENCED_PARAMETER(Activation);
+    }
+
+    MLAS_FLOAT32X4 GateInput(MLAS_FLOAT32X4 Value)
+    {
+        return Value;
+    }
+
+    float GateInput(float Value)
+    {
+        return Value;
+    }
+
+    void ComputeGate(float* Gate, size_t N)
+    {
+        MlasComputeLogistic(Gate, Gate, N);
+    }
+
+    MLAS_FLOAT32X4 Combine(MLAS_FLOAT32X4 Value, MLAS_FLOAT32X4 Gate)
+    {
+        return MlasMultiplyFloat32x4(Value, Gate);
+    }
+
+    float Combine(float Value, float Gate)
+    {
+        return Value * Gate;
+    }
+};
+
+template<MLAS_ACTIVATION_KIND ActivationKind, bool AddBias>
+void
+MlasGatedActivationKernel(
+    const MLAS_ACTIVATION* Activation,
+    float* Buffer,
+    const float* Bias,
+    size_t M,
+    size_t N,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine steps over the output matrix in blocks and invokes the
+    templated bias addition and gated activation functions.
+
+Arguments:
+
+    Activation - Supplies the parameters for the activation.
+
+    Buffer - Supplies the output matrix.
+
+    Bias - Supplies the optional bias vector.
+
+    M - Supplies the number of elements of the bias vector and the number of
+        rows in the output matrix.
+
+    N - Supplies the number of columns of the output matrix.
+
+    ldc - Supplies the number of elements per row of the output matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t BlockSize = 256;
+
+    MLAS_GATED_ACTIVATION_FUNCTION<ActivationKind> ActivationFunction(Activation);
+    MLAS_BIAS_ADDITION<AddBias> BiasAddition;
+
+    MLAS_DECLSPEC_ALIGN(float Gate[BlockSize], 64);
+
+    //
+    // Step through each row of the output matrix.
+    //
+
+    while (M-- > 0) {
+
+        BiasAddition.LoadNext(Bias);
+
+        for (size_t n = 0; n < N; n += BlockSize) {
+
+            float* buffer = Buffer + n;
+            const size_t CountN = std::min(N - n, BlockSize);
+            size_t i = 0;
+
+            //
+            // Add the bias and compute the gate input for the block.
+            //
+
+            for (; i + 4 <= CountN; i += 4) {
+
+                MLAS_FLOAT32X4 Vector = BiasAddition.Add(MlasLoadFloat32x4(buffer + i));
+                MlasStoreFloat32x4(buffer + i, Vector);
+                MlasStoreFloat32x4(Gate + i, ActivationFunction.GateInput(Vector));
+            }
+
+            for (; i < CountN; i++) {
+
+                float Scalar = BiasAddition.Add(buffer[i]);
+                buffer[i] = Scalar;
+                Gate[i] = ActivationFunction.GateInput(Scalar);
+            }
+
+            ActivationFunction.ComputeGate(Gate, CountN);
+
+            //
+            // Combine the block with its gate.
+            //
+
+            for (i = 0; i + 4 <= CountN; i += 4) {
+
+                MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(buffer + i);
+                MlasStoreFloat32x4(buffer + i, ActivationFunction.Combine(Vector, MlasLoadFloat32x4(Gate + i)));
+            }
+
+            for (; i < CountN; i++) {
+                buffer[i] = ActivationFunction.Combine(buffer[i], Gate[i]);
+            }
+        }
+
+        Buffer += ldc;
+    }
+}
+
+template<MLAS_ACTIVATION_KIND ActivationKind>
+inline
+void
+MlasGatedActivationKernel(
+    const MLAS_ACTIVATION* Activation,
+    float* Buffer,
+    const float* Bias,
+    size_t M,
+    size_t N,
+    size_t ldc
+    )
+{
+    if (Bias != nullptr) {
+        MlasGatedActivationKernel<ActivationKind, true>(Activation, Buffer, Bias, M, N, ldc);
+    } else {
+        MlasGatedActivationKernel<ActivationKind, false>(Activation, Buffer, Bias, M, N, ldc);
+    }
+}
+
 void
 MLASCALL
 MlasActivation(
@@ -512,6 +807,30 @@ Return Value:
             break;
         }
 
+        case MlasGeluErfActivation:
+        {
+            MlasGatedActivationKernel<MlasGeluErfActivation>(Activation, Buffer, Bias, M, N, ldc);
+            break;
+        }
+
+        case MlasGeluTanhActivation:
+        {
+            MlasGatedActivationKernel<MlasGeluTanhActivation>(Activation, Buffer, Bias, M, N, ldc);
+            break;
+        }
+
+        case MlasSiluActivation:
+        {
+            MlasGatedActivationKernel<MlasSiluActivation>(Activation, Buffer, Bias, M, N, ldc);
+            break;
+        }
+
+        case MlasQuickGeluActivation:
+        {
+            MlasGatedActivationKernel<MlasQuickGeluActivation>(Activation, Buffer, Bias, M, N, ldc);
+            break;
+        }
+
         case MlasActivationKindCount:
         {
             MLAS_THROW_EX(std::runtime_error, "bad mlas activation kind");
@@ -519,3 +838,16 @@ Return Value:
         }
     }
 }
+
+void
+MLAS_GEMM_ACTIVATION_PROCESSOR::Process(
+    float* C,
+    size_t StartM,
+    size_t StartN,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc
+    ) const
+{
+    MlasActivation(&Activation_, C + StartM * ldc + StartN, nullptr, CountM, CountN, ldc);
+}
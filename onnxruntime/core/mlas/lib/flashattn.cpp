@@ -1,7 +1,27 @@
+#include <algorithm>
 #include <numeric>
 
 #include "mlasi.h"
 
+namespace {
+
+// Dequantizes `rows` int8 rows of `row_size` values, each with its own scale.
+void
+DequantizeKvBlock(
+    const int8_t* src,
+    const float* scale,
+    float* dst,
+    size_t rows,
+    size_t row_size
+)
+{
+    for (size_t r = 0; r < rows; ++r) {
+        MlasDequantizeLinear<int8_t>(src + r * row_size, dst + r * row_size, row_size, scale[r], 0);
+    }
+}
+
+}  // namespace
+
 void
 MlasFlashAttentionThreaded(
     void* argptr,
@@ -23,7 +43,16 @@ MlasFlashAttentionThreaded(
     const float* query = args->query;
     const float* key = args->key;
     const float* value = args->value;
+    const int8_t* key_quant = args->key_quant;
+    const int8_t* value_quant = args->value_quant;
+    const bool is_kv_quantized = key_quant != nullptr && value_quant != nullptr;
     float* output = args->output;
+    const bool is_causal = args->is_causal;
+    // Key j is visible to query row i iff j <= i + causal_offset.
+    const ptrdiff_t causal_offset = kv_sequence_length - q_sequence_length;
+    // Rows allocated per (batch, head) in key/value; only the first kv_sequence_length are read.
+    const ptrdiff_t kv_buffer_sequence_length =
+        args->kv_buffer_sequence_length > 0 ? static_cast<ptrdiff_t>(args->kv_buffer_sequence_length) : kv_sequence_length;
 
 #if defined(MLAS_TARGET_AMD64) || defined(MLAS_TARGET_LARCH64)
     auto&& mlas_platform = GetMlasPlatform();
@@ -59,9 +88,18 @@ MlasFlashAttentionThreaded(
         }
         float* intermediate = m + q_block_size;
         float* temp_output = intermediate + q_block_size * kv_block_size;
+        // Dequantized K/V tiles of the current kv block, only used with an int8 KV cache.
+        float* key_tile = temp_output + q_block_size * v_head_size;
+        float* value_tile = key_tile + kv_block_size * qk_head_size;
         float negmax = 0;
+        ptrdiff_t row_size_q_valid = std::min(q_block_size, q_sequence_length - q_idx);
 
         for (ptrdiff_t ir = 0; ir < kv_sequence_length; ir += kv_block_size) {
+            if (is_causal && ir > q_idx + row_size_q_valid - 1 + causal_offset) {
+                // This and all following key blocks are masked for every row of the query block.
+                break;
+            }
+
             /*
                 S = Q[batch_idx, head_idx, q_idx:q_idx+q_block_size, :] * (K[batch_idx, head_idx, ir:ir+kv_block_size, :]).T
                 old_m = m
@@ -73,12 +111,25 @@ MlasFlashAttentionThreaded(
             */
             ptrdiff_t h = batch_idx * num_heads + head_idx;
             const float* inputQ = query + (h * q_sequence_length + q_idx) * qk_head_size;
-            const float* inputK = key + (h * kv_sequence_length + ir) * qk_head_size;
-            const float* inputV = value + (h * kv_sequence_length + ir) * v_head_size;
+            const float* inputK;
+            const float* inputV;
 
             size_t row_size_q_capped = static_cast<size_t>(std::min(q_block_size, q_sequence_length - q_idx));
             size_t row_size_kv_capped = static_cast<size_t>(std::min(kv_block_size, kv_sequence_length - ir));
 
+            if (is_kv_quantized) {
+                const ptrdiff_t kv_row = h * kv_buffer_sequence_length + ir;
+                DequantizeKvBlock(key_quant + kv_row * qk_head_size, args->key_scale + kv_row, key_tile,
+                                  row_size_kv_capped, static_cast<size_t>(qk_head_size));
+                DequantizeKvBlock(value_quant + kv_row * v_head_size, args->value_scale + kv_row, value_tile,
+                                  row_size_kv_capped, static_cast<size_t>(v_head_size));
+                inputK = key_tile;
+                inputV = value_tile;
+            } else {
+                inputK = key + (h * kv_buffer_sequence_length + ir) * qk_head_size;
+                inputV = value + (h * kv_buffer_sequence_length + ir) * v_head_size;
+            }
+
             MlasSgemmOperation(CBLAS_TRANSPOSE::CblasNoTrans,
                      CBLAS_TRANSPOSE::CblasTrans,
                      row_size_q_capped,
@@ -93,6 +144,16 @@ MlasFlashAttentionThreaded(
                      intermediate,
                      row_size_kv_capped);
 
+            if (is_causal) {
+                for (ptrdiff_t irow = 0; irow < static_cast<ptrdiff_t>(row_size_q_capped); ++irow) {
+                    ptrdiff_t visible = std::max<ptrdiff_t>(q_idx + irow + causal_offset - ir + 1, 0);
+                    if (visible < static_cast<ptrdiff_t>(row_size_kv_capped)) {
+                        float* p = intermediate + irow * row_size_kv_capped;
+                        std::fill(p + visible, p + row_size_kv_capped, std::numeric_limits<float>::lowest());
+                    }
+                }
+            }
+
             for (ptrdiff_t irow = 0; irow < static_cast<ptrdiff_t>(row_size_q_capped); ++irow) {
                 float* p = intermediate + irow * row_size_kv_capped;
 
@@ -141,7 +202,6 @@ MlasFlashAttentionThreaded(
         }
 
         float* output_row = output + ((batch_idx * q_sequence_length + q_idx) * num_heads + head_idx) * v_head_size;
-        ptrdiff_t row_size_q_valid = std::min(q_block_size, q_sequence_length - q_idx);
         // TODO: leverage advanced instruction sets
         for (ptrdiff_t irow = 0; irow < row_size_q_valid; ++irow) {
             for (ptrdiff_t icol = 0; icol < v_head_size; ++icol) {
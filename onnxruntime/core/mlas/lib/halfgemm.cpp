@@ -32,6 +32,18 @@ MlasFp16AccelerationSupported()
 #endif
 }
 
+bool MLASCALL
+MlasHalfGemmSupported()
+{
+#if defined(MLAS_F16VEC_INTRINSICS_SUPPORTED) && defined(MLAS_TARGET_ARM64)
+    return MlasFp16AccelerationSupported();
+#elif defined(MLAS_TARGET_AMD64)
+    return GetMlasPlatform().HalfGemmDispatch != nullptr;
+#else
+    return false;
+#endif
+}
+
 
 void
 MLASCALL
@@ -75,7 +87,12 @@ MlasHalfGemmBatch(
         ThreadsPerGemm = 1;
     }
 
-    const size_t StrideM = dispatch->StrideM;
+    //
+    // A skinny M stays in one range and is partitioned along N only, so that
+    // the threads stream disjoint columns of B once.
+    //
+
+    const size_t StrideM = (M <= MLAS_GEMM_SKINNY_M) ? std::max(M, dispatch->StrideM) : dispatch->StrideM;
 
     size_t nc = N;
     if ((size_t)MlasGetMaximumThreadCount(ThreadPool) > BatchN) {
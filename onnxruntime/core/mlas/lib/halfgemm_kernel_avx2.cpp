@@ -0,0 +1,587 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements half precision GEMM kernel for AVX2 with F16C.
+
+    Matrices stay in half precision in memory and packing buffers. The
+    kernel widens them to single precision with F16C while loading, and
+    accumulates in single precision with FMA.
+
+    B is copied into a compact row major panel of Strides.K rows by
+    Strides.N columns, so the panel stays in cache while the kernel steps
+    through the rows of A.
+
+    A skinny A of at most MLAS_GEMM_SKINNY_M rows uses each element of B
+    only a few times, so B is streamed directly instead, a few full rows at
+    a time, and the product is accumulated in single precision.
+
+--*/
+
+#include "mlasi.h"
+#include "halfgemm.h"
+
+struct MLAS_HALF_GEMM_KERNEL_AVX2 {
+    static constexpr bool PackNeeded = true;
+    static constexpr size_t KernelMaxM = 6;  // max # rows the vectorized kernel can process
+    static constexpr size_t PackedK = 1;
+
+    static constexpr MLAS_HALF_GEMM_STRIDES Strides{24, 128, 512};
+};
+
+namespace {
+
+//
+// Number of rows of A held in registers, number of rows of B consumed by one
+// step, and number of columns computed for all rows of A before moving on,
+// for the skinny kernel.
+//
+
+constexpr size_t SkinnyRowCount = 4;
+constexpr size_t SkinnyStrideK = 16;
+constexpr size_t SkinnyStrideN = 64;
+
+template <typename IterationFn, size_t... Indices>
+MLAS_FORCEINLINE void
+UnrolledLoopIterations(IterationFn&& f, std::index_sequence<Indices...> /* indices */)
+{
+    (f(Indices), ...);
+}
+
+template <size_t N, typename IterationFn>
+MLAS_FORCEINLINE void
+UnrolledLoop(IterationFn&& f)
+{
+    UnrolledLoopIterations(std::forward<IterationFn>(f), std::make_index_sequence<N>());
+}
+
+MLAS_FORCEINLINE
+__m256
+LoadHalf8(const _mlas_fp16_* src)
+{
+    return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+}
+
+MLAS_FORCEINLINE
+__m256
+LoadHalfPartial(const _mlas_fp16_* src, size_t len)
+{
+    _mlas_fp16_ buf[8] = {};
+    std::memcpy(buf, src, len * sizeof(_mlas_fp16_));
+    return LoadHalf8(buf);
+}
+
+MLAS_FORCEINLINE
+void
+StoreHalf(_mlas_fp16_* dest, __m256 value, size_t len)
+{
+    const __m128i half = _mm256_cvtps_ph(value, _MM_FROUND_TO_NEAREST_INT);
+    if (len == 8) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), half);
+    } else {
+        _mlas_fp16_ buf[8];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(buf), half);
+        std::memcpy(dest, buf, len * sizeof(_mlas_fp16_));
+    }
+}
+
+/**
+ * @brief Add the bias or the existing output, and store 8 or fewer columns
+ *        of one output row.
+ */
+MLAS_FORCEINLINE
+void
+StoreOutput(
+    __m256 Accumulator,
+    _mlas_fp16_* C,
+    const _mlas_fp16_* Bias,
+    size_t len,
+    bool ZeroMode
+)
+{
+    if (Bias != nullptr) {
+        Accumulator = _mm256_add_ps(Accumulator, len == 8 ? LoadHalf8(Bias) : LoadHalfPartial(Bias, len));
+    }
+    if (!ZeroMode) {
+        Accumulator = _mm256_add_ps(Accumulator, len == 8 ? LoadHalf8(C) : LoadHalfPartial(C, len));
+    }
+    StoreHalf(C, Accumulator, len);
+}
+
+MLAS_FORCEINLINE
+void
+CvtFloat2Half(
+    _mlas_fp16_* dest,
+    const float* src,
+    size_t len
+)
+{
+    while (len >= 8) {
+        const __m128i half = _mm256_cvtps_ph(_mm256_loadu_ps(src), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), half);
+        src += 8;
+        dest += 8;
+        len -= 8;
+    }
+
+    while (len > 0) {
+        *dest++ = MLAS_Float2Half(*src++);
+        len--;
+    }
+}
+
+/**
+ * @brief Convert a 2D matrix from float to fp16
+*/
+MLAS_FORCEINLINE
+void
+CvtFloat2Half2D(
+    _mlas_fp16_* dest,
+    const float* src,
+    size_t stride,
+    size_t CntRow,
+    size_t CntCol
+    )
+{
+    if (stride == CntCol) {
+        const size_t len = CntRow * CntCol;
+        CvtFloat2Half(dest, src, len);
+        return;
+    }
+    while (CntRow > 0) {
+        CvtFloat2Half(dest, src, CntCol);
+        src += stride;
+        dest += CntCol;
+        CntRow--;
+    }
+}
+
+/**
+ * @brief Widen CntRow x CntCol fp16 values to a dense fp32 buffer
+*/
+MLAS_FORCEINLINE
+void
+CvtHalf2Float2D(
+    float* dest,
+    const _mlas_fp16_* src,
+    size_t stride,
+    size_t CntRow,
+    size_t CntCol
+    )
+{
+    for (size_t r = 0; r < CntRow; r++) {
+        size_t c = 0;
+        for (; c + 8 <= CntCol; c += 8) {
+            _mm256_storeu_ps(dest + c, LoadHalf8(src + c));
+        }
+        for (; c < CntCol; c++) {
+            dest[c] = MLAS_Half2Float(src[c]);
+        }
+        src += stride;
+        dest += CntCol;
+    }
+}
+
+/**
+ * @brief Compute RowCount rows of C, 16 columns at a time, then 8 columns
+ *        at a time with a partial last block.
+ */
+template <size_t RowCount>
+void
+HalfGemmKernelAvx2(
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const float* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    bool ZeroMode
+)
+{
+    size_t n = 0;
+
+    for (; n + 16 <= CountN; n += 16) {
+        __m256 Accumulators[RowCount][2];
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulators[r][0] = _mm256_setzero_ps();
+            Accumulators[r][1] = _mm256_setzero_ps();
+        }
+
+        const _mlas_fp16_* b = B + n;
+        for (size_t k = 0; k < CountK; k++) {
+            const __m256 B0 = LoadHalf8(b);
+            const __m256 B1 = LoadHalf8(b + 8);
+            for (size_t r = 0; r < RowCount; r++) {
+                const __m256 ABroadcast = _mm256_broadcast_ss(A + r * lda + k);
+                Accumulators[r][0] = _mm256_fmadd_ps(ABroadcast, B0, Accumulators[r][0]);
+                Accumulators[r][1] = _mm256_fmadd_ps(ABroadcast, B1, Accumulators[r][1]);
+            }
+            b += ldb;
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            _mlas_fp16_* c = C + r * ldc + n;
+            StoreOutput(Accumulators[r][0], c, Bias == nullptr ? nullptr : Bias + n, 8, ZeroMode);
+            StoreOutput(Accumulators[r][1], c + 8, Bias == nullptr ? nullptr : Bias + n + 8, 8, ZeroMode);
+        }
+    }
+
+    for (; n < CountN; n += 8) {
+        const size_t len = std::min(CountN - n, size_t{8});
+
+        __m256 Accumulators[RowCount];
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulators[r] = _mm256_setzero_ps();
+        }
+
+        const _mlas_fp16_* b = B + n;
+        for (size_t k = 0; k < CountK; k++) {
+            const __m256 B0 = (len == 8) ? LoadHalf8(b) : LoadHalfPartial(b, len);
+            for (size_t r = 0; r < RowCount; r++) {
+                Accumulators[r] = _mm256_fmadd_ps(_mm256_broadcast_ss(A + r * lda + k), B0, Accumulators[r]);
+            }
+            b += ldb;
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            StoreOutput(Accumulators[r], C + r * ldc + n, Bias == nullptr ? nullptr : Bias + n, len, ZeroMode);
+        }
+    }
+}
+
+/**
+ * @brief Multiply RowCount rows of A by CountK rows of B and add the product
+ *        to the single precision accumulators, 16 columns at a time.
+ */
+template <size_t RowCount>
+void
+HalfGemmSkinnyKernelAvx2(
+    size_t CountN,
+    size_t CountK,
+    float* Acc,
+    size_t ldacc,
+    const float* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    bool ZeroMode
+)
+{
+    size_t n = 0;
+
+    for (; n + 16 <= CountN; n += 16) {
+        __m256 Accumulators[RowCount][2];
+        UnrolledLoop<RowCount>([&](size_t r) {
+            Accumulators[r][0] = ZeroMode ? _mm256_setzero_ps() : _mm256_loadu_ps(Acc + r * ldacc + n);
+            Accumulators[r][1] = ZeroMode ? _mm256_setzero_ps() : _mm256_loadu_ps(Acc + r * ldacc + n + 8);
+        });
+
+        const _mlas_fp16_* b = B + n;
+        for (size_t k = 0; k < CountK; k++) {
+            const __m256 B0 = LoadHalf8(b);
+            const __m256 B1 = LoadHalf8(b + 8);
+            UnrolledLoop<RowCount>([&](size_t r) {
+                const __m256 ABroadcast = _mm256_broadcast_ss(A + r * lda + k);
+                Accumulators[r][0] = _mm256_fmadd_ps(ABroadcast, B0, Accumulators[r][0]);
+                Accumulators[r][1] = _mm256_fmadd_ps(ABroadcast, B1, Accumulators[r][1]);
+            });
+            b += ldb;
+        }
+
+        UnrolledLoop<RowCount>([&](size_t r) {
+            _mm256_storeu_ps(Acc + r * ldacc + n, Accumulators[r][0]);
+            _mm256_storeu_ps(Acc + r * ldacc + n + 8, Accumulators[r][1]);
+        });
+    }
+
+    for (; n < CountN; n += 8) {
+        const size_t len = std::min(CountN - n, size_t{8});
+        const __m256i Mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(int32_t(len)),
+                                                _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+
+        __m256 Accumulators[RowCount];
+        UnrolledLoop<RowCount>([&](size_t r) {
+            Accumulators[r] = ZeroMode ? _mm256_setzero_ps() : _mm256_maskload_ps(Acc + r * ldacc + n, Mask);
+        });
+
+        const _mlas_fp16_* b = B + n;
+        for (size_t k = 0; k < CountK; k++) {
+            const __m256 B0 = (len == 8) ? LoadHalf8(b) : LoadHalfPartial(b, len);
+            UnrolledLoop<RowCount>([&](size_t r) {
+                Accumulators[r] = _mm256_fmadd_ps(_mm256_broadcast_ss(A + r * lda + k), B0, Accumulators[r]);
+            });
+            b += ldb;
+        }
+
+        UnrolledLoop<RowCount>([&](size_t r) {
+            _mm256_maskstore_ps(Acc + r * ldacc + n, Mask, Accumulators[r]);
+        });
+    }
+}
+
+/**
+ * @brief Compute a range of C for a skinny A with fp16 B, prepacked or not.
+ *        Same contract as MlasHalfGemmOperation.
+ */
+void
+HalfGemmSkinnyOperationAvx2(
+    const size_t N,
+    const size_t K,
+    const MLAS_HALF_GEMM_DATA_PARAMS* Data,
+    const size_t RangeStartM,
+    const size_t RangeCountM,
+    const size_t RangeStartN,
+    const size_t RangeCountN
+)
+{
+    const size_t lda = Data->lda;
+    const size_t ldc = Data->ldc;
+
+    const _mlas_fp16_* B;
+    size_t ldb = Data->ldb;
+    if (ldb == 0) {
+        B = MlasHalfGemmPackedBOffset<MLAS_HALF_GEMM_KERNEL_AVX2>(
+            reinterpret_cast<const _mlas_fp16_*>(Data->B), N, K, RangeStartN, 0);
+        ldb = MlasHalfGemmPackedBLeadingDim<MLAS_HALF_GEMM_KERNEL_AVX2>(N, K);
+    } else {
+        B = reinterpret_cast<const _mlas_fp16_*>(Data->B) + RangeStartN;
+    }
+
+    //
+    // The rows of C are accumulated in single precision across the slices
+    // of K, and rounded to half precision once at the end.
+    //
+
+    MlasThreadedBufAlloc(RangeCountM * RangeCountN * sizeof(float));
+    float* Acc = reinterpret_cast<float*>(ThreadedBufHolder.get());
+
+    if (K == 0) {
+        std::fill_n(Acc, RangeCountM * RangeCountN, 0.0f);
+    }
+
+    float PanelA[MLAS_GEMM_SKINNY_M * SkinnyStrideK];
+
+    size_t CountK;
+    for (size_t k = 0; k < K; k += CountK) {
+        CountK = std::min(K - k, SkinnyStrideK);
+
+        if (Data->AIsfp32) {
+            const float* a = reinterpret_cast<const float*>(Data->A) + RangeStartM * lda + k;
+            for (size_t m = 0; m < RangeCountM; m++) {
+                std::copy_n(a + m * lda, CountK, PanelA + m * CountK);
+            }
+        } else {
+            CvtHalf2Float2D(PanelA, reinterpret_cast<const _mlas_fp16_*>(Data->A) + RangeStartM * lda + k, lda,
+                            RangeCountM, CountK);
+        }
+
+        const _mlas_fp16_* b = B + k * ldb;
+        const bool ZeroMode = (k == 0);
+
+        size_t CountN;
+        for (size_t n = 0; n < RangeCountN; n += CountN) {
+            CountN = std::min(RangeCountN - n, SkinnyStrideN);
+
+            size_t RowCount;
+            for (size_t m = 0; m < RangeCountM; m += RowCount) {
+                RowCount = std::min(RangeCountM - m, SkinnyRowCount);
+                float* acc = Acc + m * RangeCountN + n;
+                const float* a = PanelA + m * CountK;
+
+                switch (RowCount) {
+                    case 1:
+                        HalfGemmSkinnyKernelAvx2<1>(CountN, CountK, acc, RangeCountN, a, CountK, b + n, ldb, ZeroMode);
+                        break;
+                    case 2:
+                        HalfGemmSkinnyKernelAvx2<2>(CountN, CountK, acc, RangeCountN, a, CountK, b + n, ldb, ZeroMode);
+                        break;
+                    case 3:
+                        HalfGemmSkinnyKernelAvx2<3>(CountN, CountK, acc, RangeCountN, a, CountK, b + n, ldb, ZeroMode);
+                        break;
+                    default:
+                        HalfGemmSkinnyKernelAvx2<4>(CountN, CountK, acc, RangeCountN, a, CountK, b + n, ldb, ZeroMode);
+                        break;
+                }
+            }
+        }
+    }
+
+    //
+    // Add the bias and round the accumulators to the output.
+    //
+
+    const _mlas_fp16_* Bias = (Data->Bias == nullptr)
+        ? nullptr
+        : reinterpret_cast<const _mlas_fp16_*>(Data->Bias) + RangeStartN;
+    _mlas_fp16_* C = reinterpret_cast<_mlas_fp16_*>(Data->C) + RangeStartM * ldc + RangeStartN;
+
+    for (size_t m = 0; m < RangeCountM; m++) {
+        const float* acc = Acc + m * RangeCountN;
+        _mlas_fp16_* c = C + m * ldc;
+        for (size_t n = 0; n < RangeCountN; n += 8) {
+            const size_t len = std::min(RangeCountN - n, size_t{8});
+            float Values[8] = {};
+            std::copy_n(acc + n, len, Values);
+            __m256 Value = _mm256_loadu_ps(Values);
+            if (Bias != nullptr) {
+                Value = _mm256_add_ps(Value, len == 8 ? LoadHalf8(Bias + n) : LoadHalfPartial(Bias + n, len));
+            }
+            StoreHalf(c + n, Value, len);
+        }
+    }
+
+    if (Data->OutputProcessor != nullptr) {
+        Data->OutputProcessor->Process(Data->C, RangeStartM, RangeStartN, RangeCountM, RangeCountN, ldc);
+    }
+}
+
+}  // namespace
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmCopyPackB<MLAS_HALF_GEMM_KERNEL_AVX2>(
+    _mlas_fp16_* D,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK
+)
+{
+    for (size_t k = 0; k < CountK; k++) {
+        std::memcpy(D, B, CountN * sizeof(_mlas_fp16_));
+        B += ldb;
+        D += CountN;
+    }
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackA<MLAS_HALF_GEMM_KERNEL_AVX2>(
+    _mlas_fp16_* D,
+    const float* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK
+)
+{
+    CvtFloat2Half2D(D, A, lda, CountM, CountK);
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX2>(
+    _mlas_fp16_* D,
+    const float* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK
+)
+{
+    CvtFloat2Half2D(D, B, ldb, CountK, CountN);
+}
+
+template<>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernel<MLAS_HALF_GEMM_KERNEL_AVX2>(
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    _mlas_fp16_* C,
+    size_t ldc,
+    const _mlas_fp16_* Bias,
+    const _mlas_fp16_* A,
+    size_t lda,
+    const _mlas_fp16_* B,
+    size_t ldb,
+    const bool ZeroMode)
+{
+    constexpr size_t StrideK = MLAS_HALF_GEMM_KERNEL_AVX2::Strides.K;
+    MLAS_DECLSPEC_ALIGN(float PanelA[MLAS_HALF_GEMM_KERNEL_AVX2::KernelMaxM * StrideK], 64);
+
+    const size_t RowCount = std::min(CountM, MLAS_HALF_GEMM_KERNEL_AVX2::KernelMaxM);
+
+    //
+    // Widen the rows of A once so the inner loop broadcasts single precision
+    // values. The driver passes at most Strides.K columns; longer rows are
+    // accumulated into C one slice at a time.
+    //
+
+    size_t CountKSlice;
+    for (size_t k = 0; k < CountK; k += CountKSlice) {
+        CountKSlice = std::min(CountK - k, StrideK);
+        CvtHalf2Float2D(PanelA, A + k, lda, RowCount, CountKSlice);
+
+        const _mlas_fp16_* b = B + k * ldb;
+        const _mlas_fp16_* bias = (k == 0) ? Bias : nullptr;
+        const bool zero = ZeroMode && (k == 0);
+
+        switch (RowCount) {
+            case 1:
+                HalfGemmKernelAvx2<1>(CountN, CountKSlice, C, ldc, bias, PanelA, CountKSlice, b, ldb, zero);
+                break;
+            case 2:
+                HalfGemmKernelAvx2<2>(CountN, CountKSlice, C, ldc, bias, PanelA, CountKSlice, b, ldb, zero);
+                break;
+            case 3:
+                HalfGemmKernelAvx2<3>(CountN, CountKSlice, C, ldc, bias, PanelA, CountKSlice, b, ldb, zero);
+                break;
+            case 4:
+                HalfGemmKernelAvx2<4>(CountN, CountKSlice, C, ldc, bias, PanelA, CountKSlice, b, ldb, zero);
+                break;
+            case 5:
+                HalfGemmKernelAvx2<5>(CountN, CountKSlice, C, ldc, bias, PanelA, CountKSlice, b, ldb, zero);
+                break;
+            default:
+                HalfGemmKernelAvx2<6>(CountN, CountKSlice, C, ldc, bias, PanelA, CountKSlice, b, ldb, zero);
+                break;
+        }
+    }
+}
+
+void
+MlasHalfGemmOperationAvx2(
+    const size_t N,
+    const size_t K,
+    const MLAS_HALF_GEMM_DATA_PARAMS* Data,
+    const size_t RangeStartM,
+    const size_t RangeCountM,
+    const size_t RangeStartN,
+    const size_t RangeCountN
+    )
+{
+    //
+    // B in half precision, including a prepacked B, is streamed directly for
+    // a skinny A. Otherwise B is converted or copied to a packed panel.
+    //
+
+    if (RangeCountM <= MLAS_GEMM_SKINNY_M && (Data->ldb == 0 || !Data->BIsfp32)) {
+        HalfGemmSkinnyOperationAvx2(N, K, Data, RangeStartM, RangeCountM, RangeStartN, RangeCountN);
+        return;
+    }
+
+    MlasHalfGemmOperation<MLAS_HALF_GEMM_KERNEL_AVX2>(N, K, Data, RangeStartM, RangeCountM, RangeStartN, RangeCountN);
+}
+
+const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx2 = {
+    MlasHalfGemmOperationAvx2,
+    nullptr,
+    MlasHalfGemmConvertPackB<MLAS_HALF_GEMM_KERNEL_AVX2>,
+    MLAS_HALF_GEMM_KERNEL_AVX2::PackedK,
+    MLAS_HALF_GEMM_KERNEL_AVX2::KernelMaxM,
+    0
+};
@@ -0,0 +1,144 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm.cpp
+
+Abstract:
+
+    This module implements layer normalization and RMS normalization of one
+    row for fp32/16, optionally fused with the skip and bias addition.
+
+--*/
+
+#include "layernorm.h"
+
+void
+MLASCALL
+MlasLayerNormalization_FallBack(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    float* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+)
+{
+    float Sum = 0.0f;
+    float SumSquare = 0.0f;
+
+    for (size_t n = 0; n < N; n++) {
+        float Value = Input[n];
+        if (Skip != nullptr) {
+            Value += Skip[n];
+        }
+        if (Bias != nullptr) {
+            Value += Bias[n];
+        }
+        if (SkipOutput != nullptr) {
+            SkipOutput[n] = Value;
+        }
+        Output[n] = Value;
+        Sum += Value;
+        SumSquare += Value * Value;
+    }
+
+    float RowMean;
+    float RowInvStdDev;
+    MlasLayerNormStatistics(Sum, SumSquare, N, Epsilon, Simplified, Mean, InvStdDev, RowMean, RowInvStdDev);
+
+    if (Simplified) {
+        for (size_t n = 0; n < N; n++) {
+            Output[n] = Output[n] * RowInvStdDev * Gamma[n];
+        }
+    } else if (Beta == nullptr) {
+        for (size_t n = 0; n < N; n++) {
+            Output[n] = (Output[n] - RowMean) * RowInvStdDev * Gamma[n];
+        }
+    } else {
+        for (size_t n = 0; n < N; n++) {
+            Output[n] = (Output[n] - RowMean) * RowInvStdDev * Gamma[n] + Beta[n];
+        }
+    }
+}
+
+template <>
+void
+MLASCALL
+MlasLayerNormalization<float>(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    float* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+)
+{
+    const auto* dispatch = GetMlasPlatform().LayerNormDispatch;
+
+    if (dispatch == nullptr || dispatch->LayerNorm_Fp32 == nullptr) {
+        MlasLayerNormalization_FallBack(
+            Input, Skip, Bias, Gamma, Beta, Output, SkipOutput, N, Epsilon, Simplified, Mean, InvStdDev
+        );
+        return;
+    }
+
+    dispatch->LayerNorm_Fp32(Input, Skip, Bias, Gamma, Beta, Output, SkipOutput, N, Epsilon, Simplified, Mean, InvStdDev);
+}
+
+template <>
+void
+MLASCALL
+MlasLayerNormalization<MLAS_FP16>(
+    const MLAS_FP16* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    MLAS_FP16* Output,
+    MLAS_FP16* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+)
+{
+    //
+    // Convert the row to fp32 in the thread local buffer and normalize it in
+    // place with the fp32 kernel.
+    //
+
+    const size_t BufferCount = (SkipOutput != nullptr) ? N * 2 : N;
+    MlasThreadedBufAlloc(UpAlignSize(BufferCount * sizeof(float)));
+    float* Buffer = reinterpret_cast<float*>(ThreadedBufHolder.get());
+    float* SkipBuffer = (SkipOutput != nullptr) ? Buffer + N : nullptr;
+
+    MlasConvertHalfToFloatBuffer(Input, Buffer, N);
+
+    MlasLayerNormalization<float>(
+        Buffer, Skip, Bias, Gamma, Beta, Buffer, SkipBuffer, N, Epsilon, Simplified, Mean, InvStdDev
+    );
+
+    MlasConvertFloatToHalfBuffer(Buffer, Output, N);
+
+    if (SkipOutput != nullptr) {
+        MlasConvertFloatToHalfBuffer(SkipBuffer, SkipOutput, N);
+    }
+}
@@ -0,0 +1,115 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm.h
+
+Abstract:
+
+    This module includes kernel function prototypes and helper functions for
+    layer normalization, RMS normalization and their skip + bias variants.
+
+--*/
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "mlasi.h"
+
+struct MLAS_LAYERNORM_DISPATCH {
+    /**
+     * @brief Normalize one row in a single pass over the input. The sum and the sum of squares
+     *        are accumulated while Input + Skip + Bias is written to the output, which is then
+     *        normalized in place.
+     * @param Input         Address of the input row
+     * @param Skip          Address of the optional skip row added to the input
+     * @param Bias          Address of the optional bias added to the input
+     * @param Gamma         Address of the scale
+     * @param Beta          Address of the optional shift. Ignored if Simplified is true.
+     * @param Output        Address of the output row. Could be the same as the input row.
+     * @param SkipOutput    Address of the optional output of Input + Skip + Bias
+     * @param N             Number of elements in the row
+     * @param Epsilon       Value added to the variance
+     * @param Simplified    Whether to compute RMS normalization
+     * @param Mean          Address of the optional mean output. Ignored if Simplified is true.
+     * @param InvStdDev     Address of the optional output of the reciprocal of the standard deviation
+     */
+    typedef void(LayerNorm_Fp32_Fn)(
+        const float* Input,
+        const float* Skip,
+        const float* Bias,
+        const float* Gamma,
+        const float* Beta,
+        float* Output,
+        float* SkipOutput,
+        size_t N,
+        float Epsilon,
+        bool Simplified,
+        float* Mean,
+        float* InvStdDev
+    );
+
+    LayerNorm_Fp32_Fn* LayerNorm_Fp32 = nullptr;
+};
+
+void
+MLASCALL
+MlasLayerNormalization_FallBack(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    float* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+);
+
+//
+// Computes the mean and the reciprocal of the standard deviation of a row from
+// its sum and sum of squares, and stores them to the optional outputs.
+//
+MLAS_FORCEINLINE
+void
+MlasLayerNormStatistics(
+    float Sum,
+    float SumSquare,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev,
+    float& RowMean,
+    float& RowInvStdDev
+)
+{
+    const float Count = static_cast<float>(N);
+
+    if (Simplified) {
+        RowMean = 0.0f;
+        RowInvStdDev = 1.0f / std::sqrt(SumSquare / Count + Epsilon);
+    } else {
+        RowMean = Sum / Count;
+        // The variance could be slightly negative due to rounding.
+        const float Variance = std::max(SumSquare / Count - RowMean * RowMean, 0.0f);
+        RowInvStdDev = 1.0f / std::sqrt(Variance + Epsilon);
+    }
+
+    if (Mean != nullptr && !Simplified) {
+        *Mean = RowMean;
+    }
+
+    if (InvStdDev != nullptr) {
+        *InvStdDev = RowInvStdDev;
+    }
+}
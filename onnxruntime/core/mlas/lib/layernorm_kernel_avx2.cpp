@@ -0,0 +1,168 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements the layer normalization kernels for AVX2 supported
+    h/w.
+
+--*/
+
+#include "layernorm.h"
+
+namespace {
+
+MLAS_FORCEINLINE
+float
+ReduceAdd(__m256 Vector)
+{
+    __m128 Sum = _mm_add_ps(_mm256_castps256_ps128(Vector), _mm256_extractf128_ps(Vector, 1));
+    Sum = _mm_add_ps(Sum, _mm_movehl_ps(Sum, Sum));
+    Sum = _mm_add_ss(Sum, _mm_movehdup_ps(Sum));
+    return _mm_cvtss_f32(Sum);
+}
+
+MLAS_FORCEINLINE
+__m256
+LoadSum(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    size_t n
+)
+{
+    __m256 Value = _mm256_loadu_ps(Input + n);
+    if (Skip != nullptr) {
+        Value = _mm256_add_ps(Value, _mm256_loadu_ps(Skip + n));
+    }
+    if (Bias != nullptr) {
+        Value = _mm256_add_ps(Value, _mm256_loadu_ps(Bias + n));
+    }
+    return Value;
+}
+
+void
+LayerNormKernel_Avx2_Fp32(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    float* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+)
+{
+    //
+    // Add the skip and bias, store the sum and accumulate the sum and sum of
+    // squares with two independent sets of accumulators.
+    //
+
+    __m256 Sum0 = _mm256_setzero_ps();
+    __m256 Sum1 = _mm256_setzero_ps();
+    __m256 SumSquare0 = _mm256_setzero_ps();
+    __m256 SumSquare1 = _mm256_setzero_ps();
+
+    size_t n = 0;
+
+    for (; n + 16 <= N; n += 16) {
+        __m256 Value0 = LoadSum(Input, Skip, Bias, n);
+        __m256 Value1 = LoadSum(Input, Skip, Bias, n + 8);
+        if (SkipOutput != nullptr) {
+            _mm256_storeu_ps(SkipOutput + n, Value0);
+            _mm256_storeu_ps(SkipOutput + n + 8, Value1);
+        }
+        _mm256_storeu_ps(Output + n, Value0);
+        _mm256_storeu_ps(Output + n + 8, Value1);
+        Sum0 = _mm256_add_ps(Sum0, Value0);
+        Sum1 = _mm256_add_ps(Sum1, Value1);
+        SumSquare0 = _mm256_fmadd_ps(Value0, Value0, SumSquare0);
+        SumSquare1 = _mm256_fmadd_ps(Value1, Value1, SumSquare1);
+    }
+
+    if (n + 8 <= N) {
+        __m256 Value0 = LoadSum(Input, Skip, Bias, n);
+        if (SkipOutput != nullptr) {
+            _mm256_storeu_ps(SkipOutput + n, Value0);
+        }
+        _mm256_storeu_ps(Output + n, Value0);
+        Sum0 = _mm256_add_ps(Sum0, Value0);
+        SumSquare0 = _mm256_fmadd_ps(Value0, Value0, SumSquare0);
+        n += 8;
+    }
+
+    float Sum = ReduceAdd(_mm256_add_ps(Sum0, Sum1));
+    float SumSquare = ReduceAdd(_mm256_add_ps(SumSquare0, SumSquare1));
+
+    for (size_t i = n; i < N; i++) {
+        float Value = Input[i];
+        if (Skip != nullptr) {
+            Value += Skip[i];
+        }
+        if (Bias != nullptr) {
+            Value += Bias[i];
+        }
+        if (SkipOutput != nullptr) {
+            SkipOutput[i] = Value;
+        }
+        Output[i] = Value;
+        Sum += Value;
+        SumSquare += Value * Value;
+    }
+
+    float RowMean;
+    float RowInvStdDev;
+    MlasLayerNormStatistics(Sum, SumSquare, N, Epsilon, Simplified, Mean, InvStdDev, RowMean, RowInvStdDev);
+
+    //
+    // Normalize the output in place.
+    //
+
+    const __m256 MeanBroadcast = _mm256_set1_ps(RowMean);
+    const __m256 InvStdDevBroadcast = _mm256_set1_ps(RowInvStdDev);
+    const bool HasBeta = !Simplified && Beta != nullptr;
+
+    n = 0;
+
+    for (; n + 8 <= N; n += 8) {
+        __m256 Value = _mm256_loadu_ps(Output + n);
+        if (!Simplified) {
+            Value = _mm256_sub_ps(Value, MeanBroadcast);
+        }
+        Value = _mm256_mul_ps(_mm256_mul_ps(Value, InvStdDevBroadcast), _mm256_loadu_ps(Gamma + n));
+        if (HasBeta) {
+            Value = _mm256_add_ps(Value, _mm256_loadu_ps(Beta + n));
+        }
+        _mm256_storeu_ps(Output + n, Value);
+    }
+
+    for (; n < N; n++) {
+        float Value = (Output[n] - RowMean) * RowInvStdDev * Gamma[n];
+        if (HasBeta) {
+            Value += Beta[n];
+        }
+        Output[n] = Value;
+    }
+}
+
+}  // namespace
+
+//
+// Kernel dispatch structure definition.
+//
+const MLAS_LAYERNORM_DISPATCH MlasLayerNormDispatchAvx2 = []() {
+    MLAS_LAYERNORM_DISPATCH d;
+    d.LayerNorm_Fp32 = LayerNormKernel_Avx2_Fp32;
+    return d;
+}();
@@ -0,0 +1,135 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm_kernel_avx512.cpp
+
+Abstract:
+
+    This module implements the layer normalization kernels for AVX512F
+    supported h/w.
+
+--*/
+
+#include "layernorm.h"
+
+namespace {
+
+MLAS_FORCEINLINE
+__m512
+LoadSum(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    size_t n,
+    __mmask16 Mask
+)
+{
+    __m512 Value = _mm512_maskz_loadu_ps(Mask, Input + n);
+    if (Skip != nullptr) {
+        Value = _mm512_add_ps(Value, _mm512_maskz_loadu_ps(Mask, Skip + n));
+    }
+    if (Bias != nullptr) {
+        Value = _mm512_add_ps(Value, _mm512_maskz_loadu_ps(Mask, Bias + n));
+    }
+    return Value;
+}
+
+void
+LayerNormKernel_Avx512_Fp32(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    float* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+)
+{
+    //
+    // Add the skip and bias, store the sum and accumulate the sum and sum of
+    // squares with two independent sets of accumulators. The remaining
+    // elements are loaded with a mask, which zeroes the inactive lanes.
+    //
+
+    __m512 Sum0 = _mm512_setzero_ps();
+    __m512 Sum1 = _mm512_setzero_ps();
+    __m512 SumSquare0 = _mm512_setzero_ps();
+    __m512 SumSquare1 = _mm512_setzero_ps();
+
+    size_t n = 0;
+
+    for (; n + 32 <= N; n += 32) {
+        __m512 Value0 = LoadSum(Input, Skip, Bias, n, 0xFFFF);
+        __m512 Value1 = LoadSum(Input, Skip, Bias, n + 16, 0xFFFF);
+        if (SkipOutput != nullptr) {
+            _mm512_storeu_ps(SkipOutput + n, Value0);
+            _mm512_storeu_ps(SkipOutput + n + 16, Value1);
+        }
+        _mm512_storeu_ps(Output + n, Value0);
+        _mm512_storeu_ps(Output + n + 16, Value1);
+        Sum0 = _mm512_add_ps(Sum0, Value0);
+        Sum1 = _mm512_add_ps(Sum1, Value1);
+        SumSquare0 = _mm512_fmadd_ps(Value0, Value0, SumSquare0);
+        SumSquare1 = _mm512_fmadd_ps(Value1, Value1, SumSquare1);
+    }
+
+    for (; n < N; n += 16) {
+        const __mmask16 Mask = (N - n >= 16) ? __mmask16(0xFFFF) : __mmask16((1u << (N - n)) - 1);
+        __m512 Value0 = LoadSum(Input, Skip, Bias, n, Mask);
+        if (SkipOutput != nullptr) {
+            _mm512_mask_storeu_ps(SkipOutput + n, Mask, Value0);
+        }
+        _mm512_mask_storeu_ps(Output + n, Mask, Value0);
+        Sum0 = _mm512_add_ps(Sum0, Value0);
+        SumSquare0 = _mm512_fmadd_ps(Value0, Value0, SumSquare0);
+    }
+
+    const float Sum = _mm512_reduce_add_ps(_mm512_add_ps(Sum0, Sum1));
+    const float SumSquare = _mm512_reduce_add_ps(_mm512_add_ps(SumSquare0, SumSquare1));
+
+    float RowMean;
+    float RowInvStdDev;
+    MlasLayerNormStatistics(Sum, SumSquare, N, Epsilon, Simplified, Mean, InvStdDev, RowMean, RowInvStdDev);
+
+    //
+    // Normalize the output in place.
+    //
+
+    const __m512 MeanBroadcast = _mm512_set1_ps(RowMean);
+    const __m512 InvStdDevBroadcast = _mm512_set1_ps(RowInvStdDev);
+    const bool HasBeta = !Simplified && Beta != nullptr;
+
+    for (n = 0; n < N; n += 16) {
+        const __mmask16 Mask = (N - n >= 16) ? __mmask16(0xFFFF) : __mmask16((1u << (N - n)) - 1);
+        __m512 Value = _mm512_maskz_loadu_ps(Mask, Output + n);
+        if (!Simplified) {
+            Value = _mm512_sub_ps(Value, MeanBroadcast);
+        }
+        Value = _mm512_mul_ps(_mm512_mul_ps(Value, InvStdDevBroadcast), _mm512_maskz_loadu_ps(Mask, Gamma + n));
+        if (HasBeta) {
+            Value = _mm512_add_ps(Value, _mm512_maskz_loadu_ps(Mask, Beta + n));
+        }
+        _mm512_mask_storeu_ps(Output + n, Mask, Value);
+    }
+}
+
+}  // namespace
+
+//
+// Kernel dispatch structure definition.
+//
+const MLAS_LAYERNORM_DISPATCH MlasLayerNormDispatchAvx512 = []() {
+    MLAS_LAYERNORM_DISPATCH d;
+    d.LayerNorm_Fp32 = LayerNormKernel_Avx512_Fp32;
+    return d;
+}();
@@ -0,0 +1,156 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm_kernel_neon.cpp
+
+Abstract:
+
+    This module implements the layer normalization kernels for ARM NEON.
+
+--*/
+
+#include "layernorm.h"
+
+namespace {
+
+MLAS_FORCEINLINE
+float32x4_t
+LoadSum(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    size_t n
+)
+{
+    float32x4_t Value = vld1q_f32(Input + n);
+    if (Skip != nullptr) {
+        Value = vaddq_f32(Value, vld1q_f32(Skip + n));
+    }
+    if (Bias != nullptr) {
+        Value = vaddq_f32(Value, vld1q_f32(Bias + n));
+    }
+    return Value;
+}
+
+void
+LayerNormKernel_Neon_Fp32(
+    const float* Input,
+    const float* Skip,
+    const float* Bias,
+    const float* Gamma,
+    const float* Beta,
+    float* Output,
+    float* SkipOutput,
+    size_t N,
+    float Epsilon,
+    bool Simplified,
+    float* Mean,
+    float* InvStdDev
+)
+{
+    //
+    // Add the skip and bias, store the sum and accumulate the sum and sum of
+    // squares with two independent sets of accumulators.
+    //
+
+    float32x4_t Sum0 = vdupq_n_f32(0.0f);
+    float32x4_t Sum1 = vdupq_n_f32(0.0f);
+    float32x4_t SumSquare0 = vdupq_n_f32(0.0f);
+    float32x4_t SumSquare1 = vdupq_n_f32(0.0f);
+
+    size_t n = 0;
+
+    for (; n + 8 <= N; n += 8) {
+        float32x4_t Value0 = LoadSum(Input, Skip, Bias, n);
+        float32x4_t Value1 = LoadSum(Input, Skip, Bias, n + 4);
+        if (SkipOutput != nullptr) {
+            vst1q_f32(SkipOutput + n, Value0);
+            vst1q_f32(SkipOutput + n + 4, Value1);
+        }
+        vst1q_f32(Output + n, Value0);
+        vst1q_f32(Output + n + 4, Value1);
+        Sum0 = vaddq_f32(Sum0, Value0);
+        Sum1 = vaddq_f32(Sum1, Value1);
+        SumSquare0 = vfmaq_f32(SumSquare0, Value0, Value0);
+        SumSquare1 = vfmaq_f32(SumSquare1, Value1, Value1);
+    }
+
+    if (n + 4 <= N) {
+        float32x4_t Value0 = LoadSum(Input, Skip, Bias, n);
+        if (SkipOutput != nullptr) {
+            vst1q_f32(SkipOutput + n, Value0);
+        }
+        vst1q_f32(Output + n, Value0);
+        Sum0 = vaddq_f32(Sum0, Value0);
+        SumSquare0 = vfmaq_f32(SumSquare0, Value0, Value0);
+        n += 4;
+    }
+
+    float Sum = vaddvq_f32(vaddq_f32(Sum0, Sum1));
+    float SumSquare = vaddvq_f32(vaddq_f32(SumSquare0, SumSquare1));
+
+    for (size_t i = n; i < N; i++) {
+        float Value = Input[i];
+        if (Skip != nullptr) {
+            Value += Skip[i];
+        }
+        if (Bias != nullptr) {
+            Value += Bias[i];
+        }
+        if (SkipOutput != nullptr) {
+            SkipOutput[i] = Value;
+        }
+        Output[i] = Value;
+        Sum += Value;
+        SumSquare += Value * Value;
+    }
+
+    float RowMean;
+    float RowInvStdDev;
+    MlasLayerNormStatistics(Sum, SumSquare, N, Epsilon, Simplified, Mean, InvStdDev, RowMean, RowInvStdDev);
+
+    //
+    // Normalize the output in place.
+    //
+
+    const float32x4_t MeanBroadcast = vdupq_n_f32(RowMean);
+    const bool HasBeta = !Simplified && Beta != nullptr;
+
+    n = 0;
+
+    for (; n + 4 <= N; n += 4) {
+        float32x4_t Value = vld1q_f32(Output + n);
+        if (!Simplified) {
+            Value = vsubq_f32(Value, MeanBroadcast);
+        }
+        Value = vmulq_f32(vmulq_n_f32(Value, RowInvStdDev), vld1q_f32(Gamma + n));
+        if (HasBeta) {
+            Value = vaddq_f32(Value, vld1q_f32(Beta + n));
+        }
+        vst1q_f32(Output + n, Value);
+    }
+
+    for (; n < N; n++) {
+        float Value = (Output[n] - RowMean) * RowInvStdDev * Gamma[n];
+        if (HasBeta) {
+            Value += Beta[n];
+        }
+        Output[n] = Value;
+    }
+}
+
+}  // namespace
+
+//
+// Kernel dispatch structure definition.
+//
+const MLAS_LAYERNORM_DISPATCH MlasLayerNormDispatchNeon = []() {
+    MLAS_LAYERNORM_DISPATCH d;
+    d.LayerNorm_Fp32 = LayerNormKernel_Neon_Fp32;
+    return d;
+}();
@@ -333,6 +333,13 @@ static_assert(sizeof(MLAS_FP16) == FP16_SIZE);
 #define MLAS_DGEMM_STRIDEN                          64
 #define MLAS_DGEMM_STRIDEK                          128
 
+//
+// Define the maximum number of rows of A for which the skinny GEMM kernels
+// stream B directly instead of packing it.
+//
+
+#define MLAS_GEMM_SKINNY_M                          8
+
 //
 // Define the alignment for segmenting a GEMM operation across multiple
 // threads.
@@ -470,6 +477,23 @@ void
     float beta
     );
 
+typedef
+void
+(MLASCALL MLAS_SGEMM_SKINNY_KERNEL)(
+    const float* A,
+    const float* B,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    float alpha,
+    bool TransposeB,
+    bool ZeroMode
+    );
+
 typedef
 void
 (MLASCALL MLAS_SGEMM_TRANSPOSE_PACKB_BLOCK_ROUTINE)(
@@ -978,6 +1002,7 @@ extern "C" {
 #if defined(MLAS_TARGET_AMD64)
     MLAS_SGEMM_KERNEL_M1_ROUTINE MlasSgemmKernelM1Avx;
     MLAS_SGEMM_KERNEL_M1_ROUTINE MlasSgemmKernelM1TransposeBAvx;
+    MLAS_SGEMM_SKINNY_KERNEL MlasSgemmSkinnyKernelAvx2;
 #elif defined(MLAS_TARGET_ARM64) || defined(MLAS_TARGET_WASM)
     MLAS_GEMV_FLOAT_KERNEL MlasGemvFloatKernel;
 #endif
@@ -1251,6 +1276,10 @@ extern const MLAS_ROPE_DISPATCH MlasRopeDispatchAvx2;
 struct MLAS_HGEMM_DISPATCH;
 extern const MLAS_HGEMM_DISPATCH MlasHGemmDispatchNeon;
 
+// half gemm with single precision accumulation dispatch structure
+struct MLAS_HALFGEMM_DISPATCH;
+extern const MLAS_HALFGEMM_DISPATCH MlasHalfGemmDispatchAvx2;
+
 // softmax dispatch structure
 struct MLAS_SOFTMAX_DISPATCH;
 extern const MLAS_SOFTMAX_DISPATCH MlasSoftmaxDispatchNeon;
@@ -1259,6 +1288,12 @@ extern const MLAS_SOFTMAX_DISPATCH MlasSoftmaxDispatchNeon;
 struct MLAS_ELTWISE_DISPATCH;
 extern const MLAS_ELTWISE_DISPATCH MlasEltwiseDispatchNeon;
 
+// layer normalization dispatch structure
+struct MLAS_LAYERNORM_DISPATCH;
+extern const MLAS_LAYERNORM_DISPATCH MlasLayerNormDispatchNeon;
+extern const MLAS_LAYERNORM_DISPATCH MlasLayerNormDispatchAvx2;
+extern const MLAS_LAYERNORM_DISPATCH MlasLayerNormDispatchAvx512;
+
 //
 // Quantized depthwise convolution kernels.
 //
@@ -1404,6 +1439,7 @@ struct MLAS_PLATFORM {
 #if defined(MLAS_TARGET_AMD64)
     MLAS_SGEMM_KERNEL_M1_ROUTINE* KernelM1Routine;
     MLAS_SGEMM_KERNEL_M1_ROUTINE* KernelM1TransposeBRoutine;
+    MLAS_SGEMM_SKINNY_KERNEL* SgemmSkinnyKernel;
     MLAS_SGEMM_TRANSPOSE_PACKB_BLOCK_ROUTINE* TransposePackB16x4Routine;
     MLAS_GEMM_DOUBLE_KERNEL* GemmDoubleKernel;
     MLAS_GEMM_U8S8_KERNEL* GemmU8S8Kernel;
@@ -1449,8 +1485,10 @@ struct MLAS_PLATFORM {
 
     const MLAS_ROPE_DISPATCH* RopeDispatch{nullptr};
     const MLAS_HGEMM_DISPATCH* HGemmDispatch{nullptr};
+    const MLAS_HALFGEMM_DISPATCH* HalfGemmDispatch{nullptr};
     const MLAS_SOFTMAX_DISPATCH* SoftmaxDispatch{nullptr};
     const MLAS_ELTWISE_DISPATCH* EltwiseDispatch{nullptr};
+    const MLAS_LAYERNORM_DISPATCH* LayerNormDispatch{nullptr};
 };
 
 inline
@@ -1499,6 +1537,23 @@ MlasTrySimpleParallel(
     const std::function<void(std::ptrdiff_t tid)>& Work
     );
 
+/**
+ * @brief Distribute iterations over a thread pool like MlasTrySimpleParallel,
+ *        but hand each NUMA node of the pool a fixed contiguous range of
+ *        iterations, so that repeated calls touch the same data from the
+ *        same node.
+ *
+ * @param ThreadPool [IN]          Optional thread pool. Ignored when using OpenMP
+ * @param Iterations [IN]          Total number of iterations
+ * @param Work [IN]                Logic for computing a single iteration
+ */
+void
+MlasTryNumaPartitionedParallel(
+    MLAS_THREADPOOL* ThreadPool,
+    const std::ptrdiff_t Iterations,
+    const std::function<void(std::ptrdiff_t tid)>& Work
+    );
+
 
 /**
  * @brief Distribute many iterations of work over a thread pool if supported.
@@ -1214,6 +1214,28 @@ Return Value:
 
     }
 
+    //
+    // Handle the case of a skinny M, such as the few rows of a decode step.
+    // As with M equals one, the data from matrix B is referenced only a few
+    // times, so the kernel streams it directly rather than packing it.
+    //
+
+#if defined(MLAS_TARGET_AMD64) && !defined(FORCE_GENERIC_ALGORITHMS)
+
+    MLAS_SGEMM_SKINNY_KERNEL* SgemmSkinnyKernel = GetMlasPlatform().SgemmSkinnyKernel;
+
+    if (M <= MLAS_GEMM_SKINNY_M && TransA == CblasNoTrans && SgemmSkinnyKernel != nullptr) {
+
+        if (beta != 0.0f && beta != 1.0f) {
+            MlasSgemmMultiplyBeta(C, M, N, ldc, beta);
+        }
+
+        SgemmSkinnyKernel(A, B, C, M, N, K, lda, ldb, ldc, alpha, TransB == CblasTrans, beta == 0.0f);
+        return;
+    }
+
+#endif
+
     //
     // Compute the strides to step through slices of the input matrices.
     //
@@ -1531,27 +1553,48 @@ Return Value:
     //
     // Dispatch the partitioned operation.
     //
+    // When an output processor is supplied, the columns are computed one
+    // slice at a time, so that each slice of the output is processed while
+    // it is still resident in the cache.
+    //
 
     const size_t lda = DataParams->lda;
     const size_t ldc = DataParams->ldc;
 
     const float* A = DataParams->A + RangeStartM * ((TransA == CblasNoTrans) ? lda : 1);
-    float* C = DataParams->C + RangeStartM * ldc + RangeStartN;
 
-    if (DataParams->BIsPacked) {
+    const MLAS_GEMM_POSTPROCESSOR<float>* OutputProcessor = DataParams->OutputProcessor;
+    const size_t StrideN = (OutputProcessor != nullptr) ? size_t(MLAS_SGEMM_STRIDEN) : RangeCountN;
 
-        MlasSgemmPackedOperation(TransA, RangeCountM, RangeStartN, RangeCountN,
-            K, DataParams->alpha, A, lda, DataParams->B,
-            BlockedN * MLAS_SGEMM_STRIDEN_THREAD_ALIGN, DataParams->beta, C, ldc);
+    size_t CountN;
 
-    } else {
+    for (size_t n = 0; n < RangeCountN; n += CountN) {
 
-        const size_t ldb = DataParams->ldb;
+        const size_t SliceStartN = RangeStartN + n;
 
-        const float* B = (const float*)DataParams->B + RangeStartN * ((TransB == CblasNoTrans) ? 1 : ldb);
+        CountN = std::min(RangeCountN - n, StrideN);
 
-        MlasSgemmOperation(TransA, TransB, RangeCountM, RangeCountN, K,
-            DataParams->alpha, A, lda, B, ldb, DataParams->beta, C, ldc);
+        float* C = DataParams->C + RangeStartM * ldc + SliceStartN;
+
+        if (DataParams->BIsPacked) {
+
+            MlasSgemmPackedOperation(TransA, RangeCountM, SliceStartN, CountN,
+                K, DataParams->alpha, A, lda, DataParams->B,
+                BlockedN * MLAS_SGEMM_STRIDEN_THREAD_ALIGN, DataParams->beta, C, ldc);
+
+        } else {
+
+            const size_t ldb = DataParams->ldb;
+
+            const float* B = (const float*)DataParams->B + SliceStartN * ((TransB == CblasNoTrans) ? 1 : ldb);
+
+            MlasSgemmOperation(TransA, TransB, RangeCountM, CountN, K,
+                DataParams->alpha, A, lda, B, ldb, DataParams->beta, C, ldc);
+        }
+
+        if (OutputProcessor != nullptr) {
+            OutputProcessor->Process(DataParams->C, RangeStartM, SliceStartN, RangeCountM, CountN, ldc);
+        }
     }
 }
 #if defined(_MSC_VER) && !defined(__clang__)
@@ -1573,9 +1616,14 @@ MlasGemmBatch(
     )
 {
     // Override
+    // The override does not run output processors, so those batches stay on the MLAS kernels.
+    const bool HasOutputProcessor = std::any_of(Data, Data + BatchSize,
+        [](const MLAS_SGEMM_DATA_PARAMS& Params) { return Params.OutputProcessor != nullptr; });
+
     if(GetMlasPlatform().MlasGemmBatchOverride != nullptr &&
         // TODO: Remove once KAI supports transposing for A
         TransA != CBLAS_TRANSPOSE::CblasTrans &&
+        !HasOutputProcessor &&
         GetMlasPlatform().MlasGemmBatchOverride(TransA, TransB, M, N, K, Data, BatchSize, ThreadPool)){
         return;
     }
@@ -1599,12 +1647,15 @@ MlasGemmBatch(
     // N.B. Currently, the operation is segmented as a 1D partition, which
     // works okay for operations involving skinny matrices.
     //
+    // A skinny M is always partitioned along N, so that every thread streams
+    // its own columns of B once instead of all threads sharing all of B.
+    //
 
     ptrdiff_t ThreadsPerGemm = (TargetThreadCount + BatchSize - 1) / BatchSize;
     ptrdiff_t ThreadCountM;
     ptrdiff_t ThreadCountN;
 
-    if (N > M) {
+    if (N > M || M <= MLAS_GEMM_SKINNY_M) {
 
         const size_t BlockedN = (N + MLAS_SGEMM_STRIDEN_THREAD_ALIGN - 1) /
             MLAS_SGEMM_STRIDEN_THREAD_ALIGN;
@@ -1626,15 +1677,26 @@ MlasGemmBatch(
         ThreadCountN = 1;
     }
 
-    MlasTrySimpleParallel(ThreadPool,
-        ThreadsPerGemm * static_cast<ptrdiff_t>(BatchSize),
-        [=](ptrdiff_t tid)
+    auto SgemmWork = [=](ptrdiff_t tid)
     {
         ptrdiff_t GemmIdx = tid / ThreadsPerGemm;
         ptrdiff_t ThreadIdx = tid % ThreadsPerGemm;
         MlasSgemmThreaded(ThreadCountM, ThreadCountN,
             TransA, TransB, M, N, K, &(Data[GemmIdx]), ThreadIdx);
-    });
+    };
+
+    //
+    // When a single GEMM is partitioned over N, consecutive threads stream
+    // consecutive columns of B. Keep each NUMA node on the same range of
+    // columns across calls, so that the weights a node reads stay local.
+    //
+
+    if (BatchSize == 1 && ThreadCountM == 1) {
+        MlasTryNumaPartitionedParallel(ThreadPool, ThreadsPerGemm, SgemmWork);
+    } else {
+        MlasTrySimpleParallel(ThreadPool,
+            ThreadsPerGemm * static_cast<ptrdiff_t>(BatchSize), SgemmWork);
+    }
 }
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(pop)
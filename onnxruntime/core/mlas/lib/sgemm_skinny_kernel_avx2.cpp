@@ -0,0 +1,425 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sgemm_skinny_kernel_avx2.cpp
+
+Abstract:
+
+    This module implements the single precision matrix/matrix multiply
+    operation (SGEMM) for a skinny matrix A of at most MLAS_GEMM_SKINNY_M
+    rows, such as the few tokens of a decode step, using AVX2 and FMA.
+
+    Each element of B is used by only a few rows of A, so copying B to a
+    local packed buffer costs more than the multiply itself. These kernels
+    stream B straight from memory exactly once, reading a few rows of B in
+    parallel so that every access stays sequential.
+
+--*/
+
+#include "mlasi.h"
+
+namespace {
+
+//
+// Number of rows of A held in registers by one pass of the kernels.
+//
+
+constexpr size_t SkinnyRowCount = 4;
+
+//
+// Number of rows of B consumed by one step of the non-transposed kernel.
+// Each of them is read sequentially, so the hardware prefetchers can follow
+// all of them, and the partial results in C stay in the first level cache.
+//
+
+constexpr size_t SkinnyStrideK = 16;
+
+//
+// Number of columns of C computed for all rows of A before moving on, so
+// that the rows of A beyond the first SkinnyRowCount find B in the cache.
+//
+
+constexpr size_t SkinnyStrideN = 64;
+constexpr size_t SkinnyTransposeBStrideN = 2;
+
+template <typename IterationFn, size_t... Indices>
+MLAS_FORCEINLINE void
+UnrolledLoopIterations(IterationFn&& f, std::index_sequence<Indices...> /* indices */)
+{
+    (f(Indices), ...);
+}
+
+template <size_t N, typename IterationFn>
+MLAS_FORCEINLINE void
+UnrolledLoop(IterationFn&& f)
+{
+    UnrolledLoopIterations(std::forward<IterationFn>(f), std::make_index_sequence<N>());
+}
+
+MLAS_FORCEINLINE
+__m256i
+SkinnyLoadMask(
+    size_t len
+)
+{
+    return _mm256_cmpgt_epi32(_mm256_set1_epi32(int32_t(len)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+}
+
+MLAS_FORCEINLINE
+float
+SkinnyReduceAdd(
+    __m256 Value
+)
+{
+    __m128 Sum = _mm_add_ps(_mm256_castps256_ps128(Value), _mm256_extractf128_ps(Value, 1));
+    Sum = _mm_add_ps(Sum, _mm_movehl_ps(Sum, Sum));
+    Sum = _mm_add_ss(Sum, _mm_movehdup_ps(Sum));
+    return _mm_cvtss_f32(Sum);
+}
+
+/**
+ * @brief Add alpha times the accumulator to 8 or fewer columns of one row
+ *        of C, or store it when ZeroMode is set.
+ */
+MLAS_FORCEINLINE
+void
+SkinnyStoreOutput(
+    __m256 Accumulator,
+    float* C,
+    __m256 AlphaBroadcast,
+    bool ZeroMode
+)
+{
+    if (ZeroMode) {
+        _mm256_storeu_ps(C, _mm256_mul_ps(Accumulator, AlphaBroadcast));
+    } else {
+        _mm256_storeu_ps(C, _mm256_fmadd_ps(Accumulator, AlphaBroadcast, _mm256_loadu_ps(C)));
+    }
+}
+
+MLAS_FORCEINLINE
+void
+SkinnyStoreOutputPartial(
+    __m256 Accumulator,
+    float* C,
+    __m256 AlphaBroadcast,
+    __m256i Mask,
+    bool ZeroMode
+)
+{
+    if (ZeroMode) {
+        _mm256_maskstore_ps(C, Mask, _mm256_mul_ps(Accumulator, AlphaBroadcast));
+    } else {
+        _mm256_maskstore_ps(C, Mask, _mm256_fmadd_ps(Accumulator, AlphaBroadcast, _mm256_maskload_ps(C, Mask)));
+    }
+}
+
+/**
+ * @brief Multiply RowCount rows of A by CountK rows of a non-transposed B
+ *        and add the product to C, 16 columns at a time.
+ */
+template <size_t RowCount>
+void
+SgemmSkinnyKernelAvx2(
+    const float* A,
+    const float* B,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    float alpha,
+    bool ZeroMode
+)
+{
+    const __m256 AlphaBroadcast = _mm256_set1_ps(alpha);
+
+    size_t n = 0;
+
+    for (; n + 16 <= CountN; n += 16) {
+        __m256 Accumulators[RowCount][2];
+        UnrolledLoop<RowCount>([&](size_t r) {
+            Accumulators[r][0] = _mm256_setzero_ps();
+            Accumulators[r][1] = _mm256_setzero_ps();
+        });
+
+        const float* b = B + n;
+        for (size_t k = 0; k < CountK; k++) {
+            const __m256 B0 = _mm256_loadu_ps(b);
+            const __m256 B1 = _mm256_loadu_ps(b + 8);
+            UnrolledLoop<RowCount>([&](size_t r) {
+                const __m256 ABroadcast = _mm256_broadcast_ss(A + r * lda + k);
+                Accumulators[r][0] = _mm256_fmadd_ps(ABroadcast, B0, Accumulators[r][0]);
+                Accumulators[r][1] = _mm256_fmadd_ps(ABroadcast, B1, Accumulators[r][1]);
+            });
+            b += ldb;
+        }
+
+        UnrolledLoop<RowCount>([&](size_t r) {
+            float* c = C + r * ldc + n;
+            SkinnyStoreOutput(Accumulators[r][0], c, AlphaBroadcast, ZeroMode);
+            SkinnyStoreOutput(Accumulators[r][1], c + 8, AlphaBroadcast, ZeroMode);
+        });
+    }
+
+    for (; n < CountN; n += 8) {
+        const size_t len = std::min(CountN - n, size_t{8});
+        const __m256i Mask = SkinnyLoadMask(len);
+
+        __m256 Accumulators[RowCount];
+        UnrolledLoop<RowCount>([&](size_t r) {
+            Accumulators[r] = _mm256_setzero_ps();
+        });
+
+        const float* b = B + n;
+        for (size_t k = 0; k < CountK; k++) {
+            const __m256 B0 = _mm256_maskload_ps(b, Mask);
+            UnrolledLoop<RowCount>([&](size_t r) {
+                Accumulators[r] = _mm256_fmadd_ps(_mm256_broadcast_ss(A + r * lda + k), B0, Accumulators[r]);
+            });
+            b += ldb;
+        }
+
+        UnrolledLoop<RowCount>([&](size_t r) {
+            SkinnyStoreOutputPartial(Accumulators[r], C + r * ldc + n, AlphaBroadcast, Mask, ZeroMode);
+        });
+    }
+}
+
+/**
+ * @brief Multiply RowCount rows of A by the rows of a transposed B, two
+ *        columns of C at a time. Each output is a dot product along K.
+ */
+template <size_t RowCount>
+void
+SgemmSkinnyKernelTransposeBAvx2(
+    const float* A,
+    const float* B,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    float alpha,
+    bool ZeroMode
+)
+{
+    const size_t CountK8 = CountK & ~size_t{7};
+    const __m256i Mask = SkinnyLoadMask(CountK - CountK8);
+
+    for (size_t n = 0; n < CountN; n += 2) {
+        const size_t ColumnCount = std::min(CountN - n, size_t{2});
+        const float* b0 = B + n * ldb;
+        const float* b1 = (ColumnCount == 2) ? b0 + ldb : b0;
+
+        __m256 Accumulators[RowCount][2];
+        UnrolledLoop<RowCount>([&](size_t r) {
+            Accumulators[r][0] = _mm256_setzero_ps();
+            Accumulators[r][1] = _mm256_setzero_ps();
+        });
+
+        size_t k = 0;
+        for (; k < CountK8; k += 8) {
+            const __m256 B0 = _mm256_loadu_ps(b0 + k);
+            const __m256 B1 = _mm256_loadu_ps(b1 + k);
+            UnrolledLoop<RowCount>([&](size_t r) {
+                const __m256 AElements = _mm256_loadu_ps(A + r * lda + k);
+                Accumulators[r][0] = _mm256_fmadd_ps(AElements, B0, Accumulators[r][0]);
+                Accumulators[r][1] = _mm256_fmadd_ps(AElements, B1, Accumulators[r][1]);
+            });
+        }
+
+        if (k < CountK) {
+            const __m256 B0 = _mm256_maskload_ps(b0 + k, Mask);
+            const __m256 B1 = _mm256_maskload_ps(b1 + k, Mask);
+            UnrolledLoop<RowCount>([&](size_t r) {
+                const __m256 AElements = _mm256_maskload_ps(A + r * lda + k, Mask);
+                Accumulators[r][0] = _mm256_fmadd_ps(AElements, B0, Accumulators[r][0]);
+                Accumulators[r][1] = _mm256_fmadd_ps(AElements, B1, Accumulators[r][1]);
+            });
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+            float* c = C + r * ldc + n;
+            for (size_t j = 0; j < ColumnCount; j++) {
+                const float Value = alpha * SkinnyReduceAdd(Accumulators[r][j]);
+                c[j] = ZeroMode ? Value : c[j] + Value;
+            }
+        }
+    }
+}
+
+template <size_t RowCount>
+void
+SgemmSkinnyRows(
+    const float* A,
+    const float* B,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    float alpha,
+    bool TransposeB,
+    bool ZeroMode
+)
+{
+    if (TransposeB) {
+        SgemmSkinnyKernelTransposeBAvx2<RowCount>(A, B, C, CountN, CountK, lda, ldb, ldc, alpha, ZeroMode);
+    } else {
+        SgemmSkinnyKernelAvx2<RowCount>(A, B, C, CountN, CountK, lda, ldb, ldc, alpha, ZeroMode);
+    }
+}
+
+/**
+ * @brief Compute all CountM rows of C for one block of columns, a few rows
+ *        of A at a time. The block of B is loaded from memory by the first
+ *        group of rows and found in the cache by the others.
+ */
+void
+SgemmSkinnyColumnBlock(
+    const float* A,
+    const float* B,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    float alpha,
+    bool TransposeB,
+    bool ZeroMode
+)
+{
+    size_t RowCount;
+
+    for (size_t m = 0; m < CountM; m += RowCount) {
+        RowCount = std::min(CountM - m, SkinnyRowCount);
+        const float* a = A + m * lda;
+        float* c = C + m * ldc;
+
+        switch (RowCount) {
+            case 1:
+                SgemmSkinnyRows<1>(a, B, c, CountN, CountK, lda, ldb, ldc, alpha, TransposeB, ZeroMode);
+                break;
+            case 2:
+                SgemmSkinnyRows<2>(a, B, c, CountN, CountK, lda, ldb, ldc, alpha, TransposeB, ZeroMode);
+                break;
+            case 3:
+                SgemmSkinnyRows<3>(a, B, c, CountN, CountK, lda, ldb, ldc, alpha, TransposeB, ZeroMode);
+                break;
+            default:
+                SgemmSkinnyRows<4>(a, B, c, CountN, CountK, lda, ldb, ldc, alpha, TransposeB, ZeroMode);
+                break;
+        }
+    }
+}
+
+}  // namespace
+
+void
+MLASCALL
+MlasSgemmSkinnyKernelAvx2(
+    const float* A,
+    const float* B,
+    float* C,
+    size_t CountM,
+    size_t CountN,
+    size_t CountK,
+    size_t lda,
+    size_t ldb,
+    size_t ldc,
+    float alpha,
+    bool TransposeB,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine computes C = alpha * A * B + (ZeroMode ? 0 : C) for a
+    skinny non-transposed matrix A.
+
+Arguments:
+
+    A - Supplies the address of matrix A.
+
+    B - Supplies the address of matrix B, which is transposed if TransposeB
+        is set.
+
+    C - Supplies the address of matrix C.
+
+    CountM - Supplies the number of rows of matrix A and matrix C, at most
+        MLAS_GEMM_SKINNY_M.
+
+    CountN - Supplies the number of columns of matrix B and matrix C.
+
+    CountK - Supplies the number of columns of matrix A and the number of
+        rows of matrix B.
+
+    lda - Supplies the first dimension of matrix A.
+
+    ldb - Supplies the first dimension of matrix B.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    alpha - Supplies the scalar alpha multiplier (see SGEMM definition).
+
+    TransposeB - Supplies true if matrix B is transposed.
+
+    ZeroMode - Supplies true if the output matrix must be zero initialized,
+        else false if the output matrix is accumulated into.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // A transposed B is read along its contiguous rows, a couple of columns
+    // of C at a time.
+    //
+
+    if (TransposeB) {
+
+        size_t CountNBlock;
+
+        for (size_t n = 0; n < CountN; n += CountNBlock) {
+            CountNBlock = std::min(CountN - n, SkinnyTransposeBStrideN);
+            SgemmSkinnyColumnBlock(A, B + n * ldb, C + n, CountM, CountNBlock, CountK, lda, ldb, ldc, alpha,
+                                   true, ZeroMode);
+        }
+
+        return;
+    }
+
+    //
+    // Step through B a few rows at a time, so that every row is streamed
+    // sequentially across all of N, and accumulate the slices into C.
+    //
+
+    size_t CountKSlice;
+
+    for (size_t k = 0; k < CountK; k += CountKSlice) {
+
+        CountKSlice = std::min(CountK - k, SkinnyStrideK);
+
+        size_t CountNBlock;
+
+        for (size_t n = 0; n < CountN; n += CountNBlock) {
+            CountNBlock = std::min(CountN - n, SkinnyStrideN);
+            SgemmSkinnyColumnBlock(A + k, B + k * ldb + n, C + n, CountM, CountNBlock, CountKSlice, lda, ldb, ldc,
+                                   alpha, false, ZeroMode && (k == 0));
+        }
+    }
+}
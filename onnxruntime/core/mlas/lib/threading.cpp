@@ -95,6 +95,44 @@ MlasTrySimpleParallel(
 }
 
 
+void
+MlasTryNumaPartitionedParallel(
+    MLAS_THREADPOOL * ThreadPool,
+    const std::ptrdiff_t Iterations,
+    const std::function<void(std::ptrdiff_t tid)>& Work)
+{
+    //
+    // Execute the routine directly if only one iteration is specified.
+    //
+    if (Iterations == 1) {
+        Work(0);
+        return;
+    }
+
+#if defined(BUILD_MLAS_NO_ONNXRUNTIME)
+    MLAS_UNREFERENCED_PARAMETER(ThreadPool);
+
+    //
+    // Fallback to OpenMP or a serialized implementation.
+    //
+
+    for (ptrdiff_t tid = 0; tid < Iterations; tid++) {
+        Work(tid);
+    }
+#else
+    //
+    // Schedule the iterations in node sized ranges using the thread pool object.
+    //
+
+    MLAS_THREADPOOL::TryParallelForByNumaNode(ThreadPool, Iterations, 1, [&](ptrdiff_t begin, ptrdiff_t end) {
+        for (ptrdiff_t tid = begin; tid < end; tid++) {
+            Work(tid);
+        }
+    });
+#endif
+}
+
+
 void
 MlasTryBatchParallel(
 	MLAS_THREADPOOL * ThreadPool,
@@ -199,6 +199,10 @@ X --> Cast --> Pow --> Mul --> Add --> Mul --> Tanh --> Add --> Mul
 
 */
 Status FastGeluFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  if (fused_domain_ != kMSDomain && fused_domain_ != kMyCustomDomain) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Unsupported FastGelu fusion domain: ", fused_domain_);
+  }
+
   GraphViewer graph_viewer(graph);
   const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
 
@@ -221,6 +225,11 @@ Status FastGeluFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
       second_formula = true;
     };
 
+    // The my_cpu FastGelu kernel only exists for the CPU EP.
+    if (fused_domain_ == kMyCustomDomain && node.GetExecutionProviderType() != kCpuExecutionProvider) {
+      continue;
+    }
+
     Node& tanh_node = *graph.GetNode(matchRet.tanh_input_node->OutputNodesBegin()->Index());
     if (!(graph_utils::IsSupportedOptypeVersionAndDomain(tanh_node, "Tanh", {6, 13}) &&
           CheckNode(graph, tanh_node, node.GetExecutionProviderType(), true))) {
@@ -306,7 +315,7 @@ Status FastGeluFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
                                          "FastGelu",
                                          "fused GPT2Gelu subgraphs ",
                                          std::array{matchRet.gelu_without_bias_input_arg},
-                                         std::array{&shape_output}, {}, kMSDomain);
+                                         std::array{&shape_output}, {}, fused_domain_);
 
     // assign provider to this new node, provider should be same as the provider for old node.
     fast_gelu_node.SetExecutionProviderType(node.GetExecutionProviderType());
@@ -23,11 +23,16 @@ The formula corresponding to Gelu activation subgraph:
 x * 0.5 * (1.0 + tanh(0.7978845608028654 * x * (1.0 + 0.044715 * x * x))) or
 x * 0.5 * (1.0 + tanh((sqrt(2 / pi) * (x + 0.044715 * pow(x, 3))))), where x is the input.
 
+The fused FastGelu node is emitted in fused_domain, which is either kMSDomain (default) or kMyCustomDomain.
+As only the CPU EP has kernels for kMyCustomDomain, subgraphs on other EPs are left untouched in that case.
+Any other domain makes ApplyImpl fail with INVALID_ARGUMENT.
+
 */
 class FastGeluFusion : public GraphTransformer {
  public:
-  FastGeluFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
-      : GraphTransformer("FastGeluFusion", compatible_execution_providers) {}
+  FastGeluFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {},
+                 std::string_view fused_domain = kMSDomain)
+      : GraphTransformer("FastGeluFusion", compatible_execution_providers), fused_domain_(fused_domain) {}
 
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 
@@ -35,6 +40,8 @@ class FastGeluFusion : public GraphTransformer {
   MatchResult CheckFirstFormula(Graph& graph, Node& node, InlinedVector<std::reference_wrapper<Node>>& nodes_to_fuse) const;
 
   MatchResult CheckSecondFormula(Graph& graph, Node& nodes, InlinedVector<std::reference_wrapper<Node>>& nodes_to_fuse) const;
+
+  std::string fused_domain_;
 };
 
 }  // namespace onnxruntime
@@ -3,6 +3,7 @@
 
 #include "core/optimizer/initializer.h"
 #include "core/optimizer/gemm_activation_fusion.h"
+#include "core/optimizer/utils.h"
 #include "core/graph/graph_utils.h"
 
 using namespace ONNX_NAMESPACE;
@@ -21,7 +22,8 @@ bool IsSupportedOptypeVersionAndDomain(const Node& node, const std::string& op_t
 // If the op has multiple versions, here we require it must have a single implementation that can work across all the
 // versions. Because in the fusion, we discarded the op version information.
 bool IsFusableActivation(const Node& node) {
-  return IsSupportedOptypeVersionAndDomain(node, "Elu", {6}, kOnnxDomain) ||
+  return optimizer_utils::IsMlasFusableGeluActivation(node) ||
+         IsSupportedOptypeVersionAndDomain(node, "Elu", {6}, kOnnxDomain) ||
          IsSupportedOptypeVersionAndDomain(node, "HardSigmoid", {6}, kOnnxDomain) ||
          IsSupportedOptypeVersionAndDomain(node, "LeakyRelu", {6}, kOnnxDomain) ||
          IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13, 14}, kOnnxDomain) ||
@@ -5,6 +5,7 @@
 #include "core/optimizer/rule_based_graph_transformer.h"
 
 #include <memory>
+#include <string>
 #include <utility>
 
 using namespace onnxruntime;
@@ -39,8 +40,25 @@ common::Status GraphTransformerManager::ApplyTransformers(Graph& graph, Transfor
       if (step > 0 && transformer->ShouldOnlyApplyOnce())
         continue;
 
+      const bool profile = profiler_ != nullptr && profiler_->IsEnabled();
+      TimePoint tp;
+      int num_nodes_before = 0;
+      if (profile) {
+        num_nodes_before = graph.NumberOfNodes();
+        tp = profiler_->Start();
+      }
+
       bool modified = false;
       ORT_RETURN_IF_ERROR(transformer->Apply(graph, modified, logger));
+
+      if (profile) {
+        profiler_->EndTimeAndRecordEvent(profiling::SESSION_EVENT, transformer->Name(), tp,
+                                         {{"level", std::to_string(static_cast<int>(level))},
+                                          {"step", std::to_string(step)},
+                                          {"modified", modified ? "1" : "0"},
+                                          {"num_nodes_before", std::to_string(num_nodes_before)},
+                                          {"num_nodes_after", std::to_string(graph.NumberOfNodes())}});
+      }
       graph_changed = graph_changed || modified;
       _is_graph_modified = _is_graph_modified || modified;
     }
@@ -5,6 +5,7 @@
 
 #include "core/common/inlined_containers.h"
 #include "core/common/logging/logging.h"
+#include "core/common/profiler.h"
 #include "core/optimizer/graph_transformer.h"
 #include "core/optimizer/constant_folding.h"
 #include "core/optimizer/rewrite_rule.h"
@@ -34,6 +35,11 @@ class GraphTransformerManager {
     return check_load_cancellation_fn_ && check_load_cancellation_fn_();
   }
 
+  // Set the profiler that records an event for every transformer pass while it is enabled
+  void SetProfiler(profiling::Profiler* profiler) noexcept {
+    profiler_ = profiler;
+  }
+
   // Register a transformer with a level.
   common::Status Register(std::unique_ptr<GraphTransformer> transformer, TransformerLevel level);
 
@@ -54,6 +60,7 @@ class GraphTransformerManager {
   InlinedHashMap<TransformerLevel, InlinedVector<std::unique_ptr<GraphTransformer>>> level_to_transformer_map_;
   InlinedHashMap<std::string, GraphTransformer*> transformers_info_;
   CheckLoadCancellationFn check_load_cancellation_fn_;
+  profiling::Profiler* profiler_ = nullptr;
   mutable bool _is_graph_modified = false;
 };
 }  // namespace onnxruntime
@@ -57,6 +57,8 @@
 #include "core/optimizer/matmul_integer_to_float.h"
 #include "core/optimizer/matmul_scale_fusion.h"
 #include "core/optimizer/matmul_transpose_fusion.h"
+#include "core/optimizer/my_cpu_attention_fusion.h"
+#include "core/optimizer/my_cpu_bias_gelu_fusion.h"
 #include "core/optimizer/nchwc_transformer.h"
 #include "core/optimizer/noop_elimination.h"
 #include "core/optimizer/not_where_fusion.h"
@@ -217,7 +219,6 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
                                                         onnxruntime::kAclExecutionProvider};
 #endif
   const InlinedHashSet<std::string_view> no_limit_empty_ep_list = {};
-  const InlinedHashSet<std::string_view> dml_ep = {onnxruntime::kDmlExecutionProvider};
   AllocatorPtr cpu_allocator = CPUAllocator::DefaultInstance();
 
   switch (level) {
@@ -302,6 +303,10 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
                                                             QDQIsInt8Allowed() ? "1" : "0") == "1";
       const bool enable_gelu_approximation =
           session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableGeluApproximation, "0") == "1";
+      const std::string fast_gelu_fusion_domain =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsFastGeluFusionDomain, kMSDomain);
+      const bool enable_matmul_activation_fusion =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableMatMulActivationFusion, "0") == "1";
 
       const InlinedHashSet<std::string_view> cuda_eps = {onnxruntime::kCudaExecutionProvider};
 
@@ -314,6 +319,9 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
                                                                       onnxruntime::kCudaExecutionProvider,
                                                                       onnxruntime::kRocmExecutionProvider,
                                                                       onnxruntime::kDmlExecutionProvider};
+      const InlinedHashSet<std::string_view> dml_eps = {onnxruntime::kDmlExecutionProvider};
+      const InlinedHashSet<std::string_view> cpu_dml_eps = {onnxruntime::kCpuExecutionProvider,
+                                                            onnxruntime::kDmlExecutionProvider};
       const InlinedHashSet<std::string_view> cpu_acl_cuda_dml_rocm_eps = {onnxruntime::kCpuExecutionProvider,
                                                                           onnxruntime::kAclExecutionProvider,
                                                                           onnxruntime::kCudaExecutionProvider,
@@ -368,6 +376,9 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       transformers.emplace_back(std::make_unique<LayerNormFusion>(cpu_acl_cuda_dml_rocm_eps, level));
       transformers.emplace_back(std::make_unique<SimplifiedLayerNormFusion>(cpu_cuda_rocm_eps));
       transformers.emplace_back(std::make_unique<AttentionFusion>(cpu_acl_cuda_dml_rocm_eps));
+      // Picks up the per-head attention core left by AttentionFusion. Must run before MatmulTransposeFusion
+      // folds the K transpose into a FusedMatMul.
+      transformers.emplace_back(std::make_unique<MyCpuAttentionFusion>(cpu_ep));
       transformers.emplace_back(std::make_unique<EmbedLayerNormFusion>(cpu_acl_cuda_dml_rocm_eps));
       transformers.emplace_back(std::make_unique<GatherSliceToSplitFusion>(cpu_cuda_rocm_eps));
       transformers.emplace_back(std::make_unique<GatherToSliceFusion>(cpu_cuda_rocm_eps));
@@ -378,7 +389,9 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       // to cleanup the remaining MatMul-Add that were part of the attention pattern but not detected or fused.
       transformers.emplace_back(std::make_unique<MatMulAddFusion>(no_limit_empty_ep_list, false));
       transformers.emplace_back(std::make_unique<SkipLayerNormFusion>(cpu_acl_cuda_dml_rocm_eps));
-      transformers.emplace_back(std::make_unique<FastGeluFusion>(cpu_cuda_dml_rocm_eps));
+      transformers.emplace_back(std::make_unique<FastGeluFusion>(cpu_cuda_dml_rocm_eps, fast_gelu_fusion_domain));
+      // Runs after FastGeluFusion so that fused com.my_virtual_npu FastGelu nodes can absorb their bias Add.
+      transformers.emplace_back(std::make_unique<MyCpuBiasGeluFusion>(cpu_ep));
       transformers.emplace_back(std::make_unique<QuickGeluFusion>(cpu_acl_cuda_dml_rocm_eps));
 
       // GeluApproximation has side effects which may change results. It needs to be manually enabled,
@@ -405,7 +418,8 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
 #endif
 
       transformers.emplace_back(std::make_unique<MatMulScaleFusion>(cpu_acl_cuda_dml_rocm_eps));
-      transformers.emplace_back(std::make_unique<MatMulActivationFusion>(dml_ep));
+      transformers.emplace_back(
+          std::make_unique<MatMulActivationFusion>(enable_matmul_activation_fusion ? cpu_dml_eps : dml_eps));
 
 #ifdef MLAS_TARGET_AMD64_IX86
       if (avx2_precision_mode) {
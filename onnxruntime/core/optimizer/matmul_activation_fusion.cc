@@ -3,6 +3,7 @@
 
 #include "core/optimizer/initializer.h"
 #include "core/optimizer/matmul_activation_fusion.h"
+#include "core/optimizer/utils.h"
 #include "core/graph/graph_utils.h"
 
 using namespace ONNX_NAMESPACE;
@@ -20,9 +21,29 @@ bool IsSupportedOptypeVersionAndDomain(const Node& node, const std::string& op_t
 
 // If the op has multiple versions, here we require it must have a single implementation that can work across all the
 // versions. Because in the fusion, we discarded the op version information.
-bool IsFusableActivation(const Node& node) {
+bool IsFusableActivation(const Node& node, std::string_view provider_type) {
+  if (provider_type == kCpuExecutionProvider) {
+    // the CPU kernel applies the activation with MLAS, see GetMlasActivation
+    return optimizer_utils::IsMlasFusableGeluActivation(node) ||
+           IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13, 14}, kOnnxDomain) ||
+           IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6, 13}, kOnnxDomain) ||
+           IsSupportedOptypeVersionAndDomain(node, "Tanh", {6, 13}, kOnnxDomain);
+  }
   return IsSupportedOptypeVersionAndDomain(node, "Softmax", {1, 11, 13}, kOnnxDomain);
 }
+
+// The CPU kernel also fuses the activation into a plain float MatMul, which is FusedMatMul with the default attributes.
+bool IsFusableMatMul(const Node& node) {
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "FusedMatMul", {1}, kMSDomain)) {
+    return true;
+  }
+  if (node.GetExecutionProviderType() != kCpuExecutionProvider ||
+      !graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", {1, 9, 13})) {
+    return false;
+  }
+  const auto* type = node.OutputDefs()[0]->TypeAsProto();
+  return type != nullptr && type->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_FLOAT;
+}
 }  // namespace
 
 Status MatMulActivationFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
@@ -38,13 +59,13 @@ Status MatMulActivationFusion::ApplyImpl(Graph& graph, bool& modified, int graph
     auto& node = *node_ptr;
     ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
 
-    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "FusedMatMul", {1}, kMSDomain) ||
+    if (!IsFusableMatMul(node) ||
         !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) || node.GetOutputEdgesCount() != 1) {
       continue;
     }
 
     const Node& next_node = *(node.OutputNodesBegin());
-    if (!IsFusableActivation(next_node) || next_node.GetExecutionProviderType() != node.GetExecutionProviderType()) {
+    if (!IsFusableActivation(next_node, node.GetExecutionProviderType()) || next_node.GetExecutionProviderType() != node.GetExecutionProviderType()) {
       continue;
     }
 
@@ -0,0 +1,239 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/my_cpu_attention_fusion.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// Mask values at or below this are treated as -inf, matching the -10000 used by exported GPT-2 models.
+constexpr float kMaskedValueThreshold = -10000.0f;
+
+bool IsFloatTensor(const NodeArg& arg) {
+  const auto* type = arg.Type();
+  return type != nullptr && *type == "tensor(float)";
+}
+
+bool HasRank(const NodeArg& arg, int rank) {
+  const auto* shape = arg.Shape();
+  return shape != nullptr && shape->dim_size() == rank;
+}
+
+// Returns true when `mask` is a constant float initializer of shape [1, ..., 1, W, W] (rank 2 to 4) holding
+// an additive causal mask: 0 on and below the diagonal, <= kMaskedValueThreshold above it.
+bool IsAdditiveCausalMask(const Graph& graph, const NodeArg& mask) {
+  if (!graph_utils::IsConstantInitializer(graph, mask.Name(), true) || !IsFloatTensor(mask)) {
+    return false;
+  }
+
+  const auto* shape = mask.Shape();
+  if (shape == nullptr || shape->dim_size() < 2 || shape->dim_size() > 4) {
+    return false;
+  }
+
+  const int rank = shape->dim_size();
+  for (int i = 0; i < rank; ++i) {
+    if (!utils::HasDimValue(shape->dim(i))) {
+      return false;
+    }
+  }
+
+  for (int i = 0; i < rank - 2; ++i) {
+    if (shape->dim(i).dim_value() != 1) {
+      return false;
+    }
+  }
+
+  const int64_t w = shape->dim(rank - 1).dim_value();
+  if (shape->dim(rank - 2).dim_value() != w) {
+    return false;
+  }
+
+  const TensorProto* tensor_proto = graph_utils::GetConstantInitializer(graph, mask.Name());
+  if (tensor_proto == nullptr) {
+    return false;
+  }
+
+  Initializer initializer(graph, *tensor_proto, graph.ModelPath());
+  const auto data = initializer.DataAsSpan<float>();
+  if (data.size() != static_cast<size_t>(w * w)) {
+    return false;
+  }
+
+  const float* p = data.data();
+  for (int64_t i = 0; i < w; ++i) {
+    for (int64_t j = 0; j < w; ++j, ++p) {
+      if (j <= i ? *p != 0.0f : *p > kMaskedValueThreshold) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+bool IsSameProvider(const Node& a, const Node& b) {
+  return a.GetExecutionProviderType() == b.GetExecutionProviderType();
+}
+
+}  // namespace
+
+Status MyCpuAttentionFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                       const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    // Anchor on the Softmax over the key axis.
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Softmax", {1, 11, 13}) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) ||
+        !optimizer_utils::CheckOutputEdges(graph, node, 1) ||
+        !IsFloatTensor(*node.InputDefs()[0]) ||
+        !HasRank(*node.InputDefs()[0], 4)) {
+      continue;
+    }
+
+    const int64_t default_axis = node.SinceVersion() >= 13 ? -1 : 1;
+    const int64_t axis = graph_utils::GetNodeAttribute(node, "axis") != nullptr
+                             ? graph_utils::GetNodeAttribute(node, "axis")->i()
+                             : default_axis;
+    if (axis != -1 && axis != 3) {
+      continue;
+    }
+
+    Node& softmax_node = node;
+    InlinedVector<Node*> nodes_to_remove;
+
+    // Optional Add of a constant causal mask.
+    bool is_unidirectional = false;
+    const Node* softmax_input = graph_utils::GetInputNode(softmax_node, 0);
+    if (softmax_input == nullptr) {
+      continue;
+    }
+
+    Node* scores_node = graph.GetNode(softmax_input->Index());
+
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(*scores_node, "Add", {7, 13, 14})) {
+      const auto* upstream = graph_utils::GetInputNode(*scores_node, 0);
+      if (upstream == nullptr || !IsSameProvider(*scores_node, softmax_node) ||
+          !optimizer_utils::CheckOutputEdges(graph, *scores_node, 1) ||
+          !IsAdditiveCausalMask(graph, *scores_node->InputDefs()[1])) {
+        continue;
+      }
+
+      is_unidirectional = true;
+      nodes_to_remove.push_back(scores_node);
+      scores_node = graph.GetNode(upstream->Index());
+    }
+
+    // Optional Div or Mul by a scalar constant.
+    float scale = 1.0f;
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(*scores_node, "Div", {7, 13, 14}) ||
+        graph_utils::IsSupportedOptypeVersionAndDomain(*scores_node, "Mul", {7, 13, 14})) {
+      const auto* upstream = graph_utils::GetInputNode(*scores_node, 0);
+      float value = 0.0f;
+      if (upstream == nullptr || !IsSameProvider(*scores_node, softmax_node) ||
+          !optimizer_utils::CheckOutputEdges(graph, *scores_node, 1) ||
+          !optimizer_utils::GetScalarInitializerValue(graph, *scores_node->InputDefs()[1], value, true) ||
+          value == 0.0f) {
+        continue;
+      }
+
+      scale = scores_node->OpType() == "Div" ? 1.0f / value : value;
+      nodes_to_remove.push_back(scores_node);
+      scores_node = graph.GetNode(upstream->Index());
+    }
+
+    // MatMul(Q, Transpose(K, perm=[0,1,3,2])).
+    Node& qk_matmul = *scores_node;
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(qk_matmul, "MatMul", {1, 9, 13}) ||
+        !IsSameProvider(qk_matmul, softmax_node) ||
+        !optimizer_utils::CheckOutputEdges(graph, qk_matmul, 1)) {
+      continue;
+    }
+
+    const Node* k_transpose = graph_utils::GetInputNode(qk_matmul, 1);
+    if (k_transpose == nullptr ||
+        !graph_utils::IsSupportedOptypeVersionAndDomain(*k_transpose, "Transpose", {1, 13, 21}) ||
+        !IsSameProvider(*k_transpose, softmax_node) ||
+        !optimizer_utils::IsAttributeWithExpectedValues(*k_transpose, "perm", {0, 1, 3, 2}) ||
+        graph.NodeProducesGraphOutput(*k_transpose)) {
+      continue;
+    }
+
+    NodeArg* query = qk_matmul.MutableInputDefs()[0];
+    NodeArg* key = graph.GetNode(k_transpose->Index())->MutableInputDefs()[0];
+    if (!HasRank(*query, 4) || !HasRank(*key, 4)) {
+      continue;
+    }
+
+    // Softmax(...) -> MatMul(., V) -> Transpose(perm=[0,2,1,3]).
+    Node& pv_matmul = *graph.GetNode(softmax_node.OutputNodesBegin()->Index());
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(pv_matmul, "MatMul", {1, 9, 13}) ||
+        !IsSameProvider(pv_matmul, softmax_node) ||
+        pv_matmul.InputDefs()[0] != softmax_node.OutputDefs()[0] ||
+        !optimizer_utils::CheckOutputEdges(graph, pv_matmul, 1)) {
+      continue;
+    }
+
+    NodeArg* value = pv_matmul.MutableInputDefs()[1];
+    if (!HasRank(*value, 4)) {
+      continue;
+    }
+
+    Node& output_transpose = *graph.GetNode(pv_matmul.OutputNodesBegin()->Index());
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(output_transpose, "Transpose", {1, 13, 21}) ||
+        !IsSameProvider(output_transpose, softmax_node) ||
+        !optimizer_utils::IsAttributeWithExpectedValues(output_transpose, "perm", {0, 2, 1, 3})) {
+      continue;
+    }
+
+    Node& attention_node = graph.AddNode(graph.GenerateNodeName("Attention"),
+                                         "Attention",
+                                         "fused attention",
+                                         {query, key, value},
+                                         {output_transpose.MutableOutputDefs()[0]},
+                                         nullptr,
+                                         kMyCustomDomain);
+    attention_node.AddAttribute("scale", scale);
+    attention_node.AddAttribute("unidirectional", static_cast<int64_t>(is_unidirectional ? 1 : 0));
+
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    attention_node.SetExecutionProviderType(softmax_node.GetExecutionProviderType());
+
+    nodes_to_remove.push_back(&qk_matmul);
+    nodes_to_remove.push_back(&softmax_node);
+    nodes_to_remove.push_back(&pv_matmul);
+    nodes_to_remove.push_back(&output_transpose);
+
+    // The K transpose may be shared with another consumer (e.g. a present-key output).
+    if (k_transpose->GetOutputEdgesCount() == 1) {
+      nodes_to_remove.push_back(graph.GetNode(k_transpose->Index()));
+    }
+
+    for (Node* n : nodes_to_remove) {
+      graph_utils::RemoveNodeOutputEdges(graph, *n);
+      graph.RemoveNode(n->Index());
+    }
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class MyCpuAttentionFusion
+Fuse the per-head attention core of an exported GPT-2 block
+
+    MatMul(Q, Transpose(K, perm=[0,1,3,2])) -> [Div|Mul scale] -> [Add causal mask] -> Softmax
+        -> MatMul(., V) -> Transpose(perm=[0,2,1,3])
+
+into a single Attention (com.my_virtual_npu) node that runs on MlasFlashAttention. A constant additive
+mask that is 0 on and below the diagonal and large negative above it becomes unidirectional=1.
+*/
+class MyCpuAttentionFusion : public GraphTransformer {
+ public:
+  MyCpuAttentionFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("MyCpuAttentionFusion", compatible_execution_providers) {
+  }
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/my_cpu_bias_gelu_fusion.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+Status MyCpuBiasGeluFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                      const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7, 13, 14}) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) ||
+        !optimizer_utils::CheckOutputEdges(graph, node, 1)) {
+      continue;
+    }
+
+    // The kernel only supports float.
+    const auto* add_type = node.InputDefs()[0]->Type();
+    if (add_type == nullptr || *add_type != "tensor(float)") {
+      continue;
+    }
+
+    // One Add input must be the MatMul output and the other a 1D bias matching its last dimension.
+    const TensorShapeProto* input1_shape = node.InputDefs()[0]->Shape();
+    const TensorShapeProto* input2_shape = node.InputDefs()[1]->Shape();
+    if (input1_shape == nullptr ||
+        input2_shape == nullptr ||
+        input1_shape->dim_size() < 1 ||
+        input2_shape->dim_size() < 1) {
+      continue;
+    }
+
+    if (input1_shape->dim(input1_shape->dim_size() - 1) != input2_shape->dim(input2_shape->dim_size() - 1)) {
+      continue;
+    }
+
+    int data_index = -1;
+    if (input2_shape->dim_size() == 1 && input1_shape->dim_size() > 1) {
+      data_index = 0;
+    } else if (input1_shape->dim_size() == 1 && input2_shape->dim_size() > 1) {
+      data_index = 1;
+    } else {
+      continue;
+    }
+
+    const Node* matmul_node = graph_utils::GetInputNode(node, data_index);
+    if (matmul_node == nullptr ||
+        !graph_utils::IsSupportedOptypeVersionAndDomain(*matmul_node, "MatMul", {1, 9, 13}) ||
+        matmul_node->GetExecutionProviderType() != node.GetExecutionProviderType()) {
+      continue;
+    }
+
+    const Node& next_node = *node.OutputNodesBegin();
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(next_node, "FastGelu", {1}, kMyCustomDomain) ||
+        next_node.GetExecutionProviderType() != node.GetExecutionProviderType()) {
+      continue;
+    }
+
+    if (graph.NodeProducesGraphOutput(node)) {
+      continue;
+    }
+
+    Node& add_node = node;
+    Node& gelu_node = const_cast<Node&>(next_node);
+
+    InlinedVector<NodeArg*> bias_gelu_input{add_node.MutableInputDefs()[data_index],
+                                            add_node.MutableInputDefs()[1 - data_index]};
+
+    Node& bias_gelu_node = graph.AddNode(graph.GenerateNodeName("BiasGelu"),
+                                         "BiasGelu",
+                                         "fused Add and FastGelu",
+                                         bias_gelu_input,
+                                         {},
+                                         {},
+                                         kMyCustomDomain);
+
+    // Assign provider to this new node. Provider should be same as the provider for old node.
+    bias_gelu_node.SetExecutionProviderType(gelu_node.GetExecutionProviderType());
+
+    // move output definitions and edges from gelu_node to bias_gelu_node
+    // delete add_node and gelu_node.
+    graph_utils::FinalizeNodeFusion(graph, {add_node, gelu_node}, bias_gelu_node);
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+}  // namespace onnxruntime
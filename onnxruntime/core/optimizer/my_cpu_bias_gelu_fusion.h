@@ -0,0 +1,24 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class MyCpuBiasGeluFusion
+Fuse MatMul -> Add(bias) -> FastGelu (com.my_virtual_npu) into MatMul -> BiasGelu (com.my_virtual_npu),
+so the biased MLP intermediate produced by the Add is never written out.
+*/
+class MyCpuBiasGeluFusion : public GraphTransformer {
+ public:
+  MyCpuBiasGeluFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("MyCpuBiasGeluFusion", compatible_execution_providers) {
+  }
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
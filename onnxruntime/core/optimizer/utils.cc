@@ -301,6 +301,23 @@ bool IsOperationDeterministic(const std::string& domain, const std::string& op)
   return false;
 }
 
+bool IsMlasFusableGeluActivation(const Node& node) {
+  // The fused nodes have no attribute for the approximation of ONNX Gelu, so only the exact form is fused.
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gelu", {20}, kOnnxDomain)) {
+    return node.GetAttributes().empty();
+  }
+#ifndef DISABLE_CONTRIB_OPS
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "FastGelu", {1}, kMSDomain)) {
+    // the bias input is not fused
+    return node.InputDefs().size() < 2 || !node.InputDefs()[1]->Exists();
+  }
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gelu", {1}, kMSDomain) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "QuickGelu", {1}, kMSDomain);
+#else
+  return false;
+#endif
+}
+
 #endif  // #if !defined(ORT_MINIMAL_BUILD)
 
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
@@ -150,6 +150,11 @@ void MergeMatMulWeightsByBlocks(const T* q_weight, const T* k_weight, const T* v
 
 bool IsOperationDeterministic(const std::string& domain, const std::string& op);
 
+/** Check whether node is a GELU variant that the CPU FusedGemm and FusedMatMulActivation kernels apply
+    to their output with MLAS, see GetMlasActivation in core/providers/cpu/math/gemm_matmul_common.h.
+*/
+bool IsMlasFusableGeluActivation(const Node& node);
+
 template <typename T>
 bool GetScalarInitializerValue(const onnxruntime::Graph& graph, const onnxruntime::NodeArg& input_arg, T& value,
                                bool is_constant);
@@ -83,6 +83,10 @@ struct ThreadOptions {
   // The process that owns the thread may consider setting its affinity.
   std::vector<LogicalProcessors> affinities;
 
+  // NUMA node of each entry of affinities, or empty if the pool is not NUMA aware. A NUMA aware pool keeps work
+  // stealing within a node while the node has work, and can partition loops by node.
+  std::vector<int> numa_nodes;
+
   // Set or unset denormal as zero.
   bool set_denormal_as_zero = false;
 
@@ -146,6 +150,11 @@ class Env {
 
   virtual std::vector<LogicalProcessors> GetDefaultThreadAffinities() const = 0;
 
+  /// \brief Returns the NUMA node of a logical processor, or 0 if it is unknown.
+  virtual int GetNumaNodeOfLogicalProcessor(int /*logical_processor*/) const {
+    return 0;
+  }
+
   virtual int GetL2CacheSize() const = 0;
 
   /// \brief Returns the number of micro-seconds since the Unix epoch.
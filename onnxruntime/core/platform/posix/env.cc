@@ -31,6 +31,7 @@ limitations under the License.
 #endif
 #include <unistd.h>
 
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
 #include <optional>
@@ -300,6 +301,24 @@ class PosixEnv : public Env {
     return ret;
   }
 
+  int GetNumaNodeOfLogicalProcessor(int logical_processor) const override {
+#if defined(__linux__)
+    // sysfs links the node of a processor as /sys/devices/system/cpu/cpu<N>/node<M>
+    std::error_code ec;
+    const std::filesystem::path cpu_dir{"/sys/devices/system/cpu/cpu" + std::to_string(logical_processor)};
+    for (std::filesystem::directory_iterator it{cpu_dir, ec}, end; !ec && it != end; it.increment(ec)) {
+      const std::string name = it->path().filename().string();
+      if (name.size() > 4 && name.compare(0, 4, "node") == 0 &&
+          std::all_of(name.begin() + 4, name.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+        return std::stoi(name.substr(4));
+      }
+    }
+#else
+    ORT_UNUSED_PARAMETER(logical_processor);
+#endif
+    return 0;
+  }
+
   int GetL2CacheSize() const override {
 #ifdef _SC_LEVEL2_CACHE_SIZE
     return static_cast<int>(sysconf(_SC_LEVEL2_CACHE_SIZE));
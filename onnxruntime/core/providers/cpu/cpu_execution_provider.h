@@ -11,6 +11,10 @@ namespace onnxruntime {
 // Information needed to construct CPU execution providers.
 struct CPUExecutionProviderInfo {
   bool create_arena{true};
+  // see kOrtSessionOptionsCpuArenaThreadLocalCacheBytes. -1 uses the arena default.
+  int64_t arena_thread_local_cache_bytes{-1};
+  // see kOrtSessionOptionsCpuArenaHugePages. -1 uses the arena default.
+  int arena_huge_pages{-1};
 
   explicit CPUExecutionProviderInfo(bool use_arena)
       : create_arena(use_arena) {}
@@ -5,9 +5,11 @@
 
 #include <memory>
 
+#include "core/common/parse_string.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/providers/cpu/cpu_provider_factory_creator.h"
 #include "core/session/abi_session_options_impl.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/session/ort_apis.h"
 
 namespace onnxruntime {
@@ -33,6 +35,10 @@ std::unique_ptr<IExecutionProvider> CpuProviderFactory::CreateProvider(const Ort
                                                                        const OrtLogger& session_logger) {
   CPUExecutionProviderInfo info;
   info.create_arena = session_options.value.enable_cpu_mem_arena;
+  info.arena_thread_local_cache_bytes = ParseStringWithClassicLocale<int64_t>(
+      session_options.value.config_options.GetConfigOrDefault(kOrtSessionOptionsCpuArenaThreadLocalCacheBytes, "-1"));
+  info.arena_huge_pages = ParseStringWithClassicLocale<int>(
+      session_options.value.config_options.GetConfigOrDefault(kOrtSessionOptionsCpuArenaHugePages, "-1"));
 
   auto cpu_ep = std::make_unique<CPUExecutionProvider>(info);
   cpu_ep->SetLogger(reinterpret_cast<const logging::Logger*>(&session_logger));
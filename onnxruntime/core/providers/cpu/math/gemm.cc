@@ -140,6 +140,57 @@ bool GemmPackBFp32(AllocatorPtr& alloc,
   return true;
 }
 
+NodeAttributes GetFusedActivationAttributes(const Node& node) {
+  constexpr std::string_view kActivationNamePrefix = "activation_";
+
+  NodeAttributes attrs;
+  for (const auto& p : node.GetAttributes()) {
+    if (p.first.size() > kActivationNamePrefix.size() &&
+        p.first.compare(0, kActivationNamePrefix.size(), kActivationNamePrefix) == 0) {
+      attrs[p.first.substr(kActivationNamePrefix.size())] = p.second;
+    }
+  }
+  return attrs;
+}
+
+static float GetFloatAttribute(const NodeAttributes& attrs, const std::string& name, float default_value) {
+  auto it = attrs.find(name);
+  return it != attrs.end() ? it->second.f() : default_value;
+}
+
+bool GetMlasActivation(const std::string& activation, const NodeAttributes& activation_attrs,
+                       MLAS_ACTIVATION& mlas_activation) {
+  if (activation == "Relu") {
+    mlas_activation.ActivationKind = MlasReluActivation;
+  } else if (activation == "LeakyRelu") {
+    mlas_activation.ActivationKind = MlasLeakyReluActivation;
+    mlas_activation.Parameters.LeakyRelu.alpha = GetFloatAttribute(activation_attrs, "alpha", 0.01f);
+  } else if (activation == "Tanh") {
+    mlas_activation.ActivationKind = MlasTanhActivation;
+  } else if (activation == "Sigmoid") {
+    mlas_activation.ActivationKind = MlasLogisticActivation;
+  } else if (activation == "HardSigmoid") {
+    mlas_activation.ActivationKind = MlasHardSigmoidActivation;
+    mlas_activation.Parameters.HardSigmoid.alpha = GetFloatAttribute(activation_attrs, "alpha", 0.2f);
+    mlas_activation.Parameters.HardSigmoid.beta = GetFloatAttribute(activation_attrs, "beta", 0.5f);
+  } else if (activation == "Gelu") {
+    mlas_activation.ActivationKind = MlasGeluErfActivation;
+  } else if (activation == "FastGelu") {
+    mlas_activation.ActivationKind = MlasGeluTanhActivation;
+  } else if (activation == "QuickGelu") {
+    const float alpha = GetFloatAttribute(activation_attrs, "alpha", 1.702f);
+    if (alpha == 1.0f) {
+      mlas_activation.ActivationKind = MlasSiluActivation;
+    } else {
+      mlas_activation.ActivationKind = MlasQuickGeluActivation;
+      mlas_activation.Parameters.QuickGelu.alpha = alpha;
+    }
+  } else {
+    return false;
+  }
+  return true;
+}
+
 template <typename T>
 void Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
                           ptrdiff_t M, ptrdiff_t N, ptrdiff_t K,
@@ -200,16 +251,17 @@ void Gemm_MLFloat16(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
 
   if (c_data == nullptr)
     beta = onnxruntime::MLFloat16::Zero;
-#ifdef MLAS_F16VEC_INTRINSICS_SUPPORTED
   bool support_mlas = false;
   if (c_shape == nullptr) {
     support_mlas = true;
   } else if (c_shape->NumDimensions() == 1 && (*c_shape)[0] == N) {
     support_mlas = true;
-  } else if (c_shape->NumDimensions() == 2 && (((*c_shape)[0] == 1 && (*c_shape)[1] == N) || ((*c_shape)[0] == N && (*c_shape)[1] == 1))) {
+  } else if (c_shape->NumDimensions() == 2 && (*c_shape)[0] == 1 && (*c_shape)[1] == N) {
+    // MLAS adds the bias to every row, so a column vector bias of shape (M, 1) takes the Eigen path
     support_mlas = true;
   }
-  if (trans_a == CblasNoTrans && trans_b == CblasNoTrans && support_mlas && alpha.ToFloat() == 1.0 && beta.ToFloat() == 1.0) {
+  if (trans_a == CblasNoTrans && trans_b == CblasNoTrans && support_mlas && alpha.ToFloat() == 1.0 && beta.ToFloat() == 1.0 &&
+      MlasHalfGemmSupported()) {
     MLAS_HALF_GEMM_DATA_PARAMS data;
     data.A = a_data;
     data.lda = K;
@@ -223,7 +275,6 @@ void Gemm_MLFloat16(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
     MlasHalfGemmBatch(M, N, K, 1, &data, thread_pool);
     return;
   }
-#endif
   // Fallback to Eigen
   // Broadcast the bias as needed if bias is given
   GemmBroadcastBias(M, N, beta, c_data, c_shape, y_data);
@@ -431,31 +482,47 @@ Status Gemm<float>::Compute(OpKernelContext* context) const {
   const float* c_data = C != nullptr ? C->Data<float>() : nullptr;
   const TensorShape* c_shape = C != nullptr ? &C->Shape() : nullptr;
 
-  if (B) {
+  // A fused activation is applied by MLAS to each tile of the output, which needs the MLAS data parameters.
+  const bool use_output_processor = mlas_activation_.has_value() && K > 0;
+
+  if (B && !use_output_processor) {
     ComputeGemm(trans_A_, trans_B_, M, N, K, alpha_, A->Data<float>(), B->Data<float>(), beta_,
                 c_data, c_shape, y_data, thread_pool);
   } else {
     GemmBroadcastBias(M, N, beta_, c_data, c_shape, y_data);
     if (K > 0) {
-      MlasGemm(
-          trans_A_,
-          static_cast<size_t>(M),
-          static_cast<size_t>(N),
-          static_cast<size_t>(K),
-          alpha_,
-          A->Data<float>(),
-          static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K),
-          packed_b_.get(),
-          c_data != nullptr ? beta_ : 0.0f,
-          y_data,
-          static_cast<size_t>(N),
-          thread_pool);
+      MLAS_SGEMM_DATA_PARAMS data;
+      data.A = A->Data<float>();
+      data.lda = static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K);
+      if (B) {
+        data.B = B->Data<float>();
+        data.ldb = static_cast<size_t>(trans_B_ != CblasNoTrans ? K : N);
+      } else {
+        data.B = static_cast<const float*>(packed_b_.get());
+        data.BIsPacked = true;
+      }
+      data.C = y_data;
+      data.ldc = static_cast<size_t>(N);
+      data.alpha = alpha_;
+      data.beta = c_data != nullptr ? beta_ : 0.0f;
+
+      std::optional<MLAS_GEMM_ACTIVATION_PROCESSOR> output_processor;
+      if (mlas_activation_.has_value()) {
+        data.OutputProcessor = &output_processor.emplace(*mlas_activation_);
+      }
+
+      MlasGemm(trans_A_, B ? trans_B_ : CblasTrans, static_cast<size_t>(M), static_cast<size_t>(N),
+               static_cast<size_t>(K), data, thread_pool);
     } else if (beta_ == 0 || c_data == nullptr) {
       EigenMatrixMapRowMajor<float> dest(y_data, narrow<Eigen::Index>(M), narrow<Eigen::Index>(N));
       dest.setZero();
     }
   }
 
+  if (mlas_activation_.has_value() && K == 0) {
+    MlasActivation(&*mlas_activation_, y_data, nullptr, 1, SafeInt<size_t>(M) * N, SafeInt<size_t>(M) * N);
+  }
+
   ComputeActivation(y_data, SafeInt<size_t>(M) * N, thread_pool);
 
   return Status::OK();
@@ -3,7 +3,10 @@
 
 #pragma once
 
+#include <string>
+
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
 
@@ -14,4 +17,13 @@ bool GemmPackBFp32(AllocatorPtr& alloc,
                    IAllocatorUniquePtr<void>& packed_b,
                    size_t& packed_b_size,
                    TensorShape& b_shape);
+
+// Returns the attributes of the activation fused into a FusedGemm or FusedMatMulActivation node, which are stored
+// on the node with the "activation_" prefix.
+NodeAttributes GetFusedActivationAttributes(const Node& node);
+
+// Returns true if MLAS implements `activation`, and sets `mlas_activation` to it.
+// MLAS applies such activations to each tile of the GEMM output while the tile is still in the cache.
+bool GetMlasActivation(const std::string& activation, const NodeAttributes& activation_attrs,
+                       MLAS_ACTIVATION& mlas_activation);
 };  // namespace onnxruntime
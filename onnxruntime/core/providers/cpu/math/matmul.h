@@ -3,8 +3,12 @@
 
 #pragma once
 
+#include <optional>
+#include <string>
+
 #include "core/framework/op_kernel.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/providers/cpu/math/gemm_matmul_common.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 
 namespace onnxruntime {
@@ -17,6 +21,10 @@ class MatMul final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 };
 
+// MLFloat16 is computed by MlasHalfGemmBatch, registered only when MlasHalfGemmSupported()
+template <>
+Status MatMul<MLFloat16>::Compute(OpKernelContext* context) const;
+
 template <>
 class MatMul<float> final : public OpKernel {
  public:
@@ -30,6 +38,14 @@ class MatMul<float> final : public OpKernel {
     trans_batch_a_ = trans_batch_a_attr != 0;
     trans_batch_b_ = trans_batch_b_attr != 0;
 
+    std::string activation;
+    if (info.GetAttr<std::string>("activation", &activation).IsOK()) {
+      MLAS_ACTIVATION mlas_activation;
+      ORT_ENFORCE(GetMlasActivation(activation, GetFusedActivationAttributes(info.node()), mlas_activation),
+                  "Unsupported activation for FusedMatMulActivation: ", activation);
+      activation_ = mlas_activation;
+    }
+
 #if defined(__aarch64__) && defined(__linux__)
     auto config_ops = info.GetConfigOptions().GetConfigEntry(kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16);
     use_fastmath_mode_ = (config_ops == "1") && MlasBf16AccelerationSupported();
@@ -56,6 +72,9 @@ class MatMul<float> final : public OpKernel {
   bool trans_batch_a_;
   bool trans_batch_b_;
 
+  // For FusedMatMulActivation contrib op, applied by MLAS to each output tile
+  std::optional<MLAS_ACTIVATION> activation_;
+
 #if defined(__aarch64__) && defined(__linux__)
   // fastmath mode state
   bool use_fastmath_mode_;
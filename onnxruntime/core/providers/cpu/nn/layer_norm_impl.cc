@@ -18,7 +18,7 @@ namespace {
 
 template <typename T,
           typename U,
-          typename = std::enable_if_t<std::is_same_v<T, float> || std::is_same_v<T, double>, void>>
+          typename = std::enable_if_t<std::is_same_v<T, double>, void>>
 void ComputeJob(
     const T* X_data,
     const T* scale_data,
@@ -80,9 +80,45 @@ void ComputeJob(
   }
 }
 
-// Helper to convert int64_t -> Eigen::Index safely
-inline Eigen::Index ToEigenIndex(int64_t v) {
-  return narrow<Eigen::Index>(v);
+template <typename U>
+void ComputeJob(
+    const float* X_data,
+    const float* scale_data,
+    const float* bias_data,
+    const ptrdiff_t task_idx,
+    const int64_t norm_size,
+    const int64_t broadcast_param,
+    const float* scale_float_ptr,
+    const float* bias_float_ptr,
+    float epsilon,
+    bool simplified,
+    float* Y_data,
+    U* mean_data,
+    U* inv_std_dev_data,
+    AllocatorPtr alloc) {
+  ORT_UNUSED_PARAMETER(scale_float_ptr);  // only used in MLFloat16 overload
+  ORT_UNUSED_PARAMETER(bias_float_ptr);   // only used in MLFloat16 overload
+  ORT_UNUSED_PARAMETER(alloc);
+
+  const float* p_input = X_data + task_idx * norm_size;
+  float* p_output = Y_data + task_idx * norm_size;
+
+  // Compute the offset of gamma and beta to support broadcasting.
+  int64_t i = LAYER_NORM_SCALE_BIAS_OFFSET(broadcast_param, task_idx, norm_size);
+
+  float mean = 0.0f;
+  float inv_std_dev = 0.0f;
+  MlasLayerNormalization<float>(p_input, nullptr, nullptr, scale_data + i, bias_data ? bias_data + i : nullptr,
+                                p_output, nullptr, static_cast<size_t>(norm_size), epsilon, simplified,
+                                &mean, &inv_std_dev);
+
+  if (mean_data != nullptr) {
+    mean_data[task_idx] = mean;
+  }
+
+  if (inv_std_dev_data != nullptr) {
+    inv_std_dev_data[task_idx] = inv_std_dev;
+  }
 }
 
 template <typename U>
@@ -105,58 +141,25 @@ void ComputeJob(
   ORT_UNUSED_PARAMETER(bias_data);   // only used in float/double overload
   ORT_UNUSED_PARAMETER(alloc);       // only required to create temporary float buffers
 
-  // reinterpret input/output MLFloat16* as Eigen::half*
-  const Eigen::half* p_input = reinterpret_cast<const Eigen::half*>(X_data + task_idx * norm_size);
-  Eigen::half* p_output = reinterpret_cast<Eigen::half*>(Y_data + task_idx * norm_size);
-
-  // Fix: cast norm_size to Eigen::Index
-  Eigen::Map<const Eigen::Matrix<Eigen::half, Eigen::Dynamic, 1>> input_vec(
-      p_input, ToEigenIndex(norm_size));
-  Eigen::Map<Eigen::Matrix<Eigen::half, Eigen::Dynamic, 1>> output_vec(
-      p_output, ToEigenIndex(norm_size));
-
-  // Compute mean and mean_square in float for precision
-  float mean = 0.0f;
-  float mean_square = 0.0f;
-
-  for (int64_t i = 0; i < norm_size; ++i) {
-    float val = static_cast<float>(input_vec[ToEigenIndex(i)]);
-    mean += val;
-    mean_square += val * val;
-  }
-
-  mean /= gsl::narrow_cast<float>(norm_size);
-  if (simplified) {
-    mean_square = std::sqrt(mean_square / norm_size + epsilon);
-  } else {
-    mean_square = std::sqrt(mean_square / norm_size - mean * mean + epsilon);
-  }
+  const MLFloat16* p_input = X_data + task_idx * norm_size;
+  MLFloat16* p_output = Y_data + task_idx * norm_size;
 
   // Offset calculation for broadcasting
   int64_t i = LAYER_NORM_SCALE_BIAS_OFFSET(broadcast_param, task_idx, norm_size);
 
-  for (int64_t h = 0; h < norm_size; ++h, ++i) {
-    float x = static_cast<float>(input_vec[ToEigenIndex(h)]);
-
-    float y = 0.0f;
-    if (simplified) {
-      y = x / mean_square * scale_float_ptr[i];
-    } else if (bias_float_ptr == nullptr) {
-      y = (x - mean) / mean_square * scale_float_ptr[i];
-    } else {
-      y = (x - mean) / mean_square * scale_float_ptr[i] + bias_float_ptr[i];
-    }
-
-    output_vec[ToEigenIndex(h)] = gsl::narrow_cast<Eigen::half>(y);
-  }
+  // The row is normalized in float for precision
+  float mean = 0.0f;
+  float inv_std_dev = 0.0f;
+  MlasLayerNormalization<MLFloat16>(p_input, nullptr, nullptr, scale_float_ptr + i,
+                                    bias_float_ptr ? bias_float_ptr + i : nullptr, p_output, nullptr,
+                                    static_cast<size_t>(norm_size), epsilon, simplified, &mean, &inv_std_dev);
 
   if (mean_data != nullptr) {
-    // ONNX spec doesn't support 'double' for 'U' so when 'T' == double, 'U' == float and we need to narrow
-    mean_data[task_idx] = MLFloat16(mean);
+    mean_data[task_idx] = U(mean);
   }
 
   if (inv_std_dev_data != nullptr) {
-    inv_std_dev_data[task_idx] = MLFloat16(1.0f / mean_square);
+    inv_std_dev_data[task_idx] = U(inv_std_dev);
   }
 }
 
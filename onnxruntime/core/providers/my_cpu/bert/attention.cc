@@ -0,0 +1,133 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/my_cpu/bert/attention.h"
+#include "core/graph/constants.h"
+#include "core/platform/env.h"
+#include "core/platform/threadpool.h"
+#include <algorithm>
+#include <cmath>
+
+namespace onnxruntime {
+namespace my_cpu {
+
+namespace {
+
+// Used when the platform does not report an L2 cache size.
+constexpr int kDefaultL2CacheSize = 256 * 1024;
+
+}  // namespace
+
+int GetFlashAttentionL2CacheSize() {
+  const int l2_cache_size = Env::Default().GetL2CacheSize();
+  return l2_cache_size > 0 ? l2_cache_size : kDefaultL2CacheSize;
+}
+
+Status RunFlashAttention(OpKernelContext* context, int l2_cache_size, MlasFlashAttentionThreadedArgs& args) {
+  // Pick tile sizes so the working set of one tile stays in L2 (see MultiHeadAttention for the derivation)
+  args.kv_block_size = l2_cache_size / (static_cast<int>(sizeof(float)) * 4 * (args.qk_head_size + args.v_head_size));
+  args.kv_block_size = std::max(args.kv_block_size, 1);
+  args.q_block_size = std::min(args.kv_block_size, args.qk_head_size + args.v_head_size);
+  args.kv_block_size = std::min(args.kv_block_size, args.kv_sequence_length);
+  args.q_block_size = std::min(args.q_block_size, args.q_sequence_length);
+
+  auto* tp = context->GetOperatorThreadPool();
+  args.thread_count = concurrency::ThreadPool::DegreeOfParallelism(tp);
+  args.buffer_size_per_thread = (static_cast<size_t>(args.q_block_size) * 2 +
+                                 static_cast<size_t>(args.q_block_size) * static_cast<size_t>(args.kv_block_size) +
+                                 static_cast<size_t>(args.q_block_size) * static_cast<size_t>(args.v_head_size)) *
+                                sizeof(float);
+  if (args.key_quant != nullptr) {
+    // Room for the dequantized K/V tiles of one kv block
+    args.buffer_size_per_thread += static_cast<size_t>(args.kv_block_size) *
+                                   static_cast<size_t>(args.qk_head_size + args.v_head_size) * sizeof(float);
+  }
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+  IAllocatorUniquePtr<void> buffer =
+      IAllocator::MakeUniquePtr<void>(allocator, args.buffer_size_per_thread * args.thread_count);
+  args.buffer = reinterpret_cast<float*>(buffer.get());
+
+  // Tiled Q*K^T -> online softmax -> *V
+  MlasFlashAttention(&args, tp);
+
+  return Status::OK();
+}
+
+Attention::Attention(const OpKernelInfo& info) : OpKernel(info) {
+  scale_ = info.GetAttrOrDefault<float>("scale", 0.0f);
+  is_unidirectional_ = info.GetAttrOrDefault<int64_t>("unidirectional", 1) == 1;
+
+  l2_cache_size_ = GetFlashAttentionL2CacheSize();
+}
+
+Status Attention::Compute(OpKernelContext* context) const {
+  // 1. Get inputs and validate shapes
+  const Tensor* query = context->Input<Tensor>(0);
+  const Tensor* key = context->Input<Tensor>(1);
+  const Tensor* value = context->Input<Tensor>(2);
+
+  const auto& q_shape = query->Shape();
+  const auto& k_shape = key->Shape();
+  const auto& v_shape = value->Shape();
+  if (q_shape.NumDimensions() != 4 || k_shape.NumDimensions() != 4 || v_shape.NumDimensions() != 4) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "query, key and value are expected to be 4D (batch, num_heads, seq, head_size)");
+  }
+
+  const int batch_size = static_cast<int>(q_shape[0]);
+  const int num_heads = static_cast<int>(q_shape[1]);
+  const int q_sequence_length = static_cast<int>(q_shape[2]);
+  const int qk_head_size = static_cast<int>(q_shape[3]);
+  const int kv_sequence_length = static_cast<int>(k_shape[2]);
+  const int v_head_size = static_cast<int>(v_shape[3]);
+
+  if (k_shape[0] != batch_size || k_shape[1] != num_heads || k_shape[3] != qk_head_size ||
+      v_shape[0] != batch_size || v_shape[1] != num_heads || v_shape[2] != kv_sequence_length) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Incompatible attention input shapes. query: ", q_shape,
+                           " key: ", k_shape, " value: ", v_shape);
+  }
+
+  if (is_unidirectional_ && kv_sequence_length < q_sequence_length) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Causal attention requires kv_sequence_length >= sequence_length, got ",
+                           kv_sequence_length, " and ", q_sequence_length);
+  }
+
+  // 2. Allocate output in (batch, seq, num_heads, v_head_size) layout
+  Tensor* output = context->Output(0, {batch_size, q_sequence_length, num_heads, v_head_size});
+  if (output->Shape().Size() == 0 || kv_sequence_length == 0) {
+    return Status::OK();
+  }
+
+  // 3. Run the tiled attention, writing straight into the output
+  MlasFlashAttentionThreadedArgs args;
+  args.batch_size = batch_size;
+  args.num_heads = num_heads;
+  args.q_sequence_length = q_sequence_length;
+  args.kv_sequence_length = kv_sequence_length;
+  args.qk_head_size = qk_head_size;
+  args.v_head_size = v_head_size;
+  args.scale = (scale_ == 0.0f) ? 1.0f / std::sqrt(static_cast<float>(qk_head_size)) : scale_;
+  args.is_causal = is_unidirectional_;
+  args.query = query->Data<float>();
+  args.key = key->Data<float>();
+  args.value = value->Data<float>();
+  args.output = output->MutableData<float>();
+
+  return RunFlashAttention(context, l2_cache_size_, args);
+}
+
+}  // namespace my_cpu
+
+ONNX_OPERATOR_KERNEL_EX(
+    Attention,
+    kMyCustomDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    my_cpu::Attention);
+
+}  // namespace onnxruntime
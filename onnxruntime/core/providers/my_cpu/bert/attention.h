@@ -0,0 +1,48 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+
+namespace onnxruntime {
+namespace my_cpu {
+
+/// L2 cache size used to pick flash attention tile sizes, with a fallback when the platform does not report one.
+int GetFlashAttentionL2CacheSize();
+
+/**
+ * Run MlasFlashAttention. The caller fills the shape, scale, causal and data fields of `args`; this picks the
+ * q/kv tile sizes so one tile's working set stays in L2, and allocates the per-thread scratch buffer.
+ */
+Status RunFlashAttention(OpKernelContext* context, int l2_cache_size, MlasFlashAttentionThreadedArgs& args);
+
+/**
+ * Attention operator - fused (causal) scaled dot-product attention for float
+ *
+ * Computes: Y = Softmax(scale * Q * K^T + causal_mask) * V
+ *
+ * Q, K and V are in (batch, num_heads, seq, head_size) layout, as produced by the
+ * per-head Reshape/Transpose of an exported GPT-2 block. The output is written in
+ * (batch, seq, num_heads, v_head_size) layout so it feeds the output projection
+ * without a separate Transpose.
+ *
+ * Q * K^T, the softmax and the product with V are tiled through MlasFlashAttention,
+ * so the [seq, kv_seq] score matrix is never materialized.
+ */
+class Attention final : public OpKernel {
+ public:
+  Attention(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  float scale_;
+  bool is_unidirectional_;
+  int l2_cache_size_;
+};
+
+}  // namespace my_cpu
+}  // namespace onnxruntime
@@ -0,0 +1,117 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/my_cpu/bert/bias_gelu.h"
+#include "core/graph/constants.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include <algorithm>
+
+namespace onnxruntime {
+namespace my_cpu {
+
+namespace {
+
+// Same tanh approximation as FastGelu:
+// GELU(x) ≈ 0.5 * x * (1 + tanh(x * (kBeta * x² + kAlpha)))
+constexpr float kAlpha = 0.7978845608028654f;    // sqrt(2/π)
+constexpr float kBeta = 0.035677408136300125f;  // 0.044715 * sqrt(2/π)
+constexpr float kHalf = 0.5f;
+
+// Number of elements staged through the on-stack tanh scratch buffer. This is also
+// the unit of work handed to the thread pool.
+constexpr int64_t kElementsPerBlock = 256;
+
+// Rough cost of the bias add, the tanh argument polynomial, MlasComputeTanh and the
+// final product for one element.
+constexpr double kComputeCyclesPerElement = 20.0;
+
+}  // namespace
+
+Status BiasGelu::Compute(OpKernelContext* context) const {
+  // 1. Get inputs
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* bias = context->Input<Tensor>(1);
+
+  const auto& input_shape = input->Shape();
+  const auto& bias_shape = bias->Shape();
+  if (input_shape.NumDimensions() < 1 || bias_shape.NumDimensions() != 1 ||
+      bias_shape[0] != input_shape[input_shape.NumDimensions() - 1]) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "bias is expected to be 1D with the size of the last input dimension. input: ",
+                           input_shape, " bias: ", bias_shape);
+  }
+
+  const float* input_data = input->Data<float>();
+  const float* bias_data = bias->Data<float>();
+  const int64_t bias_len = bias_shape[0];
+
+  // 2. Allocate output tensor with same shape as input (may alias input, see MayInplace)
+  Tensor* output = context->Output(0, input_shape);
+  float* output_data = output->MutableData<float>();
+
+  if (bias_len == 0) {
+    return Status::OK();
+  }
+
+  // 3. Split the tensor into blocks of at most kElementsPerBlock elements that do not
+  // cross a row, so a single long row (M == 1) is still spread over the thread pool.
+  const int64_t row_count = input_shape.Size() / bias_len;
+  const int64_t blocks_per_row = (bias_len + kElementsPerBlock - 1) / kElementsPerBlock;
+  const int64_t block_count = row_count * blocks_per_row;
+
+  // Per block: input and bias loaded, output stored, and the polynomial and tanh evaluated.
+  const TensorOpCost block_cost{static_cast<double>(2 * kElementsPerBlock * sizeof(float)),
+                                static_cast<double>(kElementsPerBlock * sizeof(float)),
+                                static_cast<double>(kElementsPerBlock * kComputeCyclesPerElement)};
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(block_count), block_cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t block = first; block < last; ++block) {
+          const int64_t row = block / blocks_per_row;
+          const int64_t column = (block % blocks_per_row) * kElementsPerBlock;
+          const int64_t offset = row * bias_len + column;
+          const size_t length = static_cast<size_t>(std::min<int64_t>(kElementsPerBlock, bias_len - column));
+          ComputeBiasGelu(input_data + offset, bias_data + column, output_data + offset, length);
+        }
+      });
+
+  return Status::OK();
+}
+
+void BiasGelu::ComputeBiasGelu(const float* input, const float* bias, float* output, size_t count) {
+  constexpr size_t block_size = static_cast<size_t>(kElementsPerBlock);
+  float scratch[block_size];
+
+  for (size_t offset = 0; offset < count; offset += block_size) {
+    const size_t length = std::min(block_size, count - offset);
+    const float* p_input = input + offset;
+    const float* p_bias = bias + offset;
+    float* p_output = output + offset;
+
+    for (size_t i = 0; i < length; ++i) {
+      const float x = p_input[i] + p_bias[i];
+      scratch[i] = x * (kBeta * x * x + kAlpha);
+    }
+
+    MlasComputeTanh(scratch, scratch, length);
+
+    for (size_t i = 0; i < length; ++i) {
+      const float x = p_input[i] + p_bias[i];
+      p_output[i] = kHalf * x * (1.0f + scratch[i]);
+    }
+  }
+}
+
+}  // namespace my_cpu
+
+ONNX_OPERATOR_KERNEL_EX(
+    BiasGelu,
+    kMyCustomDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().MayInplace(0, 0).TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    my_cpu::BiasGelu);
+
+}  // namespace onnxruntime
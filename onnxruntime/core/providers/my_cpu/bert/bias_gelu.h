@@ -0,0 +1,38 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace my_cpu {
+
+/**
+ * BiasGelu operator - fused bias add + FastGELU for float
+ *
+ * Computes: C = GELU(A + B) with the tanh approximation, where B is a 1D bias
+ * broadcast along the last dimension of A.
+ *
+ * The bias is applied inside the GELU loop, so the biased MLP intermediate is
+ * never materialized. Fixed-size column blocks within each row are distributed
+ * over the intra-op thread pool, so even a single row uses every thread, and the
+ * tanh is evaluated with MlasComputeTanh. Output may alias input A (MayInplace),
+ * letting the allocation planner reuse the MatMul output.
+ */
+class BiasGelu final : public OpKernel {
+ public:
+  BiasGelu(const OpKernelInfo& info) : OpKernel(info) {}
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  // Computes GELU(input + bias) for one block of a row. The tanh argument is staged in a small
+  // scratch block and the biased value is recomputed in the final pass, so input
+  // and output may alias.
+  static void ComputeBiasGelu(const float* input, const float* bias, float* output, size_t count);
+};
+
+}  // namespace my_cpu
+}  // namespace onnxruntime
@@ -0,0 +1,222 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/my_cpu/bert/decoder_masked_attention.h"
+#include "core/providers/my_cpu/bert/attention.h"
+#include "core/graph/constants.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace onnxruntime {
+namespace my_cpu {
+
+namespace {
+
+constexpr int kPastKeyInputIndex = 3;
+constexpr int kPastValueInputIndex = 4;
+constexpr int kPastSequenceLengthInputIndex = 5;
+constexpr int kPastKeyScaleInputIndex = 6;
+constexpr int kPastValueScaleInputIndex = 7;
+constexpr int kPresentKeyOutputIndex = 1;
+constexpr int kPresentValueOutputIndex = 2;
+constexpr int kPresentKeyScaleOutputIndex = 3;
+constexpr int kPresentValueScaleOutputIndex = 4;
+
+// Writes the `rows` new rows of each (batch, head) in `src` into the cache `dst` at sequence position `offset`.
+void AppendToCache(const float* src, float* dst, int64_t batch_heads, int64_t rows, int64_t max_rows,
+                   int64_t offset, int64_t row_size) {
+  const size_t bytes = static_cast<size_t>(rows * row_size) * sizeof(float);
+  for (int64_t bn = 0; bn < batch_heads; ++bn) {
+    std::memcpy(dst + (bn * max_rows + offset) * row_size, src + bn * rows * row_size, bytes);
+  }
+}
+
+// Same as AppendToCache for an int8 cache: each new row is quantized to symmetric int8 with its own scale.
+void AppendToQuantizedCache(const float* src, int8_t* dst, float* dst_scale, int64_t batch_heads, int64_t rows,
+                            int64_t max_rows, int64_t offset, int64_t row_size) {
+  for (int64_t bn = 0; bn < batch_heads; ++bn) {
+    for (int64_t r = 0; r < rows; ++r) {
+      const float* src_row = src + (bn * rows + r) * row_size;
+      const int64_t position = bn * max_rows + offset + r;
+
+      float min_value, max_value;
+      MlasFindMinMaxElement(src_row, &min_value, &max_value, static_cast<size_t>(row_size));
+      const float max_abs = std::max(-min_value, max_value);
+      const float scale = max_abs > 0.0f ? max_abs / 127.0f : 1.0f;
+
+      MlasQuantizeLinear<int8_t>(src_row, dst + position * row_size, static_cast<size_t>(row_size), scale, 0);
+      dst_scale[position] = scale;
+    }
+  }
+}
+
+// The step appends to the cache in place, so present_<name> must be the past_<name> buffer. The allocation planner
+// never aliases a graph input to an output, so a decode loop binds present_* onto the past_* buffers with IOBinding.
+Status CheckCacheShared(const Tensor& past, const Tensor& present, const char* name) {
+  if (present.DataRaw() != past.DataRaw()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "present_", name, " must share the buffer of past_", name,
+                           ". Bind present_", name, " to the past_", name, " buffer, e.g. with IOBinding.");
+  }
+  return Status::OK();
+}
+
+}  // namespace
+
+DecoderMaskedAttention::DecoderMaskedAttention(const OpKernelInfo& info) : OpKernel(info) {
+  scale_ = info.GetAttrOrDefault<float>("scale", 0.0f);
+  l2_cache_size_ = GetFlashAttentionL2CacheSize();
+}
+
+Status DecoderMaskedAttention::Compute(OpKernelContext* context) const {
+  // 1. Get inputs and validate shapes
+  const Tensor* query = context->Input<Tensor>(0);
+  const Tensor* key = context->Input<Tensor>(1);
+  const Tensor* value = context->Input<Tensor>(2);
+  const Tensor* past_key = context->Input<Tensor>(kPastKeyInputIndex);
+  const Tensor* past_value = context->Input<Tensor>(kPastValueInputIndex);
+  const Tensor* past_seq_len = context->Input<Tensor>(kPastSequenceLengthInputIndex);
+
+  const auto& q_shape = query->Shape();
+  const auto& k_shape = key->Shape();
+  const auto& v_shape = value->Shape();
+  const auto& past_k_shape = past_key->Shape();
+  const auto& past_v_shape = past_value->Shape();
+  if (q_shape.NumDimensions() != 4 || k_shape.NumDimensions() != 4 || v_shape.NumDimensions() != 4 ||
+      past_k_shape.NumDimensions() != 4 || past_v_shape.NumDimensions() != 4) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "query, key, value, past_key and past_value are expected to be 4D "
+                           "(batch, num_heads, seq, head_size)");
+  }
+
+  const int64_t batch_size = q_shape[0];
+  const int64_t num_heads = q_shape[1];
+  const int64_t sequence_length = q_shape[2];
+  const int64_t head_size = q_shape[3];
+  const int64_t v_head_size = v_shape[3];
+  const int64_t max_sequence_length = past_k_shape[2];
+
+  if (k_shape != TensorShape({batch_size, num_heads, sequence_length, head_size}) ||
+      v_shape != TensorShape({batch_size, num_heads, sequence_length, v_head_size}) ||
+      past_k_shape != TensorShape({batch_size, num_heads, max_sequence_length, head_size}) ||
+      past_v_shape != TensorShape({batch_size, num_heads, max_sequence_length, v_head_size})) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Incompatible decoder attention input shapes. query: ", q_shape, " key: ", k_shape,
+                           " value: ", v_shape, " past_key: ", past_k_shape, " past_value: ", past_v_shape);
+  }
+
+  if (past_seq_len->Shape().Size() != 1) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "past_sequence_length must be a scalar or 1D tensor of size 1, got shape ",
+                           past_seq_len->Shape());
+  }
+
+  const int64_t past_sequence_length = static_cast<int64_t>(*past_seq_len->Data<int32_t>());
+  const int64_t total_sequence_length = past_sequence_length + sequence_length;
+  if (past_sequence_length < 0 || total_sequence_length > max_sequence_length) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "past_sequence_length (", past_sequence_length, ") + sequence_length (", sequence_length,
+                           ") must be within the cache capacity max_sequence_length (", max_sequence_length, ")");
+  }
+
+  // An int8 cache carries one scale per (batch, head, position) row
+  const bool is_quantized = past_key->IsDataType<int8_t>();
+  if (past_value->IsDataType<int8_t>() != is_quantized) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "past_key and past_value must have the same type");
+  }
+
+  const Tensor* past_key_scale = context->Input<Tensor>(kPastKeyScaleInputIndex);
+  const Tensor* past_value_scale = context->Input<Tensor>(kPastValueScaleInputIndex);
+  const TensorShape scale_shape({batch_size, num_heads, max_sequence_length});
+  if (is_quantized) {
+    if (past_key_scale == nullptr || past_value_scale == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "past_key_scale and past_value_scale are required with an int8 cache");
+    }
+    if (past_key_scale->Shape() != scale_shape || past_value_scale->Shape() != scale_shape) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "past_key_scale and past_value_scale are expected to have shape ", scale_shape,
+                             ", got ", past_key_scale->Shape(), " and ", past_value_scale->Shape());
+    }
+  }
+
+  // 2. Outputs. present_* must share the past_* buffers; the cache is never copied.
+  Tensor* output = context->Output(0, {batch_size, sequence_length, num_heads, v_head_size});
+  Tensor* present_key = context->Output(kPresentKeyOutputIndex, past_k_shape);
+  Tensor* present_value = context->Output(kPresentValueOutputIndex, past_v_shape);
+  ORT_RETURN_IF_ERROR(CheckCacheShared(*past_key, *present_key, "key"));
+  ORT_RETURN_IF_ERROR(CheckCacheShared(*past_value, *present_value, "value"));
+
+  // 3. Append the new K/V rows after the valid prefix
+  const int64_t batch_heads = batch_size * num_heads;
+  MlasFlashAttentionThreadedArgs args;
+  if (is_quantized) {
+    Tensor* present_key_scale = context->Output(kPresentKeyScaleOutputIndex, scale_shape);
+    Tensor* present_value_scale = context->Output(kPresentValueScaleOutputIndex, scale_shape);
+    if (present_key_scale == nullptr || present_value_scale == nullptr) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "present_key_scale and present_value_scale are required with an int8 cache");
+    }
+    ORT_RETURN_IF_ERROR(CheckCacheShared(*past_key_scale, *present_key_scale, "key_scale"));
+    ORT_RETURN_IF_ERROR(CheckCacheShared(*past_value_scale, *present_value_scale, "value_scale"));
+
+    AppendToQuantizedCache(key->Data<float>(), present_key->MutableData<int8_t>(),
+                           present_key_scale->MutableData<float>(), batch_heads, sequence_length,
+                           max_sequence_length, past_sequence_length, head_size);
+    AppendToQuantizedCache(value->Data<float>(), present_value->MutableData<int8_t>(),
+                           present_value_scale->MutableData<float>(), batch_heads, sequence_length,
+                           max_sequence_length, past_sequence_length, v_head_size);
+
+    args.key_quant = present_key->Data<int8_t>();
+    args.value_quant = present_value->Data<int8_t>();
+    args.key_scale = present_key_scale->Data<float>();
+    args.value_scale = present_value_scale->Data<float>();
+  } else {
+    AppendToCache(key->Data<float>(), present_key->MutableData<float>(), batch_heads, sequence_length,
+                  max_sequence_length, past_sequence_length, head_size);
+    AppendToCache(value->Data<float>(), present_value->MutableData<float>(), batch_heads, sequence_length,
+                  max_sequence_length, past_sequence_length, v_head_size);
+
+    args.key = present_key->Data<float>();
+    args.value = present_value->Data<float>();
+  }
+
+  if (output->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  // 4. Attend over the valid prefix of the cache, in place
+  args.batch_size = static_cast<int>(batch_size);
+  args.num_heads = static_cast<int>(num_heads);
+  args.q_sequence_length = static_cast<int>(sequence_length);
+  args.kv_sequence_length = static_cast<int>(total_sequence_length);
+  args.kv_buffer_sequence_length = static_cast<int>(max_sequence_length);
+  args.qk_head_size = static_cast<int>(head_size);
+  args.v_head_size = static_cast<int>(v_head_size);
+  args.scale = (scale_ == 0.0f) ? 1.0f / std::sqrt(static_cast<float>(head_size)) : scale_;
+  args.is_causal = true;
+  args.query = query->Data<float>();
+  args.output = output->MutableData<float>();
+
+  return RunFlashAttention(context, l2_cache_size_, args);
+}
+
+}  // namespace my_cpu
+
+ONNX_OPERATOR_KERNEL_EX(
+    DecoderMaskedAttention,
+    kMyCustomDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .MayInplace(my_cpu::kPastKeyInputIndex, my_cpu::kPresentKeyOutputIndex)
+        .MayInplace(my_cpu::kPastValueInputIndex, my_cpu::kPresentValueOutputIndex)
+        .MayInplace(my_cpu::kPastKeyScaleInputIndex, my_cpu::kPresentKeyScaleOutputIndex)
+        .MayInplace(my_cpu::kPastValueScaleInputIndex, my_cpu::kPresentValueScaleOutputIndex)
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("TC", BuildKernelDefConstraints<float, int8_t>())
+        .TypeConstraint("M", DataTypeImpl::GetTensorType<int32_t>())
+        .InputMemoryType(OrtMemTypeCPUInput, my_cpu::kPastSequenceLengthInputIndex),
+    my_cpu::DecoderMaskedAttention);
+
+}  // namespace onnxruntime
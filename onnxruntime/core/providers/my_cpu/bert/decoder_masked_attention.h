@@ -0,0 +1,40 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace my_cpu {
+
+/**
+ * DecoderMaskedAttention operator - causal attention over a preallocated KV cache for float
+ *
+ * past_key/past_value are max-length (batch, num_heads, max_seq, head_size) buffers of which the first
+ * past_sequence_length positions are valid. The new K/V rows are written in place after the valid prefix,
+ * and the query attends to the prefix plus the new rows through MlasFlashAttention reading the cache directly.
+ *
+ * present_key/present_value must share the past buffers, so a decode step does O(new tokens) cache writes
+ * instead of the O(seq) Concat of the growing past tensors. The allocation planner never aliases a graph input to
+ * an output, so a decode loop binds present_* onto the past_* buffers with IOBinding (as past_present_share_buffer
+ * does for DecoderMaskedMultiHeadAttention). Compute fails when they are not shared rather than copying the cache.
+ *
+ * The cache may also be int8 with one float scale per (batch, head, position) row in past_key_scale and
+ * past_value_scale. New rows are quantized symmetrically when appended, and MlasFlashAttention dequantizes
+ * each K/V block into per-thread scratch before its GEMMs, which quarters the cache memory and bandwidth.
+ */
+class DecoderMaskedAttention final : public OpKernel {
+ public:
+  DecoderMaskedAttention(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  float scale_;
+  int l2_cache_size_;
+};
+
+}  // namespace my_cpu
+}  // namespace onnxruntime
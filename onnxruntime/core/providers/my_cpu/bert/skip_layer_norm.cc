@@ -0,0 +1,153 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/my_cpu/bert/skip_layer_norm.h"
+#include "core/graph/constants.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math_cpuonly.h"
+
+namespace onnxruntime {
+namespace my_cpu {
+
+namespace {
+
+// Normalizes one row. Eigen array expressions are used so the element-wise
+// loops and reductions are vectorized for the target ISA.
+void ComputeRow(const float* input,
+                const float* skip,
+                const float* gamma,
+                const float* beta,
+                const float* bias,
+                int64_t hidden_size,
+                float epsilon,
+                float* output,
+                float* sum_output) {
+  const auto n = narrow<Eigen::Index>(hidden_size);
+  EigenVectorArrayMap<float> out(output, n);
+
+  if (bias != nullptr) {
+    out = ConstEigenVectorArrayMap<float>(input, n) +
+          ConstEigenVectorArrayMap<float>(skip, n) +
+          ConstEigenVectorArrayMap<float>(bias, n);
+  } else {
+    out = ConstEigenVectorArrayMap<float>(input, n) +
+          ConstEigenVectorArrayMap<float>(skip, n);
+  }
+
+  if (sum_output != nullptr) {
+    EigenVectorArrayMap<float>(sum_output, n) = out;
+  }
+
+  const float mean = out.mean();
+  const float variance = out.square().mean() - mean * mean;
+  const float inv_std = 1.0f / std::sqrt(variance + epsilon);
+
+  if (beta != nullptr) {
+    out = (out - mean) * inv_std * ConstEigenVectorArrayMap<float>(gamma, n) +
+          ConstEigenVectorArrayMap<float>(beta, n);
+  } else {
+    out = (out - mean) * inv_std * ConstEigenVectorArrayMap<float>(gamma, n);
+  }
+}
+
+// skip is added to every row of input, so it must be input with some leading dimensions dropped:
+// (hidden_size), (sequence_length, hidden_size) or (batch_size or 1, sequence_length, hidden_size).
+// A skip that merely divides the input size would silently be added to the wrong rows.
+Status CheckSkipShape(const TensorShape& input_shape, const TensorShape& skip_shape) {
+  const size_t input_rank = input_shape.NumDimensions();
+  const size_t skip_rank = skip_shape.NumDimensions();
+  bool valid = skip_rank >= 1 && skip_rank <= input_rank && skip_shape.Size() > 0;
+  for (size_t i = 0; valid && i < skip_rank; ++i) {
+    const int64_t skip_dim = skip_shape[skip_rank - 1 - i];
+    const int64_t input_dim = input_shape[input_rank - 1 - i];
+    // only a full-rank skip may have a batch size of 1
+    const bool broadcast_batch = skip_rank == input_rank && input_rank == 3 && i == 2 && skip_dim == 1;
+    valid = skip_dim == input_dim || broadcast_batch;
+  }
+
+  if (!valid) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "skip is expected to have shape (hidden_size), (sequence_length, hidden_size) or "
+                           "(batch_size or 1, sequence_length, hidden_size) matching input shape ",
+                           input_shape, ", got ", skip_shape);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace
+
+SkipLayerNorm::SkipLayerNorm(const OpKernelInfo& info) : OpKernel(info) {
+  ORT_ENFORCE(info.GetAttr<float>("epsilon", &epsilon_).IsOK());
+  ORT_ENFORCE(epsilon_ >= 0);
+}
+
+Status SkipLayerNorm::Compute(OpKernelContext* context) const {
+  // 1. Get inputs
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* skip = context->Input<Tensor>(1);
+  const Tensor* gamma = context->Input<Tensor>(2);
+  const Tensor* beta = context->Input<Tensor>(3);
+  const Tensor* bias = context->Input<Tensor>(4);
+
+  // 2. Validate shapes
+  const auto& input_shape = input->Shape();
+  if (input_shape.NumDimensions() != 2 && input_shape.NumDimensions() != 3) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "input is expected to have 2 or 3 dimensions, got ", input_shape.NumDimensions());
+  }
+
+  const int64_t hidden_size = input_shape[input_shape.NumDimensions() - 1];
+  ORT_RETURN_IF_ERROR(CheckSkipShape(input_shape, skip->Shape()));
+  const int64_t skip_size = skip->Shape().Size();
+
+  for (const Tensor* param : {gamma, beta, bias}) {
+    if (param != nullptr && (param->Shape().NumDimensions() != 1 || param->Shape()[0] != hidden_size)) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "gamma, beta and bias are expected to be 1D with size ", hidden_size,
+                             ", got ", param->Shape());
+    }
+  }
+
+  // 3. Allocate outputs; the sum output is only produced when it is consumed
+  Tensor* output = context->Output(0, input_shape);
+  Tensor* sum_output = context->Output(1, input_shape);
+
+  const float* input_data = input->Data<float>();
+  const float* skip_data = skip->Data<float>();
+  const float* gamma_data = gamma->Data<float>();
+  const float* beta_data = beta == nullptr ? nullptr : beta->Data<float>();
+  const float* bias_data = bias == nullptr ? nullptr : bias->Data<float>();
+  float* output_data = output->MutableData<float>();
+  float* sum_output_data = sum_output == nullptr ? nullptr : sum_output->MutableData<float>();
+
+  // 4. One task per row
+  const int64_t row_count = input_shape.SizeToDimension(input_shape.NumDimensions() - 1);
+  const float epsilon = epsilon_;
+  concurrency::ThreadPool::TryBatchParallelFor(
+      context->GetOperatorThreadPool(), static_cast<int32_t>(row_count),
+      [&](ptrdiff_t row) {
+        const int64_t offset = row * hidden_size;
+        ComputeRow(input_data + offset,
+                   skip_data + (offset % skip_size),
+                   gamma_data, beta_data, bias_data,
+                   hidden_size, epsilon,
+                   output_data + offset,
+                   sum_output_data == nullptr ? nullptr : sum_output_data + offset);
+      },
+      0);
+
+  return Status::OK();
+}
+
+}  // namespace my_cpu
+
+ONNX_OPERATOR_KERNEL_EX(
+    SkipLayerNormalization,
+    kMyCustomDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    my_cpu::SkipLayerNorm);
+
+}  // namespace onnxruntime
@@ -0,0 +1,35 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace my_cpu {
+
+/**
+ * SkipLayerNormalization operator - fused residual add + layer norm for float
+ *
+ * Computes: sum = input + skip (+ bias)
+ *           output = (sum - mean(sum)) / sqrt(var(sum) + epsilon) * gamma (+ beta)
+ *
+ * Each row of hidden_size elements makes several passes over the output buffer:
+ * the sum is written to it (and copied to the optional input_skip_bias_sum
+ * output), the mean and mean-square are reduced from it, and it is normalized
+ * in place. For typical hidden sizes the row stays in cache between passes.
+ * Rows are distributed over the intra-op thread pool.
+ */
+class SkipLayerNorm final : public OpKernel {
+ public:
+  SkipLayerNorm(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  float epsilon_;
+};
+
+}  // namespace my_cpu
+}  // namespace onnxruntime
@@ -6,9 +6,16 @@
 #include "core/framework/op_kernel.h"
 
 // Forward declare the kernel class created by ONNX_OPERATOR_KERNEL_EX macro
-// This class is defined in fast_gelu.cc using kMyCustomDomain
+// These classes are defined in bert/*.cc using kMyCustomDomain
 namespace onnxruntime {
-class kCpuExecutionProvider_FastGelu_kMyCustomDomain_ver1;
+class kCpuExecutionProvider_FastGelu_kMyCustomDomain_ver1_float;
+class kCpuExecutionProvider_FastGelu_kMyCustomDomain_ver1_double;
+class kCpuExecutionProvider_FastGelu_kMyCustomDomain_ver1_MLFloat16;
+class kCpuExecutionProvider_FastGelu_kMyCustomDomain_ver1_BFloat16;
+class kCpuExecutionProvider_SkipLayerNormalization_kMyCustomDomain_ver1;
+class kCpuExecutionProvider_BiasGelu_kMyCustomDomain_ver1;
+class kCpuExecutionProvider_Attention_kMyCustomDomain_ver1;
+class kCpuExecutionProvider_DecoderMaskedAttention_kMyCustomDomain_ver1;
 }
 
 namespace onnxruntime {
@@ -16,16 +23,24 @@ namespace my_cpu {
 
 Status RegisterMyCpuKernels(KernelRegistry& kernel_registry) {
   static const BuildKernelCreateInfoFn function_table[] = {
-      // FastGelu operator (using non-TYPED macro version)
-      // Class is forward declared above and defined in fast_gelu.cc using kMyCustomDomain
-      ::onnxruntime::BuildKernelCreateInfo<::onnxruntime::kCpuExecutionProvider_FastGelu_kMyCustomDomain_ver1>,
-
-      // TODO-OPTIMIZE: [Fusion] Add fused operators for better performance
-      // Use kMyCustomDomain to avoid conflicts with existing operators
-      // BuildKernelCreateInfo<ONNX_OPERATOR_KERNEL_CLASS_NAME(
-      //     kCpuExecutionProvider, kMyCustomDomain, 1, SkipLayerNormalization)>,
-      // BuildKernelCreateInfo<ONNX_OPERATOR_KERNEL_CLASS_NAME(
-      //     kCpuExecutionProvider, kMyCustomDomain, 1, BiasGelu)>,
+      // FastGelu operator (TYPED macro version, one kernel per element type)
+      // Classes are forward declared above and defined in fast_gelu.cc using kMyCustomDomain
+      ::onnxruntime::BuildKernelCreateInfo<::onnxruntime::kCpuExecutionProvider_FastGelu_kMyCustomDomain_ver1_float>,
+      ::onnxruntime::BuildKernelCreateInfo<::onnxruntime::kCpuExecutionProvider_FastGelu_kMyCustomDomain_ver1_double>,
+      ::onnxruntime::BuildKernelCreateInfo<::onnxruntime::kCpuExecutionProvider_FastGelu_kMyCustomDomain_ver1_MLFloat16>,
+      ::onnxruntime::BuildKernelCreateInfo<::onnxruntime::kCpuExecutionProvider_FastGelu_kMyCustomDomain_ver1_BFloat16>,
+
+      // SkipLayerNormalization: fused residual add + layer norm, defined in skip_layer_norm.cc
+      ::onnxruntime::BuildKernelCreateInfo<::onnxruntime::kCpuExecutionProvider_SkipLayerNormalization_kMyCustomDomain_ver1>,
+
+      // BiasGelu: fused bias add + FastGelu, defined in bias_gelu.cc
+      ::onnxruntime::BuildKernelCreateInfo<::onnxruntime::kCpuExecutionProvider_BiasGelu_kMyCustomDomain_ver1>,
+
+      // Attention: fused causal attention backed by MlasFlashAttention, defined in attention.cc
+      ::onnxruntime::BuildKernelCreateInfo<::onnxruntime::kCpuExecutionProvider_Attention_kMyCustomDomain_ver1>,
+
+      // DecoderMaskedAttention: attention over an in-place KV cache, defined in decoder_masked_attention.cc
+      ::onnxruntime::BuildKernelCreateInfo<::onnxruntime::kCpuExecutionProvider_DecoderMaskedAttention_kMyCustomDomain_ver1>,
   };
 
   for (auto& function : function_table) {
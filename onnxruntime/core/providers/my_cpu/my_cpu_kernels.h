@@ -13,8 +13,10 @@ namespace my_cpu {
  *
  * This registers all custom operators in the my_cpu namespace:
  * - FastGelu: Fast GELU activation with tanh approximation
- * - (Future) SkipLayerNormalization: Fused residual + layer norm
- * - (Future) BiasGelu: Fused bias + GELU
+ * - SkipLayerNormalization: Fused residual + layer norm
+ * - BiasGelu: Fused bias + GELU
+ * - Attention: Fused (causal) attention backed by MLAS flash attention
+ * - DecoderMaskedAttention: Decode-step attention appending to a preallocated KV cache in place
  */
 Status RegisterMyCpuKernels(KernelRegistry& kernel_registry);
 
@@ -0,0 +1,412 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/dynamic_batcher.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/common/make_string.h"
+#include "core/framework/error_code_helper.h"
+#include "core/framework/tensor.h"
+#include "core/graph/node_arg.h"
+#include "core/platform/threadpool.h"
+#include "core/session/inference_session.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Copies `parts` into `output`, concatenated along `axis`. All parts have the same shape except along `axis`.
+void ConcatAlongAxis(gsl::span<const Tensor* const> parts, size_t axis, Tensor& output) {
+  const TensorShape& output_shape = output.Shape();
+  const size_t element_size = output.DataType()->Size();
+  const int64_t outer = output_shape.SizeToDimension(axis);
+  const int64_t inner_bytes = output_shape.SizeFromDimension(axis + 1) * static_cast<int64_t>(element_size);
+  const int64_t output_row_bytes = output_shape[axis] * inner_bytes;
+
+  auto* dst = static_cast<uint8_t*>(output.MutableDataRaw());
+  int64_t offset_bytes = 0;
+  for (const Tensor* part : parts) {
+    const int64_t part_row_bytes = part->Shape()[axis] * inner_bytes;
+    const auto* src = static_cast<const uint8_t*>(part->DataRaw());
+    for (int64_t o = 0; o < outer; ++o) {
+      std::memcpy(dst + o * output_row_bytes + offset_bytes, src + o * part_row_bytes,
+                  static_cast<size_t>(part_row_bytes));
+    }
+    offset_bytes += part_row_bytes;
+  }
+}
+
+// Copies rows [start, start + output.Shape()[axis]) of `input` along `axis` into `output`.
+void SliceAlongAxis(const Tensor& input, size_t axis, int64_t start, Tensor& output) {
+  const TensorShape& input_shape = input.Shape();
+  const size_t element_size = input.DataType()->Size();
+  const int64_t outer = input_shape.SizeToDimension(axis);
+  const int64_t inner_bytes = input_shape.SizeFromDimension(axis + 1) * static_cast<int64_t>(element_size);
+  const int64_t input_row_bytes = input_shape[axis] * inner_bytes;
+  const int64_t output_row_bytes = output.Shape()[axis] * inner_bytes;
+
+  const auto* src = static_cast<const uint8_t*>(input.DataRaw()) + start * inner_bytes;
+  auto* dst = static_cast<uint8_t*>(output.MutableDataRaw());
+  for (int64_t o = 0; o < outer; ++o) {
+    std::memcpy(dst + o * output_row_bytes, src + o * input_row_bytes, static_cast<size_t>(output_row_bytes));
+  }
+}
+
+// Fails if `arg` has a known rank but no symbolic dimension at `axis`.
+Status CheckBatchAxis(const NodeArg& arg, size_t axis, const char* kind) {
+  const auto* shape = arg.Shape();
+  if (shape == nullptr) {
+    return Status::OK();
+  }
+
+  if (static_cast<size_t>(shape->dim_size()) <= axis || shape->dim(static_cast<int>(axis)).has_dim_value()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Model ", kind, " '", arg.Name(),
+                           "' has no symbolic dimension at the dynamic batching axis ", axis, ".");
+  }
+  return Status::OK();
+}
+
+}  // namespace
+
+Status DynamicBatcher::CheckModelIsBatchable(const InferenceSession& session, int64_t batch_axis) {
+  ORT_RETURN_IF(batch_axis < 0, "Dynamic batching axis must be non-negative");
+  const auto axis = static_cast<size_t>(batch_axis);
+
+  const auto [inputs_status, inputs] = session.GetModelInputs();
+  ORT_RETURN_IF_ERROR(inputs_status);
+  for (const NodeArg* input : *inputs) {
+    ORT_RETURN_IF_ERROR(CheckBatchAxis(*input, axis, "input"));
+  }
+
+  const auto [outputs_status, outputs] = session.GetModelOutputs();
+  ORT_RETURN_IF_ERROR(outputs_status);
+  for (const NodeArg* output : *outputs) {
+    ORT_RETURN_IF_ERROR(CheckBatchAxis(*output, axis, "output"));
+  }
+  return Status::OK();
+}
+
+DynamicBatcher::DynamicBatcher(InferenceSession& session, concurrency::ThreadPool* thread_pool,
+                               AllocatorPtr allocator, int64_t max_batch_size, std::chrono::microseconds timeout,
+                               int64_t batch_axis)
+    : session_(session),
+      thread_pool_(thread_pool),
+      allocator_(std::move(allocator)),
+      max_batch_size_(max_batch_size),
+      timeout_(timeout),
+      batch_axis_(batch_axis) {
+  ORT_ENFORCE(max_batch_size_ > 1, "Dynamic batching requires a max batch size greater than 1");
+  ORT_ENFORCE(batch_axis_ >= 0, "Dynamic batching axis must be non-negative");
+  flush_thread_ = std::thread([this]() { FlushLoop(); });
+}
+
+DynamicBatcher::~DynamicBatcher() {
+  std::vector<std::shared_ptr<Batch>> remaining;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+    for (auto& entry : pending_) {
+      remaining.push_back(std::move(entry.second));
+    }
+    pending_.clear();
+  }
+  flush_cv_.notify_all();
+  flush_thread_.join();
+
+  Dispatch(remaining);
+
+  std::unique_lock<std::mutex> lock(in_flight_mutex_);
+  in_flight_cv_.wait(lock, [this]() { return in_flight_ == 0; });
+}
+
+bool DynamicBatcher::GetSignature(gsl::span<const char* const> feed_names, gsl::span<const OrtValue* const> feeds,
+                                  gsl::span<const char* const> fetch_names, std::string& signature,
+                                  int64_t& batch_size) const {
+  if (feeds.empty() || fetch_names.empty()) {
+    return false;
+  }
+
+  const auto axis = static_cast<size_t>(batch_axis_);
+  batch_size = -1;
+  signature.clear();
+
+  for (size_t i = 0; i < feeds.size(); ++i) {
+    if (feed_names[i] == nullptr || feeds[i] == nullptr || !feeds[i]->IsTensor()) {
+      return false;
+    }
+
+    const Tensor& tensor = feeds[i]->Get<Tensor>();
+    const TensorShape& shape = tensor.Shape();
+    if (tensor.IsDataTypeString() || tensor.Location().device.Type() != OrtDevice::CPU ||
+        shape.NumDimensions() <= axis) {
+      return false;
+    }
+
+    // Every feed of a request must agree on its batch size.
+    if (batch_size == -1) {
+      batch_size = shape[axis];
+    } else if (shape[axis] != batch_size) {
+      return false;
+    }
+
+    signature.append(feed_names[i]).append(":").append(std::to_string(tensor.GetElementType()));
+    for (size_t d = 0; d < shape.NumDimensions(); ++d) {
+      signature.append(",").append(d == axis ? "?" : std::to_string(shape[d]));
+    }
+    signature.append(";");
+  }
+
+  signature.append("->");
+  for (const char* name : fetch_names) {
+    if (name == nullptr) {
+      return false;
+    }
+    signature.append(name).append(";");
+  }
+
+  return batch_size > 0 && batch_size < max_batch_size_;
+}
+
+bool DynamicBatcher::TrySubmit(const RunOptions* run_options,
+                               gsl::span<const char* const> feed_names,
+                               gsl::span<const OrtValue* const> feeds,
+                               gsl::span<const char* const> fetch_names,
+                               gsl::span<OrtValue*> fetches,
+                               RunAsyncCallbackFn callback,
+                               void* user_data) {
+  std::string signature;
+  int64_t batch_size = 0;
+  if (!GetSignature(feed_names, feeds, fetch_names, signature, batch_size)) {
+    return false;
+  }
+
+  Request request{run_options, {}, fetches, callback, user_data, batch_size};
+  request.feeds.reserve(feeds.size());
+  for (const OrtValue* feed : feeds) {
+    request.feeds.push_back(*feed);
+  }
+
+  std::vector<std::shared_ptr<Batch>> ready;
+  bool new_deadline = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (shutdown_) {
+      return false;
+    }
+
+    auto& batch = pending_[signature];
+
+    // Close the current batch if this request would overflow it.
+    if (batch && batch->batch_size + batch_size > max_batch_size_) {
+      ready.push_back(std::move(batch));
+    }
+
+    if (!batch) {
+      batch = std::make_shared<Batch>();
+      batch->feed_names.assign(feed_names.begin(), feed_names.end());
+      batch->fetch_names.assign(fetch_names.begin(), fetch_names.end());
+      batch->deadline = std::chrono::steady_clock::now() + timeout_;
+      new_deadline = true;
+    }
+
+    batch->batch_size += batch_size;
+    batch->requests.push_back(std::move(request));
+
+    if (batch->batch_size == max_batch_size_) {
+      ready.push_back(std::move(batch));
+    }
+
+    if (!pending_[signature]) {
+      pending_.erase(signature);
+    }
+  }
+
+  if (new_deadline) {
+    flush_cv_.notify_one();
+  }
+
+  Dispatch(ready);
+  return true;
+}
+
+void DynamicBatcher::FlushLoop() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!shutdown_) {
+    const auto now = std::chrono::steady_clock::now();
+    auto next_deadline = std::chrono::steady_clock::time_point::max();
+    std::vector<std::shared_ptr<Batch>> expired;
+
+    for (auto it = pending_.begin(); it != pending_.end();) {
+      if (it->second->deadline <= now) {
+        expired.push_back(std::move(it->second));
+        it = pending_.erase(it);
+      } else {
+        next_deadline = std::min(next_deadline, it->second->deadline);
+        ++it;
+      }
+    }
+
+    if (!expired.empty()) {
+      // Schedule outside the lock: the thread pool may run a task inline when its queue is full.
+      lock.unlock();
+      Dispatch(expired);
+      lock.lock();
+      continue;
+    }
+
+    if (next_deadline == std::chrono::steady_clock::time_point::max()) {
+      flush_cv_.wait(lock);
+    } else {
+      flush_cv_.wait_until(lock, next_deadline);
+    }
+  }
+}
+
+void DynamicBatcher::Dispatch(std::vector<std::shared_ptr<Batch>>& batches) {
+  for (auto& batch : batches) {
+    {
+      std::lock_guard<std::mutex> lock(in_flight_mutex_);
+      ++in_flight_;
+    }
+
+    concurrency::ThreadPool::Schedule(thread_pool_, [this, batch]() {
+      RunBatch(*batch);
+
+      std::lock_guard<std::mutex> lock(in_flight_mutex_);
+      if (--in_flight_ == 0) {
+        in_flight_cv_.notify_all();
+      }
+    });
+  }
+  batches.clear();
+}
+
+void DynamicBatcher::RunBatch(Batch& batch) {
+  Status status;
+  ORT_TRY {
+    status = RunAndSplit(batch);
+  }
+  ORT_CATCH(const std::exception& ex) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+    });
+  }
+  ORT_CATCH(...) {
+    status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, "unknown exception");
+  }
+
+  const size_t num_fetches = batch.fetch_names.size();
+  for (auto& request : batch.requests) {
+    request.callback(request.user_data, request.fetches.data(), status.IsOK() ? num_fetches : 0,
+                     ToOrtStatus(status));
+  }
+}
+
+Status DynamicBatcher::RunAndSplit(Batch& batch) {
+  const auto axis = static_cast<size_t>(batch_axis_);
+  const size_t num_feeds = batch.feed_names.size();
+  const size_t num_fetches = batch.fetch_names.size();
+  const bool single = batch.requests.size() == 1;
+
+  // 1. Concatenate the feeds of all requests along the batch axis
+  std::vector<OrtValue> feeds(num_feeds);
+  InlinedVector<const Tensor*> parts;
+  for (size_t i = 0; i < num_feeds; ++i) {
+    if (single) {
+      feeds[i] = batch.requests[0].feeds[i];
+      continue;
+    }
+
+    parts.clear();
+    for (const auto& request : batch.requests) {
+      parts.push_back(&request.feeds[i].Get<Tensor>());
+    }
+
+    TensorShape shape = parts[0]->Shape();
+    shape[axis] = batch.batch_size;
+    Tensor::InitOrtValue(parts[0]->DataType(), shape, allocator_, feeds[i]);
+    ConcatAlongAxis(parts, axis, *feeds[i].GetMutable<Tensor>());
+  }
+
+  // 2. One Run for the whole batch. A lone request keeps its pre-allocated fetches.
+  std::vector<OrtValue> fetches(num_fetches);
+  if (single) {
+    for (size_t i = 0; i < num_fetches; ++i) {
+      if (batch.requests[0].fetches[i] != nullptr) {
+        fetches[i] = *batch.requests[0].fetches[i];
+      }
+    }
+  }
+
+  RunOptions default_run_options;
+  const RunOptions& run_options =
+      batch.requests[0].run_options != nullptr ? *batch.requests[0].run_options : default_run_options;
+  ORT_RETURN_IF_ERROR(session_.Run(run_options, batch.feed_names, feeds, batch.fetch_names, &fetches));
+
+  // 3. Slice every fetch for each request, into the caller's buffer or a new value
+  std::vector<std::unique_ptr<OrtValue>> slices(single ? 0 : batch.requests.size() * num_fetches);
+  for (size_t i = 0; i < num_fetches; ++i) {
+    if (single) {
+      continue;
+    }
+
+    if (!fetches[i].IsTensor()) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Dynamic batching requires tensor outputs. Output '",
+                             batch.fetch_names[i], "' is not a tensor.");
+    }
+
+    const Tensor& output = fetches[i].Get<Tensor>();
+    if (output.IsDataTypeString() || output.Location().device.Type() != OrtDevice::CPU ||
+        output.Shape().NumDimensions() <= axis || output.Shape()[axis] != batch.batch_size) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Output '", batch.fetch_names[i], "' with shape ",
+                             output.Shape(), " is not a CPU tensor batched along axis ", batch_axis_,
+                             " with size ", batch.batch_size);
+    }
+
+    int64_t start = 0;
+    for (size_t r = 0; r < batch.requests.size(); ++r) {
+      auto& request = batch.requests[r];
+      TensorShape shape = output.Shape();
+      shape[axis] = request.batch_size;
+
+      OrtValue* fetch = request.fetches[i];
+      if (fetch != nullptr) {
+        // Caller-provided output buffer.
+        if (!fetch->IsTensor() || fetch->Get<Tensor>().Shape() != shape ||
+            fetch->Get<Tensor>().DataType() != output.DataType()) {
+          return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Pre-allocated output '", batch.fetch_names[i],
+                                 "' does not match the expected shape ", shape);
+        }
+        SliceAlongAxis(output, axis, start, *fetch->GetMutable<Tensor>());
+      } else {
+        auto& slice = slices[r * num_fetches + i];
+        slice = std::make_unique<OrtValue>();
+        Tensor::InitOrtValue(output.DataType(), shape, allocator_, *slice);
+        SliceAlongAxis(output, axis, start, *slice->GetMutable<Tensor>());
+      }
+      start += request.batch_size;
+    }
+  }
+
+  // 4. Every fetch was split, so hand over the slices. Until here they are released if any step fails.
+  for (size_t r = 0; r < slices.size(); ++r) {
+    if (slices[r] != nullptr) {
+      batch.requests[r / num_fetches].fetches[r % num_fetches] = slices[r].release();
+    }
+  }
+
+  if (single) {
+    auto& request = batch.requests[0];
+    for (size_t i = 0; i < num_fetches; ++i) {
+      if (request.fetches[i] == nullptr) {
+        request.fetches[i] = std::make_unique<OrtValue>(fetches[i]).release();
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
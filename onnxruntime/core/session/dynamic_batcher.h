@@ -0,0 +1,117 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
+#include "core/session/onnxruntime_c_api.h"
+
+struct OrtRunOptions;
+
+namespace onnxruntime {
+
+class InferenceSession;
+using RunOptions = ::OrtRunOptions;
+
+namespace concurrency {
+class ThreadPool;
+}
+
+/**
+ * Server-side dynamic batching for InferenceSession::RunAsync.
+ *
+ * Concurrent RunAsync calls with the same feed/fetch names, element types and shapes (other than the batch axis)
+ * are queued together. A queue is run as one Run once its combined batch reaches max_batch_size or its oldest
+ * request has waited `timeout`. Feeds are concatenated along `batch_axis`. Each fetch is split back along the same
+ * axis, and every caller's callback gets its own slice.
+ *
+ * Only CPU, non-string tensor feeds qualify; TrySubmit returns false for anything else and the caller runs the
+ * request unbatched. The run options of the first request in a batch apply to the whole batch.
+ */
+class DynamicBatcher {
+ public:
+  DynamicBatcher(InferenceSession& session, concurrency::ThreadPool* thread_pool, AllocatorPtr allocator,
+                 int64_t max_batch_size, std::chrono::microseconds timeout, int64_t batch_axis);
+
+  /// Flushes every queued request and waits for all batches in flight.
+  ~DynamicBatcher();
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(DynamicBatcher);
+
+  /**
+   * Checks that every graph input and output of `session` has a dimension at `batch_axis` that is not fixed, so
+   * requests can be concatenated along it. Inputs and outputs of unknown rank are accepted.
+   */
+  static Status CheckModelIsBatchable(const InferenceSession& session, int64_t batch_axis);
+
+  /**
+   * Queue a RunAsync request. Returns false if the request cannot be batched; the caller must then run it itself.
+   * When true is returned `callback` is invoked exactly once, from a thread pool thread.
+   */
+  bool TrySubmit(const RunOptions* run_options,
+                 gsl::span<const char* const> feed_names,
+                 gsl::span<const OrtValue* const> feeds,
+                 gsl::span<const char* const> fetch_names,
+                 gsl::span<OrtValue*> fetches,
+                 RunAsyncCallbackFn callback,
+                 void* user_data);
+
+ private:
+  struct Request {
+    const RunOptions* run_options;
+    InlinedVector<OrtValue> feeds;
+    gsl::span<OrtValue*> fetches;
+    RunAsyncCallbackFn callback;
+    void* user_data;
+    int64_t batch_size;
+  };
+
+  struct Batch {
+    std::vector<std::string> feed_names;
+    std::vector<std::string> fetch_names;
+    std::vector<Request> requests;
+    int64_t batch_size = 0;
+    std::chrono::steady_clock::time_point deadline;
+  };
+
+  // Builds the queue key for a request and reads its batch size. Returns false if the request is not batchable.
+  bool GetSignature(gsl::span<const char* const> feed_names, gsl::span<const OrtValue* const> feeds,
+                    gsl::span<const char* const> fetch_names, std::string& signature, int64_t& batch_size) const;
+
+  void Dispatch(std::vector<std::shared_ptr<Batch>>& batches);
+  void RunBatch(Batch& batch);
+  Status RunAndSplit(Batch& batch);
+  void FlushLoop();
+
+  InferenceSession& session_;
+  concurrency::ThreadPool* const thread_pool_;
+  const AllocatorPtr allocator_;
+  const int64_t max_batch_size_;
+  const std::chrono::microseconds timeout_;
+  const int64_t batch_axis_;
+
+  std::mutex mutex_;
+  std::condition_variable flush_cv_;
+  std::unordered_map<std::string, std::shared_ptr<Batch>> pending_;  // GUARDED_BY(mutex_)
+  bool shutdown_ = false;                                            // GUARDED_BY(mutex_)
+
+  std::mutex in_flight_mutex_;
+  std::condition_variable in_flight_cv_;
+  size_t in_flight_ = 0;  // GUARDED_BY(in_flight_mutex_)
+
+  std::thread flush_thread_;
+};
+
+}  // namespace onnxruntime
@@ -24,6 +24,7 @@
 #include "core/framework/execution_frame.h"
 #include "core/framework/feeds_fetches_manager.h"
 #include "core/framework/graph_partitioner.h"
+#include "core/framework/initializer_prefetcher.h"
 #include "core/framework/kernel_def_builder.h"
 #include "core/framework/kernel_registry.h"
 #include "core/framework/kernel_type_str_resolver.h"
@@ -68,6 +69,7 @@
 #include "core/providers/dml/DmlExecutionProvider/src/ExecutionProvider.h"
 #include "core/optimizer/stft_decomposition.h"
 #endif
+#include "core/session/dynamic_batcher.h"
 #include "core/session/environment.h"
 #include "core/session/IOBinding.h"
 #include "core/session/inference_session_utils.h"
@@ -385,6 +387,7 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
   // Update the number of steps for the graph transformer manager using the "finalized" session options
   ORT_THROW_IF_ERROR(graph_transformer_mgr_.SetSteps(session_options_.max_num_graph_transformation_steps));
   graph_transformer_mgr_.SetLoadCancellationFn(this->check_load_cancellation_fn_);
+  graph_transformer_mgr_.SetProfiler(&session_profiler_);
 #endif
 
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
@@ -442,6 +445,8 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
         // If the thread pool can use all the processors, then
         // we set affinity of each thread to each processor.
         to.allow_spinning = allow_intra_op_spinning;
+        to.numa_aware =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpNumaAware, "0") == "1";
         to.dynamic_block_base_ = std::stoi(session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBlockBase, "0"));
         LOGS(*session_logger_, INFO) << "Dynamic block base set to " << to.dynamic_block_base_;
 
@@ -730,6 +735,10 @@ InferenceSession::InferenceSession(const SessionOptions& session_options, const
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 InferenceSession::~InferenceSession() {
+  // Drain queued RunAsync requests while the session state is still alive.
+  dynamic_batcher_.reset();
+  initializer_prefetcher_.reset();
+
   if (session_options_.enable_profiling) {
     ORT_TRY {
       EndProfiling();
@@ -2053,9 +2062,20 @@ common::Status InferenceSession::Initialize() {
 
     // Register default CPUExecutionProvider if user didn't provide it through the Register() calls.
     // RegisterExecutionProvider locks the session_mutex_ so we can't be holding it when we call that
+    // The CPU EP factory reads this option too, so check it whether or not the CPU EP was added explicitly.
+    const int cpu_arena_huge_pages = ParseStringWithClassicLocale<int>(
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsCpuArenaHugePages, "-1"));
+    if (cpu_arena_huge_pages < -1 || cpu_arena_huge_pages > 2) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ", kOrtSessionOptionsCpuArenaHugePages,
+                             ": ", cpu_arena_huge_pages, ". Expected -1, 0, 1 or 2.");
+    }
+
     if (!have_cpu_ep) {
       LOGS(*session_logger_, INFO) << "Adding default CPU execution provider.";
       CPUExecutionProviderInfo epi{session_options_.enable_cpu_mem_arena};
+      epi.arena_thread_local_cache_bytes = ParseStringWithClassicLocale<int64_t>(
+          session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsCpuArenaThreadLocalCacheBytes, "-1"));
+      epi.arena_huge_pages = cpu_arena_huge_pages;
       auto p_cpu_exec_provider = std::make_unique<CPUExecutionProvider>(epi);
       ORT_RETURN_IF_ERROR_SESSIONID_(RegisterExecutionProvider(std::move(p_cpu_exec_provider)));
       execution_providers_.SetCpuProviderWasImplicitlyAdded(true);
@@ -2487,8 +2507,54 @@ common::Status InferenceSession::Initialize() {
     // Resolve memory pattern flags of the main graph and subgraph session states
     ResolveMemoryPatternFlags(*session_state_);
 
+    if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableCpuReplay, "0") == "1" &&
+        !session_state_->EnableCpuReplay()) {
+      LOGS(*session_logger_, WARNING) << "CPU replay was requested but the model is not eligible: every node must "
+                                      << "run on the CPU EP in a single stream without control flow.";
+    }
+
+    if (session_options_.execution_mode == ExecutionMode::ORT_PARALLEL &&
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsCriticalPathExecutor, "0") == "1" &&
+        !session_state_->EnableCriticalPathExecutor()) {
+      LOGS(*session_logger_, WARNING) << "The critical path executor was requested but the model is not eligible: "
+                                      << "every node must run on the CPU EP without control flow, and the intra-op "
+                                      << "thread pool must have more than one thread.";
+    }
+
     is_inited_ = true;
 
+    const int64_t dynamic_batching_max_batch_size = ParseStringWithClassicLocale<int64_t>(
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsDynamicBatchingMaxBatchSize, "0"));
+    if (dynamic_batching_max_batch_size > 1) {
+      const int64_t timeout_us = ParseStringWithClassicLocale<int64_t>(
+          session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsDynamicBatchingTimeoutUs, "1000"));
+      const int64_t batch_axis = ParseStringWithClassicLocale<int64_t>(
+          session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsDynamicBatchingAxis, "0"));
+      auto* intra_op_tp = GetIntraOpThreadPoolToUse();
+      const Status batchable = DynamicBatcher::CheckModelIsBatchable(*this, batch_axis);
+      if (!batchable.IsOK()) {
+        LOGS(*session_logger_, WARNING) << "Dynamic batching is disabled: " << batchable.ErrorMessage()
+                                        << " RunAsync requests will not be batched.";
+      } else if (intra_op_tp && concurrency::ThreadPool::DegreeOfParallelism(intra_op_tp) >= 2) {
+        dynamic_batcher_ = std::make_unique<DynamicBatcher>(*this, intra_op_tp,
+                                                            session_state_->GetAllocator(OrtDevice()),
+                                                            dynamic_batching_max_batch_size,
+                                                            std::chrono::microseconds(timeout_us), batch_axis);
+      } else {
+        LOGS(*session_logger_, WARNING) << "Dynamic batching requires an intra op thread pool with at least 2 threads. "
+                                        << "RunAsync requests will not be batched.";
+      }
+    }
+
+    if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsPrefetchInitializers, "0") == "1") {
+      ThreadOptions prefetch_thread_options;
+      prefetch_thread_options.custom_create_thread_fn = session_options_.custom_create_thread_fn;
+      prefetch_thread_options.custom_thread_creation_options = session_options_.custom_thread_creation_options;
+      prefetch_thread_options.custom_join_thread_fn = session_options_.custom_join_thread_fn;
+      initializer_prefetcher_ = std::make_unique<InitializerPrefetcher>(*session_state_, *session_logger_,
+                                                                        prefetch_thread_options);
+    }
+
     if (!using_ort_model_bytes_for_initializers_) {
       ort_format_model_bytes_ = gsl::span<const uint8_t>();
       std::vector<uint8_t>().swap(ort_format_model_bytes_data_holder_);
@@ -3070,6 +3136,8 @@ Status InferenceSession::Run(const RunOptions& run_options,
     if (!arenas_to_shrink.empty()) {
       ShrinkMemoryArenas(arenas_to_shrink);
     }
+
+    FlushArenaThreadCaches();
   }
 
   // keep track of telemetry
@@ -3231,6 +3299,10 @@ common::Status InferenceSession::RunAsync(const RunOptions* run_options,
   if (!tp || concurrency::ThreadPool::DegreeOfParallelism(tp) < 2) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "intra op thread pool must have at least one thread for RunAsync");
   }
+  if (dynamic_batcher_ &&
+      dynamic_batcher_->TrySubmit(run_options, feed_names, feeds, fetch_names, fetches, callback, user_data)) {
+    return Status::OK();
+  }
   std::function<void()> run_fn = [run_options, feed_names, feeds, fetch_names, fetches, num_fetches,
                                   callback, user_data, this]() {
     Status status = Status::OK();
@@ -3651,6 +3723,12 @@ void InferenceSession::ShrinkMemoryArenas(gsl::span<const AllocatorPtr> arenas_t
   }
 }
 
+void InferenceSession::FlushArenaThreadCaches() {
+  for (const auto& [device, allocator_ptr] : session_state_->GetAllocators()) {
+    allocator_ptr->FlushCurrentThreadCache();
+  }
+}
+
 #if !defined(ORT_MINIMAL_BUILD)
 // assumes model has already been loaded before
 common::Status InferenceSession::DoPostLoadProcessing(onnxruntime::Model& model) {
@@ -3778,6 +3856,14 @@ common::Status InferenceSession::AddPredefinedTransformers(
     MinimalBuildOptimizationHandling minimal_build_optimization_handling,
     RecordRuntimeOptimizationProducedNodeOpSchemaFn record_runtime_optimization_produced_op_schema_fn,
     const logging::Logger& logger) const {
+  const std::string fast_gelu_fusion_domain =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsFastGeluFusionDomain, kMSDomain);
+  if (fast_gelu_fusion_domain != kMSDomain && fast_gelu_fusion_domain != kMyCustomDomain) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value for ", kOrtSessionOptionsFastGeluFusionDomain,
+                           ": '", fast_gelu_fusion_domain, "'. Expected '", kMSDomain, "' or '", kMyCustomDomain,
+                           "'.");
+  }
+
   const auto& cpu_ep = *execution_providers_.Get(onnxruntime::kCpuExecutionProvider);
   for (int i = static_cast<int>(TransformerLevel::Default); i <= static_cast<int>(TransformerLevel::MaxLevel); i++) {
     TransformerLevel level = static_cast<TransformerLevel>(i);
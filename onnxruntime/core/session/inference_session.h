@@ -52,9 +52,11 @@ struct OrtModel;
 
 namespace onnxruntime {  // forward declarations
 class CustomRegistry;
+class DynamicBatcher;
 class Environment;
 class GraphTransformer;
 class IExecutionProvider;
+class InitializerPrefetcher;
 class IOBinding;
 struct Notification;
 
@@ -822,6 +824,13 @@ class InferenceSession {
    */
   void ShrinkMemoryArenas(gsl::span<const AllocatorPtr> arenas_to_shrink);
 
+  /*
+   * Returns the chunks held in the calling thread's cache of the session's allocators at the end of a Run.
+   * The caches of other threads are left alone so concurrent runs keep their cached chunks; those caches are
+   * bounded by the cache size and returned when full.
+   */
+  void FlushArenaThreadCaches();
+
 #ifdef _WIN32
   static void LogAllSessions();
 #endif
@@ -927,6 +936,12 @@ class InferenceSession {
   // Number of concurrently running executors
   std::atomic<int> current_num_runs_ = 0;
 
+  // Batches concurrent RunAsync requests. Only set when kOrtSessionOptionsDynamicBatchingMaxBatchSize is > 1.
+  std::unique_ptr<DynamicBatcher> dynamic_batcher_;
+
+  // Pages in the CPU initializers after Initialize. Only set when kOrtSessionOptionsPrefetchInitializers is "1".
+  std::unique_ptr<InitializerPrefetcher> initializer_prefetcher_;
+
   mutable std::mutex session_mutex_;         // to ensure only one thread can invoke Load/Initialize
   bool is_model_loaded_ = false;             // GUARDED_BY(session_mutex_)
   bool is_inited_ = false;                   // GUARDED_BY(session_mutex_)
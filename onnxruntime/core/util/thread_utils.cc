@@ -24,6 +24,7 @@ std::ostream& operator<<(std::ostream& os, const OrtThreadPoolParams& params) {
   os << " affinity_str: " << params.affinity_str;
   // os << " name: " << (params.name ? params.name : L"nullptr");
   os << " set_denormal_as_zero: " << params.set_denormal_as_zero;
+  os << " numa_aware: " << params.numa_aware;
   // os << " custom_create_thread_fn: " << (params.custom_create_thread_fn ? "set" : "nullptr");
   // os << " custom_thread_creation_options: " << (params.custom_thread_creation_options ? "set" : "nullptr");
   // os << " custom_join_thread_fn: " << (params.custom_join_thread_fn ? "set" : "nullptr");
@@ -93,7 +94,7 @@ static std::unique_ptr<ThreadPool>
 CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
   ThreadOptions to;
   if (options.thread_pool_size <= 0) {  // default
-    if (options.auto_set_affinity) {
+    if (options.auto_set_affinity || options.numa_aware) {
 #ifdef _WIN32
       // Only set thread affinity on Server with auto affinity.
       // On client best to let OS scheduler handle.
@@ -145,6 +146,18 @@ CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
 #endif
   }
 
+  if (options.numa_aware) {
+    if (to.affinities.empty()) {
+      LOGS_DEFAULT(WARNING) << "A NUMA aware thread pool requires thread affinities. "
+                            << "Use the default pool size or set the affinities explicitly.";
+    } else {
+      to.numa_nodes.reserve(to.affinities.size());
+      for (const auto& affinity : to.affinities) {
+        to.numa_nodes.push_back(affinity.empty() ? -1 : env->GetNumaNodeOfLogicalProcessor(affinity.front()));
+      }
+    }
+  }
+
   to.set_denormal_as_zero = options.set_denormal_as_zero;
   // set custom thread management members
   to.custom_create_thread_fn = options.custom_create_thread_fn;
@@ -48,6 +48,11 @@ struct OrtThreadPoolParams {
   // Set or unset denormal as zero
   bool set_denormal_as_zero = false;
 
+  // If it is true, the threads are grouped by the NUMA node of their affinity: work stealing stays within a node
+  // while the node has work, and loops can be partitioned by node (ThreadPool::TryParallelForByNumaNode).
+  // Requires thread affinities; with the default pool size they are set as with auto_set_affinity.
+  bool numa_aware = false;
+
   // members to manage custom threads
   OrtCustomCreateThreadFn custom_create_thread_fn = nullptr;
   void* custom_thread_creation_options = nullptr;
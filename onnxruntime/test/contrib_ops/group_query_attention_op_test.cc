@@ -0,0 +1,200 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// Symmetric per-row int8 quantization, as done by the CPU kernel when it appends to an int8 cache.
+void QuantizeRow(const float* row, size_t head_size, int8_t* quantized, float* scale) {
+  float max_abs = 0.0f;
+  for (size_t h = 0; h < head_size; ++h) {
+    max_abs = std::max(max_abs, std::abs(row[h]));
+  }
+  *scale = max_abs > 0.0f ? max_abs / 127.0f : 1.0f;
+  for (size_t h = 0; h < head_size; ++h) {
+    const float value = std::nearbyint(row[h] / *scale);
+    quantized[h] = static_cast<int8_t>(std::min(127.0f, std::max(-128.0f, value)));
+  }
+}
+
+struct Int8CacheTestCase {
+  int batch_size;
+  int num_heads;
+  int kv_num_heads;
+  int head_size;
+  int past_sequence_length;  // valid rows in the past cache
+  int max_sequence_length;   // rows in the past and present cache buffers
+};
+
+// Runs one decoding step of GroupQueryAttention with an int8 past/present cache and compares it against attention
+// computed in float over the dequantized cache.
+void RunInt8CacheTest(const Int8CacheTestCase& c) {
+  const size_t batch_size = c.batch_size;
+  const size_t num_heads = c.num_heads;
+  const size_t kv_num_heads = c.kv_num_heads;
+  const size_t head_size = c.head_size;
+  const size_t past_length = c.past_sequence_length;
+  const size_t max_length = c.max_sequence_length;
+  const size_t total_length = past_length + 1;
+  const size_t group_size = num_heads / kv_num_heads;
+
+  RandomValueGenerator random{1234};
+  const std::vector<float> query = random.Uniform<float>(
+      std::vector<int64_t>{c.batch_size, 1, c.num_heads * c.head_size}, -1.0f, 1.0f);
+  const std::vector<float> key = random.Uniform<float>(
+      std::vector<int64_t>{c.batch_size, 1, c.kv_num_heads * c.head_size}, -1.0f, 1.0f);
+  const std::vector<float> value = random.Uniform<float>(
+      std::vector<int64_t>{c.batch_size, 1, c.kv_num_heads * c.head_size}, -1.0f, 1.0f);
+  const std::vector<float> past_key_float = random.Uniform<float>(
+      std::vector<int64_t>{c.batch_size, c.kv_num_heads, c.max_sequence_length, c.head_size}, -1.0f, 1.0f);
+  const std::vector<float> past_value_float = random.Uniform<float>(
+      std::vector<int64_t>{c.batch_size, c.kv_num_heads, c.max_sequence_length, c.head_size}, -1.0f, 1.0f);
+
+  // the past cache has `past_length` valid rows, and the kernel appends the new row after them
+  const size_t num_rows = batch_size * kv_num_heads * max_length;
+  std::vector<int8_t> past_key(num_rows * head_size, 0);
+  std::vector<int8_t> past_value(num_rows * head_size, 0);
+  std::vector<float> past_key_scale(num_rows, 0.0f);
+  std::vector<float> past_value_scale(num_rows, 0.0f);
+  std::vector<int8_t> present_key(num_rows * head_size, 0);
+  std::vector<int8_t> present_value(num_rows * head_size, 0);
+  std::vector<float> present_key_scale(num_rows, 0.0f);
+  std::vector<float> present_value_scale(num_rows, 0.0f);
+  for (size_t kv = 0; kv < batch_size * kv_num_heads; ++kv) {
+    for (size_t row = 0; row < past_length; ++row) {
+      const size_t r = kv * max_length + row;
+      QuantizeRow(past_key_float.data() + r * head_size, head_size, past_key.data() + r * head_size,
+                  past_key_scale.data() + r);
+      QuantizeRow(past_value_float.data() + r * head_size, head_size, past_value.data() + r * head_size,
+                  past_value_scale.data() + r);
+    }
+    std::copy_n(past_key.begin() + kv * max_length * head_size, past_length * head_size,
+                present_key.begin() + kv * max_length * head_size);
+    std::copy_n(past_value.begin() + kv * max_length * head_size, past_length * head_size,
+                present_value.begin() + kv * max_length * head_size);
+    std::copy_n(past_key_scale.begin() + kv * max_length, past_length, present_key_scale.begin() + kv * max_length);
+    std::copy_n(past_value_scale.begin() + kv * max_length, past_length,
+                present_value_scale.begin() + kv * max_length);
+
+    const size_t r = kv * max_length + past_length;
+    QuantizeRow(key.data() + kv * head_size, head_size, present_key.data() + r * head_size,
+                present_key_scale.data() + r);
+    QuantizeRow(value.data() + kv * head_size, head_size, present_value.data() + r * head_size,
+                present_value_scale.data() + r);
+  }
+
+  // reference attention over the dequantized present cache
+  std::vector<float> output(batch_size * num_heads * head_size, 0.0f);
+  const float alpha = 1.0f / std::sqrt(static_cast<float>(head_size));
+  for (size_t b = 0; b < batch_size; ++b) {
+    for (size_t n = 0; n < num_heads; ++n) {
+      const size_t kv = b * kv_num_heads + n / group_size;
+      const float* q = query.data() + (b * num_heads + n) * head_size;
+
+      std::vector<float> probs(total_length);
+      float max_logit = -std::numeric_limits<float>::infinity();
+      for (size_t t = 0; t < total_length; ++t) {
+        const size_t r = kv * max_length + t;
+        float dot = 0.0f;
+        for (size_t h = 0; h < head_size; ++h) {
+          dot += q[h] * present_key[r * head_size + h] * present_key_scale[r];
+        }
+        probs[t] = dot * alpha;
+        max_logit = std::max(max_logit, probs[t]);
+      }
+      float sum = 0.0f;
+      for (float& p : probs) {
+        p = std::exp(p - max_logit);
+        sum += p;
+      }
+
+      float* out = output.data() + (b * num_heads + n) * head_size;
+      for (size_t t = 0; t < total_length; ++t) {
+        const size_t r = kv * max_length + t;
+        for (size_t h = 0; h < head_size; ++h) {
+          out[h] += probs[t] / sum * present_value[r * head_size + h] * present_value_scale[r];
+        }
+      }
+    }
+  }
+
+  const std::vector<int64_t> cache_dims = {c.batch_size, c.kv_num_heads, c.max_sequence_length, c.head_size};
+  const std::vector<int64_t> scale_dims = {c.batch_size, c.kv_num_heads, c.max_sequence_length};
+
+  OpTester test("GroupQueryAttention", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("num_heads", c.num_heads);
+  test.AddAttribute<int64_t>("kv_num_heads", c.kv_num_heads);
+  test.AddInput<float>("query", {c.batch_size, 1, c.num_heads * c.head_size}, query);
+  test.AddInput<float>("key", {c.batch_size, 1, c.kv_num_heads * c.head_size}, key);
+  test.AddInput<float>("value", {c.batch_size, 1, c.kv_num_heads * c.head_size}, value);
+  test.AddInput<int8_t>("past_key", cache_dims, past_key);
+  test.AddInput<int8_t>("past_value", cache_dims, past_value);
+  test.AddInput<int32_t>("seqlens_k", {c.batch_size},
+                         std::vector<int32_t>(batch_size, static_cast<int32_t>(past_length)));
+  test.AddInput<int32_t>("total_sequence_length", {1}, {static_cast<int32_t>(total_length)});
+  test.AddOptionalInputEdge<float>();    // cos_cache
+  test.AddOptionalInputEdge<float>();    // sin_cache
+  test.AddOptionalInputEdge<int64_t>();  // position_ids
+  test.AddOptionalInputEdge<float>();    // attention_bias
+  test.AddOptionalInputEdge<float>();    // head_sink
+  test.AddInput<float>("past_key_scale", scale_dims, past_key_scale);
+  test.AddInput<float>("past_value_scale", scale_dims, past_value_scale);
+
+  test.AddOutput<float>("output", {c.batch_size, 1, c.num_heads * c.head_size}, output);
+  test.AddOutput<int8_t>("present_key", cache_dims, present_key);
+  test.AddOutput<int8_t>("present_value", cache_dims, present_value);
+  test.AddOptionalOutputEdge<float>();  // output_qk
+  test.AddOutput<float>("present_key_scale", scale_dims, present_key_scale);
+  test.AddOutput<float>("present_value_scale", scale_dims, present_value_scale);
+  test.SetOutputAbsErr("output", 1e-4f);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+}  // namespace
+
+TEST(GroupQueryAttentionTest, Int8KVCache) {
+  RunInt8CacheTest({1, 4, 2, 16, 5, 8});
+}
+
+TEST(GroupQueryAttentionTest, Int8KVCacheMultipleTiles) {
+  // 16KB tiles of fp32 rows hold 32 rows of 128 elements, so the cache spans several tiles
+  RunInt8CacheTest({2, 8, 2, 128, 70, 80});
+}
+
+TEST(GroupQueryAttentionTest, Int8KVCacheRequiresScales) {
+  const std::vector<int64_t> cache_dims = {1, 1, 4, 8};
+  OpTester test("GroupQueryAttention", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("num_heads", 1);
+  test.AddAttribute<int64_t>("kv_num_heads", 1);
+  test.AddInput<float>("query", {1, 1, 8}, std::vector<float>(8, 1.0f));
+  test.AddInput<float>("key", {1, 1, 8}, std::vector<float>(8, 1.0f));
+  test.AddInput<float>("value", {1, 1, 8}, std::vector<float>(8, 1.0f));
+  test.AddInput<int8_t>("past_key", cache_dims, std::vector<int8_t>(32, 0));
+  test.AddInput<int8_t>("past_value", cache_dims, std::vector<int8_t>(32, 0));
+  test.AddInput<int32_t>("seqlens_k", {1}, {1});
+  test.AddInput<int32_t>("total_sequence_length", {1}, {2});
+  test.AddOutput<float>("output", {1, 1, 8}, std::vector<float>(8, 0.0f));
+  test.AddOutput<int8_t>("present_key", cache_dims, std::vector<int8_t>(32, 0));
+  test.AddOutput<int8_t>("present_value", cache_dims, std::vector<int8_t>(32, 0));
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectFailure, "scale", {}, nullptr, &execution_providers);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -3,7 +3,10 @@
 
 #ifndef ORT_MINIMAL_BUILD
 
+#include <algorithm>
+#include <cmath>
 #include <optional>
+#include <string>
 
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
@@ -83,6 +86,7 @@ struct TestOptions {
   bool zp_is_4bit{true};
   bool has_g_idx{false};
   bool has_bias{false};
+  std::string activation{};
 
   bool legacy_shape{false};  // for backward compatibility
 
@@ -97,7 +101,21 @@ struct TestOptions {
             << ", has_zero_point:" << opts.has_zero_point
             << ", zp_is_4bit:" << opts.zp_is_4bit
             << ", has_g_idx:" << opts.has_g_idx
-            << ", has_bias:" << opts.has_bias;
+            << ", has_bias:" << opts.has_bias
+            << ", activation:" << opts.activation;
+}
+
+float ApplyActivation(const std::string& activation, float x) {
+  if (activation == "Relu") {
+    return std::max(x, 0.0f);
+  } else if (activation == "Gelu") {
+    return 0.5f * x * (1.0f + std::erf(x * static_cast<float>(M_SQRT1_2)));
+  } else if (activation == "FastGelu") {
+    return 0.5f * x * (1.0f + std::tanh(0.7978845608f * (x + 0.044715f * x * x * x)));
+  } else if (activation == "Silu") {
+    return x / (1.0f + std::exp(-x));
+  }
+  return x;
 }
 
 template <typename T1>
@@ -158,7 +176,7 @@ void RunTest(const TestOptions& opts,
       for (int64_t k = 0; k < K; k++) {
         sum += input0_vals[m * K + k] * input1_f_vals[n * K + k];
       }
-      expected_vals[m * N + n] = sum + (bias.has_value() ? (*bias)[n] : 0.0f);
+      expected_vals[m * N + n] = ApplyActivation(opts.activation, sum + (bias.has_value() ? (*bias)[n] : 0.0f));
     }
   }
 
@@ -168,6 +186,9 @@ void RunTest(const TestOptions& opts,
   test.AddAttribute<int64_t>("block_size", opts.block_size);
   test.AddAttribute<int64_t>("bits", QBits);
   test.AddAttribute<int64_t>("accuracy_level", opts.accuracy_level);
+  if (!opts.activation.empty()) {
+    test.AddAttribute<std::string>("activation", opts.activation);
+  }
 
   if constexpr (std::is_same_v<T1, float>) {
     test.AddInput<T1>("A", {M, K}, input0_vals, false);
@@ -420,6 +441,55 @@ TEST(MatMulNBits, Float32_4b_Accuracy4) {
   TestMatMulNBitsTyped<float, 100, 288, 1234, 16, 4>();
 }
 
+TEST(MatMulNBits, Float32_4b_Activation) {
+  for (const char* activation : {"Relu", "Gelu", "FastGelu", "Silu"}) {
+    for (int64_t accuracy_level : {0, 4}) {
+      for (bool has_bias : {false, true}) {
+        TestOptions opts{};
+        opts.M = 100, opts.N = 288, opts.K = 93;
+        opts.block_size = 32;
+        opts.accuracy_level = accuracy_level;
+        opts.has_bias = has_bias;
+        opts.activation = activation;
+        if (accuracy_level == 4) {
+          opts.output_abs_error = 0.1f;
+          opts.output_rel_error = 0.02f;
+        } else {
+          opts.output_abs_error = 0.0001f;
+        }
+
+        // the activation attribute is only supported by the CPU EP
+        std::vector<std::unique_ptr<IExecutionProvider>> explicit_eps;
+        explicit_eps.emplace_back(DefaultCpuExecutionProvider());
+        RunTest<float>(opts, std::move(explicit_eps));
+      }
+    }
+  }
+}
+
+#if defined(MLAS_TARGET_ARM64)
+// K a multiple of the block size and no zero points select the packed (KleidiAI) CompInt8 kernel on ARM64, which
+// must apply the activation too.
+TEST(MatMulNBits, Float32_4b_Activation_PackedCompInt8) {
+  for (const char* activation : {"Gelu", "Silu"}) {
+    for (int64_t M : {1, 100}) {
+      TestOptions opts{};
+      opts.M = M, opts.N = 288, opts.K = 256;
+      opts.block_size = 32;
+      opts.accuracy_level = 4;
+      opts.has_bias = true;
+      opts.activation = activation;
+      opts.output_abs_error = 0.1f;
+      opts.output_rel_error = 0.02f;
+
+      std::vector<std::unique_ptr<IExecutionProvider>> explicit_eps;
+      explicit_eps.emplace_back(DefaultCpuExecutionProvider());
+      RunTest<float>(opts, std::move(explicit_eps));
+    }
+  }
+}
+#endif
+
 #if defined(MLAS_TARGET_AMD64_IX86) || defined(MLAS_TARGET_ARM64)
 #if !defined(USE_DML)
 // Actual and expected difference is over 0.01 with DmlExecutionProvider.
@@ -7,6 +7,8 @@
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 #include <cstdlib>
+#include <cstring>
+#include <thread>
 #include "core/framework/stream_handles.h"
 
 namespace onnxruntime {
@@ -307,6 +309,110 @@ TEST(BFCArenaTest, TestShrink) {
   EXPECT_EQ(stats.total_allocated_bytes, 10 * 1024 * 1024) << "Expect 10M bytes but actually " << stats.total_allocated_bytes << " bytes";
 }
 
+TEST(BFCArenaTest, TestThreadLocalCache) {
+  AllocatorStats stats;
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kNextPowerOfTwo,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+             64 * 1024);
+
+  void* p1 = a.Alloc(1024);
+  a.Free(p1);
+  // the freed chunk is reused from the cache
+  void* p2 = a.Alloc(1000);
+  EXPECT_EQ(p1, p2);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_thread_cache_misses, 1);
+  EXPECT_EQ(stats.num_thread_cache_hits, 1);
+  EXPECT_EQ(stats.num_allocs, 1) << "cache hits don't go through the arena";
+  EXPECT_EQ(a.RequestedSize(p2), 1000u) << "a cache hit reports the size of the new request";
+  EXPECT_GE(a.AllocatedSize(p2), 1024u);
+
+  // a chunk may be freed on another thread
+  std::thread([&a, p2]() { a.Free(p2); }).join();
+
+  // chunks that don't fit in the cache go back to the arena
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 32; ++i) {
+    ptrs.push_back(a.Alloc(4096));
+  }
+  for (void* p : ptrs) {
+    a.Free(p);
+  }
+
+  // large allocations bypass the cache
+  void* p_large = a.Alloc(1024 * 1024);
+  a.Free(p_large);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_thread_cache_hits + stats.num_thread_cache_misses, 34);
+
+  a.FlushThreadCaches();
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0) << "all cached chunks are returned by FlushThreadCaches";
+
+  void* p3 = a.Alloc(2048);
+  a.Free(p3);
+  EXPECT_EQ(a.Shrink(), Status::OK());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0) << "Shrink flushes the thread caches";
+
+  void* reserved = a.Reserve(1000);
+  EXPECT_EQ(a.RequestedSize(reserved), 1000u);
+  a.Free(reserved);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_reserves, 1);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+}
+
+TEST(BFCArenaTest, TestFlushCurrentThreadCache) {
+  AllocatorStats stats;
+  auto arena = std::make_unique<BFCArena>(
+      std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kNextPowerOfTwo,
+      BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+      BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES, 64 * 1024);
+  IAllocator& a = *arena;
+
+  std::thread([&a, &stats]() {
+    a.Free(a.Alloc(1024));
+    a.GetStats(&stats);
+    EXPECT_GT(stats.bytes_in_use, 0) << "the freed chunk is held in this thread's cache";
+
+    // called through IAllocator, as InferenceSession does at the end of a run
+    a.FlushCurrentThreadCache();
+    a.GetStats(&stats);
+    EXPECT_EQ(stats.bytes_in_use, 0);
+  }).join();
+
+  // allocators without thread caches ignore the call
+  CPUAllocator cpu_allocator;
+  cpu_allocator.FlushCurrentThreadCache();
+}
+
+TEST(BFCArenaTest, TestThreadLocalCacheFlushedWhenOutOfMemory) {
+  AllocatorStats stats;
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1024 * 1024, ArenaExtendStrategy::kNextPowerOfTwo,
+             1024 * 1024, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_POWER_OF_TWO_EXTEND_BYTES,
+             1024 * 1024);
+
+  // fill most of the only region the memory limit allows with chunks that end up in the cache
+  std::vector<void*> ptrs;
+  for (int i = 0; i < 8; ++i) {
+    ptrs.push_back(a.Alloc(100 * 1024));
+  }
+  for (void* p : ptrs) {
+    a.Free(p);
+  }
+
+  // only fits once the cached chunks are back in the arena
+  void* p_large = a.Alloc(900 * 1024);
+  EXPECT_NE(p_large, nullptr);
+  a.Free(p_large);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_arena_extensions, 1);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+}
+
 class BadAllocator : public IAllocator {
  public:
   BadAllocator() : IAllocator(OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator)) {}
@@ -482,5 +588,41 @@ TEST(BFCArenaTest, TestExtendStrategy) {
   ASSERT_EQ(extend_delta_bytes, extend_limit);
 }
 
+#if defined(__linux__)
+TEST(BFCArenaTest, TestHugePages) {
+  for (int huge_pages : {1, 2}) {
+    OrtArenaCfg config(0, static_cast<int>(ArenaExtendStrategy::kSameAsRequested), -1, -1, -1, -1, -1, huge_pages);
+    AllocatorCreationInfo device_info{
+        [](OrtDevice::DeviceId) { return std::make_unique<CPUAllocator>(); },
+        0, true, config};
+    auto allocator = CreateAllocator(device_info);
+    ASSERT_NE(allocator, nullptr);
+
+    const size_t size = 3 * 1024 * 1024;
+    auto* p = static_cast<char*>(allocator->Alloc(size));
+    ASSERT_NE(p, nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(p) % (2 * 1024 * 1024), 0u) << "regions are huge page aligned";
+    std::memset(p, 1, size);
+    allocator->Free(p);
+
+    auto& arena = *static_cast<BFCArena*>(allocator.get());
+    EXPECT_EQ(arena.Shrink(), Status::OK());
+    AllocatorStats stats;
+    arena.GetStats(&stats);
+    EXPECT_EQ(stats.total_allocated_bytes, 0);
+  }
+}
+#endif
+
+TEST(BFCArenaTest, TestInvalidHugePages) {
+  for (int huge_pages : {-2, 3}) {
+    OrtArenaCfg config(0, -1, -1, -1, -1, -1, -1, huge_pages);
+    AllocatorCreationInfo device_info{
+        [](OrtDevice::DeviceId) { return std::make_unique<CPUAllocator>(); },
+        0, true, config};
+    EXPECT_EQ(CreateAllocator(device_info), nullptr);
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -11,6 +11,7 @@
 #include <iterator>
 #include <thread>
 #include <fstream>
+#include <sstream>
 #include <random>
 
 #include <google/protobuf/io/zero_copy_stream_impl.h>
@@ -21,6 +22,7 @@
 #include "core/framework/compute_capability.h"
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/execution_provider.h"
+#include "core/framework/initializer_prefetcher.h"
 #include "core/framework/kernel_registry.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/session_state.h"
@@ -502,6 +504,313 @@ TEST(InferenceSessionTests, DisableCPUArena) {
   RunModel(session_object, run_options);
 }
 
+TEST(InferenceSessionTests, InvalidFastGeluFusionDomain) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.InvalidFastGeluFusionDomain";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsFastGeluFusionDomain, "com.unknown"));
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  Status st = session_object.Initialize();
+  ASSERT_FALSE(st.IsOK());
+  EXPECT_EQ(st.Code(), common::INVALID_ARGUMENT);
+  EXPECT_TRUE(st.ErrorMessage().find(kOrtSessionOptionsFastGeluFusionDomain) != std::string::npos);
+}
+
+TEST(InferenceSessionTests, InvalidCpuArenaHugePages) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.InvalidCpuArenaHugePages";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsCpuArenaHugePages, "3"));
+
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  Status st = session_object.Initialize();
+  ASSERT_FALSE(st.IsOK());
+  EXPECT_EQ(st.Code(), common::INVALID_ARGUMENT);
+  EXPECT_TRUE(st.ErrorMessage().find(kOrtSessionOptionsCpuArenaHugePages) != std::string::npos);
+}
+
+// C = (A + B) * B + A, with two intermediate values and no fixed input shapes.
+static void CreateAddMulAddModel(std::unique_ptr<onnxruntime::Model>& p_model) {
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[onnxruntime::kOnnxDomain] = 13;
+  std::vector<ONNX_NAMESPACE::FunctionProto> model_specific_functions;
+  p_model = std::make_unique<Model>("test", true, ModelMetaData(), PathString(),
+                                    IOnnxRuntimeOpSchemaRegistryList(), domain_to_version,
+                                    model_specific_functions, DefaultLoggingManager().DefaultLogger(),
+                                    ModelOptions(true, true));
+  onnxruntime::Graph& graph = p_model->MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+
+  auto& a = graph.GetOrCreateNodeArg("A", &tensor_float);
+  auto& b = graph.GetOrCreateNodeArg("B", &tensor_float);
+  auto& add_output = graph.GetOrCreateNodeArg("add_output", &tensor_float);
+  auto& mul_output = graph.GetOrCreateNodeArg("mul_output", &tensor_float);
+  auto& c = graph.GetOrCreateNodeArg("C", &tensor_float);
+  graph.AddNode("add_0", "Add", "Add", {&a, &b}, {&add_output});
+  graph.AddNode("mul_0", "Mul", "Mul", {&add_output, &b}, {&mul_output});
+  graph.AddNode("add_1", "Add", "Add", {&mul_output, &a}, {&c});
+  Status status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+}
+
+static void LoadAddMulAddModel(InferenceSession& session_object) {
+  std::unique_ptr<Model> p_model;
+  CreateAddMulAddModel(p_model);
+
+  std::string serialized;
+  p_model->ToProto().SerializeToString(&serialized);
+  std::stringstream model_stream(serialized);
+  ASSERT_STATUS_OK(session_object.Load(model_stream));
+  ASSERT_STATUS_OK(session_object.Initialize());
+}
+
+// Runs the CreateAddMulAddModel model with inputs of shape `dims` and checks the output.
+static void RunAddMulAdd(InferenceSession& session_object, const std::vector<int64_t>& dims, int iteration) {
+  auto allocator = TestCPUExecutionProvider()->CreatePreferredAllocators()[0];
+  const size_t size = static_cast<size_t>(TensorShape(dims).Size());
+  std::vector<float> a(size);
+  std::vector<float> b(size);
+  std::vector<float> expected(size);
+  for (size_t i = 0; i < size; ++i) {
+    a[i] = static_cast<float>(iteration + i);
+    b[i] = static_cast<float>(iteration) - static_cast<float>(i);
+    expected[i] = (a[i] + b[i]) * b[i] + a[i];
+  }
+
+  OrtValue value_a;
+  OrtValue value_b;
+  CreateMLValue<float>(allocator, dims, a, &value_a);
+  CreateMLValue<float>(allocator, dims, b, &value_b);
+  NameMLValMap feeds{{"A", value_a}, {"B", value_b}};
+
+  std::vector<std::string> output_names = {"C"};
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session_object.Run(RunOptions{}, feeds, output_names, &fetches));
+  VerifyOutputs(fetches, dims, expected);
+}
+
+TEST(InferenceSessionTests, CpuReplay) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.CpuReplay";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsEnableCpuReplay, "1"));
+
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  LoadAddMulAddModel(session_object);
+  const auto* replay_executor = session_object.GetSessionState().GetCpuReplayExecutor();
+  ASSERT_NE(replay_executor, nullptr);
+
+  // the first run warms up, the second records and the rest replay.
+  const std::vector<int64_t> dims = {3, 2};
+  for (int iteration = 0; iteration < 4; ++iteration) {
+    RunAddMulAdd(session_object, dims, iteration);
+    EXPECT_EQ(replay_executor->ReplayCount(), static_cast<size_t>(iteration));
+  }
+
+  // the recorded memory pattern does not match new input shapes, so those runs go through the regular executor
+  // until the new shapes are recorded.
+  const std::vector<int64_t> new_dims = {4, 5};
+  RunAddMulAdd(session_object, new_dims, 4);
+  EXPECT_EQ(replay_executor->ReplayCount(), 3u);
+  RunAddMulAdd(session_object, new_dims, 5);
+  EXPECT_EQ(replay_executor->ReplayCount(), 4u);
+
+  // switching back drops the recording for the new shapes and starts over.
+  RunAddMulAdd(session_object, dims, 6);
+  EXPECT_EQ(replay_executor->ReplayCount(), 4u);
+  RunAddMulAdd(session_object, dims, 7);
+  EXPECT_EQ(replay_executor->ReplayCount(), 5u);
+}
+
+TEST(InferenceSessionTests, CpuReplayWithoutMemoryPattern) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.CpuReplayWithoutMemoryPattern";
+  so.enable_mem_pattern = false;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsEnableCpuReplay, "1"));
+
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  LoadAddMulAddModel(session_object);
+  const auto* replay_executor = session_object.GetSessionState().GetCpuReplayExecutor();
+  ASSERT_NE(replay_executor, nullptr);
+
+  // without a memory pattern the replayed runs allocate every value from the arena.
+  const std::vector<int64_t> dims = {3, 2};
+  for (int iteration = 0; iteration < 3; ++iteration) {
+    RunAddMulAdd(session_object, dims, iteration);
+  }
+  EXPECT_EQ(replay_executor->ReplayCount(), 2u);
+}
+
+// Y = Sum over `num_branches` independent chains of `depth` MatMuls by X, so up to num_branches nodes are ready at once.
+// With `shared_intermediate` the chains start from H = Relu(X) instead of X, so an intermediate value has
+// num_branches consumers.
+static void CreateWideMatMulModel(std::unique_ptr<onnxruntime::Model>& p_model, int num_branches, int depth,
+                                  bool shared_intermediate = false) {
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[onnxruntime::kOnnxDomain] = 13;
+  std::vector<ONNX_NAMESPACE::FunctionProto> model_specific_functions;
+  p_model = std::make_unique<Model>("test", true, ModelMetaData(), PathString(),
+                                    IOnnxRuntimeOpSchemaRegistryList(), domain_to_version,
+                                    model_specific_functions, DefaultLoggingManager().DefaultLogger(),
+                                    ModelOptions(true, true));
+  onnxruntime::Graph& graph = p_model->MainGraph();
+
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+
+  auto& input_arg = graph.GetOrCreateNodeArg("X", &tensor_float);
+  onnxruntime::NodeArg* branch_input = &input_arg;
+  if (shared_intermediate) {
+    branch_input = &graph.GetOrCreateNodeArg("H", &tensor_float);
+    graph.AddNode("shared", "Relu", "Relu", {&input_arg}, {branch_input});
+  }
+
+  std::vector<onnxruntime::NodeArg*> branch_outputs;
+  for (int branch = 0; branch < num_branches; ++branch) {
+    onnxruntime::NodeArg* previous = branch_input;
+    for (int step = 0; step < depth; ++step) {
+      const std::string name = "branch" + std::to_string(branch) + "_" + std::to_string(step);
+      auto& output_arg = graph.GetOrCreateNodeArg(name, &tensor_float);
+      graph.AddNode(name, "MatMul", "MatMul", {previous, &input_arg}, {&output_arg});
+      previous = &output_arg;
+    }
+    branch_outputs.push_back(previous);
+  }
+
+  auto& output_arg = graph.GetOrCreateNodeArg("Y", &tensor_float);
+  graph.AddNode("sum", "Sum", "Sum", branch_outputs, {&output_arg});
+  Status status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+}
+
+TEST(InferenceSessionTests, CriticalPathExecutor) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.CriticalPathExecutor";
+  so.execution_mode = ExecutionMode::ORT_PARALLEL;
+  so.intra_op_param.thread_pool_size = 4;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsCriticalPathExecutor, "1"));
+
+  constexpr int kBranches = 4;
+  constexpr int64_t kSize = 128;
+  std::unique_ptr<Model> p_model;
+  CreateWideMatMulModel(p_model, kBranches, 4);
+
+  std::string serialized;
+  p_model->ToProto().SerializeToString(&serialized);
+  std::stringstream model_stream(serialized);
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(model_stream));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  const auto* executor = session_object.GetSessionState().GetCriticalPathExecutor();
+  ASSERT_NE(executor, nullptr);
+
+  // X is the identity, so every branch yields the identity and Y is kBranches times it.
+  std::vector<int64_t> dims = {kSize, kSize};
+  std::vector<float> x(kSize * kSize, 0.0f);
+  std::vector<float> expected(x.size(), 0.0f);
+  for (int64_t i = 0; i < kSize; ++i) {
+    x[i * kSize + i] = 1.0f;
+    expected[i * kSize + i] = static_cast<float>(kBranches);
+  }
+
+  OrtValue value_x;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], dims, x, &value_x);
+  NameMLValMap feeds{{"X", value_x}};
+  std::vector<std::string> output_names = {"Y"};
+
+  // The first run uses the static cost estimates and the rest the measured node times. The roots of the branches
+  // are ready together, so the lanes started for them take some of the branches from the caller.
+  size_t max_lane_count = 0;
+  for (int iteration = 0; iteration < 8; ++iteration) {
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(RunOptions{}, feeds, output_names, &fetches));
+    VerifyOutputs(fetches, dims, expected);
+    max_lane_count = std::max(max_lane_count, executor->LastRunLaneCount());
+  }
+  EXPECT_GT(max_lane_count, 1u);
+  EXPECT_LE(max_lane_count, static_cast<size_t>(kBranches));
+}
+
+// An intermediate value feeds all the branches, which run out of plan order, so it must stay alive until every
+// branch has consumed it rather than be released after the consumer that is last in plan order.
+TEST(InferenceSessionTests, CriticalPathExecutorSharedIntermediate) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.CriticalPathExecutorSharedIntermediate";
+  so.execution_mode = ExecutionMode::ORT_PARALLEL;
+  so.intra_op_param.thread_pool_size = 4;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsCriticalPathExecutor, "1"));
+
+  constexpr int kBranches = 4;
+  constexpr int64_t kSize = 64;
+  std::unique_ptr<Model> p_model;
+  CreateWideMatMulModel(p_model, kBranches, 3, true);
+
+  std::string serialized;
+  p_model->ToProto().SerializeToString(&serialized);
+  std::stringstream model_stream(serialized);
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(model_stream));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  ASSERT_NE(session_object.GetSessionState().GetCriticalPathExecutor(), nullptr);
+
+  // X and so H = Relu(X) are the identity
+  std::vector<int64_t> dims = {kSize, kSize};
+  std::vector<float> x(kSize * kSize, 0.0f);
+  std::vector<float> expected(x.size(), 0.0f);
+  for (int64_t i = 0; i < kSize; ++i) {
+    x[i * kSize + i] = 1.0f;
+    expected[i * kSize + i] = static_cast<float>(kBranches);
+  }
+
+  OrtValue value_x;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], dims, x, &value_x);
+  NameMLValMap feeds{{"X", value_x}};
+  std::vector<std::string> output_names = {"Y"};
+
+  // the ranks change with the measured node times, which changes the order the branch roots run in
+  for (int iteration = 0; iteration < 16; ++iteration) {
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(RunOptions{}, feeds, output_names, &fetches));
+    VerifyOutputs(fetches, dims, expected);
+  }
+}
+
+TEST(InferenceSessionTests, PrefetchInitializers) {
+  SessionOptions so;
+
+  so.session_logid = "InferenceSessionTests.PrefetchInitializers";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsPrefetchInitializers, "1"));
+  // keep the initializers, which pre-packing may release
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigDisablePrepacking, "1"));
+
+  // the initializers of this model are in an external data file, which is memory mapped
+  InferenceSessionWrapper session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(ORT_TSTR("testdata/conv_qdq_external_ini.onnx")));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  const auto& session_state = session_object.GetSessionState();
+  size_t initializer_bytes = 0;
+  for (const auto& [idx, value] : session_state.GetInitializedTensors()) {
+    if (value.IsTensor() && value.Get<Tensor>().Location().device.Type() == OrtDevice::CPU) {
+      initializer_bytes += value.Get<Tensor>().SizeInBytes();
+    }
+  }
+  ASSERT_GT(initializer_bytes, size_t(0));
+
+  InitializerPrefetcher prefetcher(session_state, DefaultLoggingManager().DefaultLogger());
+  prefetcher.Wait();
+  EXPECT_GT(prefetcher.NumPrefetchedBytes(), size_t(0));
+  EXPECT_LE(prefetcher.NumPrefetchedBytes(), initializer_bytes);
+}
+
 TEST(InferenceSessionTests, TestModelSerialization) {
   // Load model with level 0 transform level
   // and assert that the model has Identity nodes.
@@ -686,6 +995,33 @@ TEST(InferenceSessionTests, CheckRunProfilerWithSessionOptions) {
 #endif
 }
 
+TEST(InferenceSessionTests, CheckSessionInitializationProfile) {
+  SessionOptions so;
+
+  so.session_logid = "CheckSessionInitializationProfile";
+  so.enable_profiling = true;
+  so.profile_file_prefix = ORT_TSTR("onnxprofile_init_test");
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+  std::string profile_file = session_object.EndProfiling();
+
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+  std::stringstream contents;
+  contents << profile.rdbuf();
+  const std::string trace = contents.str();
+
+  // one event per phase of SessionState finalization
+  for (const char* phase : {"allocation_planning", "initializer_saving", "kernel_creation", "weight_prepacking"}) {
+    EXPECT_NE(trace.find(std::string("\"") + phase + "\""), std::string::npos) << phase;
+  }
+
+  // one event per transformer pass
+  EXPECT_NE(trace.find("\"num_nodes_after\""), std::string::npos);
+}
+
 TEST(InferenceSessionTests, CheckRunProfilerWithSessionOptions2) {
   SessionOptions so;
 
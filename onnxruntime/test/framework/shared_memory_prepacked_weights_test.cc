@@ -0,0 +1,79 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/shared_memory_prepacked_weights.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#if defined(__linux__)
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "core/framework/allocator.h"
+#include "gtest/gtest.h"
+#include "test/test_environment.h"
+
+namespace onnxruntime {
+namespace test {
+
+#if defined(__linux__)
+TEST(SharedMemoryPrepackedWeightsTest, PublishAndMap) {
+  auto allocator = CPUAllocator::DefaultInstance();
+  const auto& logger = DefaultLoggingManager().DefaultLogger();
+
+  constexpr size_t kNumFloats = 100;
+  PrePackedWeights weights;
+  weights.buffers_.push_back(IAllocator::MakeUniquePtr<void>(allocator, kNumFloats * sizeof(float), true));
+  weights.buffer_sizes_.push_back(kNumFloats * sizeof(float));
+  // placeholder buffer
+  weights.buffers_.emplace_back(nullptr, [](void*) {});
+  weights.buffer_sizes_.push_back(0);
+
+  auto* data = static_cast<float*>(weights.buffers_[0].get());
+  for (size_t i = 0; i < kNumFloats; ++i) {
+    data[i] = static_cast<float>(i) * 0.5f;
+  }
+
+  const std::string prefix = "ort-test-" + std::to_string(getpid());
+  const std::string key = "MatMul+" + std::to_string(weights.GetHash());
+  const std::string path = GetSharedMemoryPrepackedWeightsPath(prefix, key);
+  std::remove(path.c_str());
+
+  // the first call creates the segment and the second one maps the existing segment
+  for (int i = 0; i < 2; ++i) {
+    auto shared = SharePrePackedWeightsAcrossProcesses(prefix, key, weights, logger);
+    ASSERT_TRUE(shared.has_value());
+    ASSERT_EQ(shared->buffers_.size(), size_t(2));
+    ASSERT_EQ(shared->buffer_sizes_[0], kNumFloats * sizeof(float));
+    EXPECT_NE(shared->buffers_[0].get(), weights.buffers_[0].get());
+    EXPECT_EQ(std::memcmp(shared->buffers_[0].get(), data, kNumFloats * sizeof(float)), 0);
+    EXPECT_EQ(shared->buffers_[1].get(), nullptr);
+    EXPECT_EQ(shared->GetHash(), weights.GetHash());
+  }
+
+  // a segment with a different layout is not used
+  PrePackedWeights other;
+  other.buffers_.push_back(IAllocator::MakeUniquePtr<void>(allocator, sizeof(float), true));
+  other.buffer_sizes_.push_back(sizeof(float));
+  EXPECT_FALSE(SharePrePackedWeightsAcrossProcesses(prefix, key, other, logger).has_value());
+
+  // nor is a segment with the same layout but other contents, e.g. after a hash collision
+  data[0] += 1.0f;
+  EXPECT_FALSE(SharePrePackedWeightsAcrossProcesses(prefix, key, weights, logger).has_value());
+  data[0] -= 1.0f;
+
+  // nor is a segment that other users can write
+  ASSERT_EQ(chmod(path.c_str(), 0666), 0);
+  EXPECT_FALSE(SharePrePackedWeightsAcrossProcesses(prefix, key, weights, logger).has_value());
+  ASSERT_EQ(chmod(path.c_str(), 0644), 0);
+  EXPECT_TRUE(SharePrePackedWeightsAcrossProcesses(prefix, key, weights, logger).has_value());
+
+  EXPECT_EQ(std::remove(path.c_str()), 0);
+}
+#endif
+
+}  // namespace test
+}  // namespace onnxruntime
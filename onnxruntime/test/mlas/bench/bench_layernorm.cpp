@@ -0,0 +1,64 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "benchmark/benchmark.h"
+#include "bench_util.h"
+#include "core/common/float16.h"
+
+using namespace onnxruntime;
+
+template <typename T>
+void RunLayerNormBenchmark(size_t hidden_size, bool has_skip, bool simplified, benchmark::State& state) {
+  const auto input_fp32 = RandomVectorUniform<float>(hidden_size, -2.0f, 2.0f);
+  const auto skip = RandomVectorUniform<float>(hidden_size, -2.0f, 2.0f);
+  const auto bias = RandomVectorUniform<float>(hidden_size, -1.0f, 1.0f);
+  const auto gamma = RandomVectorUniform<float>(hidden_size, -1.0f, 1.0f);
+  const auto beta = RandomVectorUniform<float>(hidden_size, -1.0f, 1.0f);
+
+  std::vector<T> input(hidden_size);
+  for (size_t i = 0; i < hidden_size; ++i) {
+    input[i] = static_cast<T>(input_fp32[i]);
+  }
+  std::vector<T> output(hidden_size);
+  std::vector<T> skip_output(hidden_size);
+
+  const float* skip_data = has_skip ? skip.data() : nullptr;
+  const float* bias_data = has_skip ? bias.data() : nullptr;
+  T* skip_output_data = has_skip ? skip_output.data() : nullptr;
+  float mean, inv_std_dev;
+
+  // warm up run
+  MlasLayerNormalization<T>(input.data(), skip_data, bias_data, gamma.data(), beta.data(), output.data(),
+                            skip_output_data, hidden_size, 1e-5f, simplified, &mean, &inv_std_dev);
+
+  for (auto _ : state) {
+    MlasLayerNormalization<T>(input.data(), skip_data, bias_data, gamma.data(), beta.data(), output.data(),
+                              skip_output_data, hidden_size, 1e-5f, simplified, &mean, &inv_std_dev);
+  }
+}
+
+template <typename T>
+void LayerNorm(benchmark::State& state) {
+  using onnxruntime::narrow;
+
+  const auto hidden_size = narrow<size_t>(state.range(0));
+  const auto has_skip = narrow<bool>(state.range(1));
+  const auto simplified = narrow<bool>(state.range(2));
+
+  RunLayerNormBenchmark<T>(hidden_size, has_skip, simplified, state);
+}
+
+template <typename T>
+static void LayerNormArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"hidden_size", "skip", "simplified"});
+
+  b->ArgsProduct({
+      {768, 1024, 2048, 3072, 4096, 5120, 8192},  // hidden_size
+      {int64_t{false}, int64_t{true}},            // skip
+      {int64_t{false}, int64_t{true}},            // simplified
+  });
+}
+
+BENCHMARK(LayerNorm<float>)->Apply(LayerNormArgs<float>)->UseRealTime();
+BENCHMARK(LayerNorm<MLFloat16>)->Apply(LayerNormArgs<MLFloat16>)->UseRealTime();
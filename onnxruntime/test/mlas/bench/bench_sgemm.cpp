@@ -135,3 +135,11 @@ static void GemmLLMSizeProducts(benchmark::internal::Benchmark* b) {
 }
 
 BENCHMARK_CAPTURE(SGEMM, LLM, false, false, true)->Apply(GemmLLMSizeProducts)->UseRealTime();
+
+static void GemmSkinnySizeProducts(benchmark::internal::Benchmark* b) {
+  b->ArgNames(sgemm_bench_arg_names);
+  b->ArgsProduct({{2, 4, 8}, {4096}, {4096}});
+}
+
+BENCHMARK_CAPTURE(SGEMM, SKINNY_NoTrans, false, false, false)->Apply(GemmSkinnySizeProducts)->UseRealTime();
+BENCHMARK_CAPTURE(SGEMM, SKINNY_TransB, false, false, true)->Apply(GemmSkinnySizeProducts)->UseRealTime();
@@ -204,7 +204,7 @@ class MlasActivationTest : public MlasTestBase {
     MLAS_ACTIVATION Activation;
     AliasedValue Buffer[_countof(TestData)];
 
-    for (unsigned kind = 0; kind < unsigned(MlasActivationKindCount); kind++) {
+    for (unsigned kind = 0; kind < unsigned(_countof(TestData[0])); kind++) {
       Activation.ActivationKind = MLAS_ACTIVATION_KIND(kind);
 
       if (Activation.ActivationKind == MlasLeakyReluActivation) {
@@ -253,6 +253,116 @@ class MlasActivationTest : public MlasTestBase {
             << std::setw(8) << std::setfill('0') << std::hex << TestData[i][kind].u;
       }
     }
+
+    ExecuteGated();
+    ExecuteGemmOutputProcessor();
+  }
+
+ private:
+  static float ReferenceGated(MLAS_ACTIVATION_KIND kind, float x) {
+    switch (kind) {
+      case MlasGeluErfActivation:
+        return 0.5f * x * (1.0f + std::erf(x * 0.70710678f));
+      case MlasGeluTanhActivation:
+        return 0.5f * x * (1.0f + std::tanh(0.79788456f * (x + 0.044715f * x * x * x)));
+      case MlasSiluActivation:
+        return x / (1.0f + std::exp(-x));
+      case MlasQuickGeluActivation:
+        return x / (1.0f + std::exp(-1.702f * x));
+      default:
+        return x;
+    }
+  }
+
+  // The gated activations are checked against the reference formulas with a bias, partial blocks and a leading
+  // dimension larger than the row.
+  void ExecuteGated() {
+    constexpr size_t M = 3;
+    constexpr size_t N = 301;
+    constexpr size_t ldc = 320;
+
+    const MLAS_ACTIVATION_KIND kinds[] = {
+        MlasGeluErfActivation,
+        MlasGeluTanhActivation,
+        MlasSiluActivation,
+        MlasQuickGeluActivation};
+
+    std::vector<float> input(M * ldc);
+    for (size_t i = 0; i < input.size(); i++) {
+      input[i] = -12.0f + 24.0f * static_cast<float>(i % 331) / 330.0f;
+    }
+    const float bias[M] = {0.0f, 0.5f, -1.25f};
+
+    for (auto kind : kinds) {
+      MLAS_ACTIVATION Activation;
+      Activation.ActivationKind = kind;
+      Activation.Parameters.QuickGelu.alpha = 1.702f;
+
+      std::vector<float> buffer(input);
+      MlasActivation(&Activation, buffer.data(), bias, M, N, ldc);
+
+      for (size_t m = 0; m < M; m++) {
+        for (size_t n = 0; n < ldc; n++) {
+          const float x = input[m * ldc + n];
+          const float actual = buffer[m * ldc + n];
+          if (n >= N) {
+            ASSERT_EQ(actual, x) << "Kind:" << (int)kind << " wrote past N at m=" << m << ", n=" << n;
+            continue;
+          }
+          const float expected = ReferenceGated(kind, x + bias[m]);
+          ASSERT_NEAR(actual, expected, 1e-5f + 1e-4f * std::fabs(expected))
+              << "Kind:" << (int)kind << ", m=" << m << ", n=" << n << ", x=" << x;
+        }
+      }
+    }
+  }
+
+  // An activation applied by the SGEMM output processor matches the activation applied after the GEMM.
+  void ExecuteGemmOutputProcessor() {
+    constexpr size_t M = 5;
+    constexpr size_t N = 300;
+    constexpr size_t K = 33;
+
+    std::vector<float> A(M * K);
+    std::vector<float> B(K * N);
+    for (size_t i = 0; i < A.size(); i++) {
+      A[i] = static_cast<float>(int(i % 13) - 6) * 0.125f;
+    }
+    for (size_t i = 0; i < B.size(); i++) {
+      B[i] = static_cast<float>(int(i % 11) - 5) * 0.0625f;
+    }
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = MlasGeluErfActivation;
+    MLAS_GEMM_ACTIVATION_PROCESSOR OutputProcessor(Activation);
+
+    std::vector<float> expected(M * N);
+    MlasGemm(CblasNoTrans, CblasNoTrans, M, N, K, 1.0f, A.data(), K, B.data(), N, 0.0f, expected.data(), N, nullptr);
+    MlasActivation(&Activation, expected.data(), nullptr, M, N, N);
+
+    // the packed kernels require an aligned buffer
+    MatrixGuardBuffer<uint8_t> BufferBPacked;
+    void* PackedB = BufferBPacked.GetBuffer(MlasGemmPackBSize(CblasNoTrans, CblasNoTrans, N, K), true);
+    MlasGemmPackB(CblasNoTrans, CblasNoTrans, N, K, B.data(), N, PackedB);
+
+    for (bool BIsPacked : {false, true}) {
+      std::vector<float> actual(M * N);
+      MLAS_SGEMM_DATA_PARAMS Data;
+      Data.A = A.data();
+      Data.lda = K;
+      Data.B = BIsPacked ? static_cast<const float*>(PackedB) : B.data();
+      Data.ldb = N;
+      Data.BIsPacked = BIsPacked;
+      Data.C = actual.data();
+      Data.ldc = N;
+      Data.OutputProcessor = &OutputProcessor;
+      MlasGemm(CblasNoTrans, CblasNoTrans, M, N, K, Data, nullptr);
+
+      for (size_t i = 0; i < actual.size(); i++) {
+        ASSERT_NEAR(actual[i], expected[i], 1e-6f + 1e-6f * std::fabs(expected[i]))
+            << "BIsPacked:" << BIsPacked << ", i=" << i;
+      }
+    }
   }
 };
 
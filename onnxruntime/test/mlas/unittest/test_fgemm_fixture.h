@@ -71,6 +71,11 @@ class FgemmShortExecuteTest : public MlasTestFixture<MlasFgemmTest<T, Packed, Th
     test_registered += RegisterTestTransposeABProduct(128, 768, 3072, 1, 1.0f, 0.0f);
     test_registered += RegisterTestTransposeABProduct(25, 81, 79, 7, 1.0f, 0.0f);
     test_registered += RegisterTestTransposeABProduct(1024, 1, 512, 1, 1.0f, 0.0f);
+    for (size_t m = 2; m <= 9; m++) {
+      test_registered += RegisterTestTransposeABProduct(m, 333, 257, 1, 1.0f, 0.0f);
+      test_registered += RegisterTestTransposeABProduct(m, 100, 70, 1, 0.5f, 1.0f);
+      test_registered += RegisterTestTransposeABProduct(m, 47, 1031, 3, -1.0f, 0.25f);
+    }
     return test_registered;
   }
 
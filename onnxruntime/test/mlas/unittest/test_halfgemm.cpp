@@ -74,6 +74,10 @@ class HalfGemmShortExecuteTest : public MlasTestFixture<MlasHalfGemmTest<AType,
         test_registered += RegisterSingleTest(1, 32, b, 5, false);
       }
     }
+    for (size_t m = 2; m <= 9; m++) {
+      test_registered += RegisterSingleTest(m, 333, 257, 1, (m & 1) != 0);
+      test_registered += RegisterSingleTest(m, 64, 511, 1, (m & 1) == 0);
+    }
     test_registered += RegisterSingleTest(43, 500, 401, 1, true);
     //    test_registered += RegisterSingleTest(1001, 1027, 1031, 1, false);
     if (!Packed) {
@@ -158,7 +162,7 @@ static size_t HalfGemmRegistShortExecute() {
 }
 
 static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
-  if (!MlasFp16AccelerationSupported()) {
+  if (!MlasHalfGemmSupported()) {
     return false;
   }
   if (is_short_execute) {
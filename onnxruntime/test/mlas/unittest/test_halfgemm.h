@@ -120,6 +120,14 @@ class MlasHalfGemmTest : public MlasTestBase {
     //
     constexpr size_t KStride = 512;
 
+#if defined(MLAS_TARGET_AMD64)
+    // The x64 kernel widens the half precision operands and accumulates in
+    // single precision, only rounding when storing each K stride.
+    constexpr bool AccumulateInFloat = true;
+#else
+    constexpr bool AccumulateInFloat = false;
+#endif
+
     for (size_t batch = 0; batch < BatchSize; batch++) {
       for (size_t m = 0; m < M; m++) {
         for (size_t n = 0; n < N; n++) {
@@ -133,13 +141,17 @@ class MlasHalfGemmTest : public MlasTestBase {
               sum = float(Bias[n]);
             }
             for (size_t kk = 0; kk < std::min(KStride, K - k); kk++) {
-              MLFp16 down(float(*b) * float(*a) + sum);
-              sum = float(down);
+              if constexpr (AccumulateInFloat) {
+                sum += float(MLFp16(float(*b))) * float(MLFp16(float(*a)));
+              } else {
+                MLFp16 down(float(*b) * float(*a) + sum);
+                sum = float(down);
+              }
               b += N;
               a += 1;
             }
             if (k == 0) {
-              *c = sum;
+              *c = float(MLFp16(sum));
             } else {
               MLFp16 d(sum + *c);
               *c = float(d);
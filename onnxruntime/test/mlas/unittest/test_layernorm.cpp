@@ -0,0 +1,116 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+#include "core/mlas/lib/mlasi.h"
+
+template <typename T>
+class MlasLayerNormTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<T> BufferInput;
+  MatrixGuardBuffer<T> BufferOutput;
+  MatrixGuardBuffer<T> BufferSkipOutput;
+  MatrixGuardBuffer<float> BufferSkip;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferGamma;
+  MatrixGuardBuffer<float> BufferBeta;
+
+  void Test(size_t N, bool HasSkip, bool HasBias, bool HasBeta, bool Simplified) {
+    T* Input = BufferInput.GetBuffer(N);
+    T* Output = BufferOutput.GetBuffer(N);
+    T* SkipOutput = HasSkip ? BufferSkipOutput.GetBuffer(N) : nullptr;
+    float* Skip = HasSkip ? BufferSkip.GetBuffer(N) : nullptr;
+    float* Bias = HasBias ? BufferBias.GetBuffer(N) : nullptr;
+    float* Gamma = BufferGamma.GetBuffer(N);
+    float* Beta = HasBeta ? BufferBeta.GetBuffer(N) : nullptr;
+
+    std::default_random_engine generator(static_cast<unsigned>(N));
+    std::uniform_real_distribution<float> distribution(-2.0f, 2.0f);
+
+    std::vector<double> Sum(N);
+    for (size_t n = 0; n < N; n++) {
+      // Offset the input so that the mean is not close to zero.
+      Input[n] = T(distribution(generator) + 1.5f);
+      Sum[n] = static_cast<float>(Input[n]);
+      if (Skip != nullptr) {
+        Skip[n] = distribution(generator);
+        Sum[n] += Skip[n];
+      }
+      if (Bias != nullptr) {
+        Bias[n] = distribution(generator);
+        Sum[n] += Bias[n];
+      }
+      Gamma[n] = distribution(generator);
+      if (Beta != nullptr) {
+        Beta[n] = distribution(generator);
+      }
+    }
+
+    constexpr float Epsilon = 1e-5f;
+    float Mean = 0.0f;
+    float InvStdDev = 0.0f;
+
+    MlasLayerNormalization<T>(Input, Skip, Bias, Gamma, Beta, Output, SkipOutput, N, Epsilon, Simplified,
+                              &Mean, &InvStdDev);
+
+    double RefMean = 0.0;
+    double RefSumSquare = 0.0;
+    for (size_t n = 0; n < N; n++) {
+      RefMean += Sum[n];
+    }
+    RefMean = Simplified ? 0.0 : RefMean / N;
+    for (size_t n = 0; n < N; n++) {
+      RefSumSquare += (Sum[n] - RefMean) * (Sum[n] - RefMean);
+    }
+    const double RefInvStdDev = 1.0 / std::sqrt(RefSumSquare / N + Epsilon);
+
+    const float Tolerance = std::is_same_v<T, float> ? 1e-4f : 1e-2f;
+    std::string Case = "N=" + std::to_string(N) + " Skip=" + std::to_string(HasSkip) +
+                       " Bias=" + std::to_string(HasBias) + " Beta=" + std::to_string(HasBeta) +
+                       " Simplified=" + std::to_string(Simplified);
+
+    if (!Simplified) {
+      ASSERT_NEAR(Mean, RefMean, 1e-4) << Case;
+    }
+    ASSERT_NEAR(InvStdDev / RefInvStdDev, 1.0, 1e-3) << Case;
+
+    for (size_t n = 0; n < N; n++) {
+      double Ref = (Sum[n] - RefMean) * RefInvStdDev * Gamma[n];
+      if (Beta != nullptr && !Simplified) {
+        Ref += Beta[n];
+      }
+      ASSERT_NEAR(static_cast<float>(Output[n]), Ref, Tolerance * (1.0 + std::fabs(Ref))) << Case << " @" << n;
+      if (SkipOutput != nullptr) {
+        ASSERT_NEAR(static_cast<float>(SkipOutput[n]), Sum[n], Tolerance * (1.0 + std::fabs(Sum[n])))
+            << Case << " @" << n;
+      }
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(std::is_same_v<T, float> ? "LayerNorm_fp32" : "LayerNorm_fp16");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t N : {1, 3, 4, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 100, 768, 1001}) {
+      for (bool Simplified : {false, true}) {
+        Test(N, false, false, false, Simplified);
+        Test(N, false, false, true, Simplified);
+        Test(N, true, false, true, Simplified);
+        Test(N, true, true, false, Simplified);
+        Test(N, true, true, true, Simplified);
+      }
+    }
+  }
+};
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasLayerNormTest<float>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasLayerNormTest<MLAS_FP16>>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -0,0 +1,409 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Benchmarks for the com.my_virtual_npu (kMyCustomDomain) kernels in core/providers/my_cpu, side by side with
+// the com.microsoft contrib kernels they replace and the raw MLAS reference loop.
+//
+// Each kernel is run as a single-node model through an InferenceSession with graph optimizations disabled, so the
+// timings include the per-Run dispatch cost but nothing else. Inputs and outputs are bound once via IoBinding.
+// Arguments are (shape..., intra_op_threads). Reported counters:
+//   items_per_second - elements of the primary output per second
+//   bytes_per_second - bytes of all inputs and outputs per second (the kernels are memory bound at large shapes)
+
+#include "common.h"
+
+#include <benchmark/benchmark.h>
+#include <core/framework/float16.h>
+#include <core/graph/constants.h>
+#include <core/graph/onnx_protobuf.h>
+#include <core/platform/env.h>
+#include <core/platform/threadpool.h>
+#include <core/session/onnxruntime_cxx_api.h>
+#include <core/util/thread_utils.h>
+#include <mlas.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace onnxruntime;
+
+namespace {
+
+template <typename T>
+constexpr ONNXTensorElementDataType OrtTypeOf();
+template <>
+constexpr ONNXTensorElementDataType OrtTypeOf<float>() { return ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT; }
+template <>
+constexpr ONNXTensorElementDataType OrtTypeOf<double>() { return ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE; }
+template <>
+constexpr ONNXTensorElementDataType OrtTypeOf<MLFloat16>() { return ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16; }
+template <>
+constexpr ONNXTensorElementDataType OrtTypeOf<BFloat16>() { return ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16; }
+
+size_t ElementSize(ONNXTensorElementDataType type) {
+  switch (type) {
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+      return sizeof(double);
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16:
+      return sizeof(uint16_t);
+    default:
+      return sizeof(float);
+  }
+}
+
+struct TensorSpec {
+  std::string name;
+  std::vector<int64_t> shape;
+  ONNXTensorElementDataType type;
+  // For outputs: index of the input whose buffer this output is bound to, to exercise MayInplace kernels in place.
+  int alias_of = -1;
+
+  int64_t Size() const {
+    int64_t size = 1;
+    for (auto dim : shape) size *= dim;
+    return size;
+  }
+};
+
+void AddValueInfo(ONNX_NAMESPACE::ValueInfoProto& value_info, const TensorSpec& spec) {
+  value_info.set_name(spec.name);
+  auto* tensor_type = value_info.mutable_type()->mutable_tensor_type();
+  tensor_type->set_elem_type(static_cast<int32_t>(spec.type));
+  for (auto dim : spec.shape) {
+    tensor_type->mutable_shape()->add_dim()->set_dim_value(dim);
+  }
+}
+
+std::string MakeSingleNodeModel(const std::string& op_type, const std::string& domain,
+                                const std::vector<TensorSpec>& inputs, const std::vector<TensorSpec>& outputs,
+                                const std::vector<ONNX_NAMESPACE::AttributeProto>& attributes) {
+  ONNX_NAMESPACE::ModelProto model;
+  model.set_ir_version(ONNX_NAMESPACE::Version::IR_VERSION);
+  auto* onnx_opset = model.add_opset_import();
+  onnx_opset->set_domain(kOnnxDomain);
+  onnx_opset->set_version(17);
+  auto* node_opset = model.add_opset_import();
+  node_opset->set_domain(domain);
+  node_opset->set_version(1);
+
+  auto* graph = model.mutable_graph();
+  graph->set_name(op_type);
+  auto* node = graph->add_node();
+  node->set_op_type(op_type);
+  node->set_domain(domain);
+  for (const auto& spec : inputs) {
+    node->add_input(spec.name);
+    AddValueInfo(*graph->add_input(), spec);
+  }
+  for (const auto& spec : outputs) {
+    node->add_output(spec.name);
+    AddValueInfo(*graph->add_output(), spec);
+  }
+  for (const auto& attribute : attributes) {
+    *node->add_attribute() = attribute;
+  }
+
+  return model.SerializeAsString();
+}
+
+ONNX_NAMESPACE::AttributeProto MakeAttribute(const std::string& name, int64_t value) {
+  ONNX_NAMESPACE::AttributeProto attribute;
+  attribute.set_name(name);
+  attribute.set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_INT);
+  attribute.set_i(value);
+  return attribute;
+}
+
+Ort::Env& GetOrtEnv() {
+  // OrtEnv is a process-wide singleton, so this shares the environment created in main.cc.
+  static Ort::Env ort_env(ORT_LOGGING_LEVEL_ERROR, "my_cpu_benchmark");
+  return ort_env;
+}
+
+void FillRandom(const TensorSpec& spec, void* data) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+  const auto size = static_cast<size_t>(spec.Size());
+  switch (spec.type) {
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+      for (size_t i = 0; i < size; ++i) static_cast<double*>(data)[i] = dist(gen);
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+      for (size_t i = 0; i < size; ++i) static_cast<MLFloat16*>(data)[i] = MLFloat16(dist(gen));
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_BFLOAT16:
+      for (size_t i = 0; i < size; ++i) static_cast<BFloat16*>(data)[i] = BFloat16(dist(gen));
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+      std::fill_n(static_cast<int32_t*>(data), size, 0);
+      break;
+    default:
+      for (size_t i = 0; i < size; ++i) static_cast<float*>(data)[i] = dist(gen);
+      break;
+  }
+}
+
+// Owns the session, the bound input/output buffers and the IoBinding for one single-node model.
+class SingleNodeRunner {
+ public:
+  SingleNodeRunner(const std::string& op_type, const std::string& domain, const std::vector<TensorSpec>& inputs,
+                   const std::vector<TensorSpec>& outputs, int64_t threads,
+                   const std::vector<ONNX_NAMESPACE::AttributeProto>& attributes = {})
+      : session_(nullptr), binding_(nullptr) {
+    const std::string model = MakeSingleNodeModel(op_type, domain, inputs, outputs, attributes);
+
+    Ort::SessionOptions options;
+    options.SetIntraOpNumThreads(static_cast<int>(threads));
+    options.SetGraphOptimizationLevel(ORT_DISABLE_ALL);
+    session_ = Ort::Session(GetOrtEnv(), model.data(), model.size(), options);
+    binding_ = Ort::IoBinding(session_);
+
+    for (const auto& spec : inputs) {
+      FillRandom(spec, Bind(spec, /*is_input*/ true));
+    }
+    for (const auto& spec : outputs) {
+      Bind(spec, /*is_input*/ false);
+    }
+  }
+
+  void* InputData(size_t index) { return buffers_[index].data(); }
+
+  size_t BytesPerRun() const { return bytes_per_run_; }
+
+  void Run() { session_.Run(Ort::RunOptions{nullptr}, binding_); }
+
+ private:
+  void* Bind(const TensorSpec& spec, bool is_input) {
+    const size_t bytes = static_cast<size_t>(spec.Size()) * ElementSize(spec.type);
+
+    void* data = nullptr;
+    if (spec.alias_of >= 0) {
+      data = buffers_[static_cast<size_t>(spec.alias_of)].data();
+    } else {
+      // Backed by float storage for alignment; bytes is rounded up.
+      buffers_.emplace_back((bytes + sizeof(float) - 1) / sizeof(float));
+      data = buffers_.back().data();
+      bytes_per_run_ += bytes;
+    }
+
+    auto memory_info = Ort::MemoryInfo::CreateCpu(OrtDeviceAllocator, OrtMemTypeDefault);
+    values_.push_back(Ort::Value::CreateTensor(memory_info, data, bytes, spec.shape.data(), spec.shape.size(),
+                                               spec.type));
+    if (is_input) {
+      binding_.BindInput(spec.name.c_str(), values_.back());
+    } else {
+      binding_.BindOutput(spec.name.c_str(), values_.back());
+    }
+    return data;
+  }
+
+  Ort::Session session_;
+  Ort::IoBinding binding_;
+  std::vector<std::vector<float>> buffers_;
+  std::vector<Ort::Value> values_;
+  size_t bytes_per_run_ = 0;
+};
+
+// bytes_per_run defaults to the size of every bound buffer.
+void RunAndReport(benchmark::State& state, SingleNodeRunner& runner, int64_t elements_per_run,
+                  int64_t bytes_per_run = -1) {
+  for (auto _ : state) {
+    runner.Run();
+  }
+  state.SetItemsProcessed(state.iterations() * elements_per_run);
+  state.SetBytesProcessed(state.iterations() *
+                          (bytes_per_run >= 0 ? bytes_per_run : static_cast<int64_t>(runner.BytesPerRun())));
+}
+
+// Args: rows (batch * seq), hidden size, intra-op threads. Hidden sizes are the GPT-2 model and MLP widths.
+void ActivationArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"rows", "hidden", "threads"});
+  b->ArgsProduct({{1, 128, 2048}, {768, 3072}, {1, 4}});
+}
+
+}  // namespace
+
+//
+// FastGelu
+//
+
+template <typename T>
+static void BM_MyCpuFastGelu(benchmark::State& state) {
+  const std::vector<int64_t> shape{state.range(0), state.range(1)};
+  SingleNodeRunner runner("FastGelu", kMyCustomDomain, {{"X", shape, OrtTypeOf<T>()}},
+                          {{"Y", shape, OrtTypeOf<T>()}}, state.range(2));
+  RunAndReport(state, runner, shape[0] * shape[1]);
+}
+
+BENCHMARK_TEMPLATE(BM_MyCpuFastGelu, float)->Apply(ActivationArgs)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_MyCpuFastGelu, double)->Apply(ActivationArgs)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_MyCpuFastGelu, MLFloat16)->Apply(ActivationArgs)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_MyCpuFastGelu, BFloat16)->Apply(ActivationArgs)->UseRealTime();
+
+// com.microsoft::FastGelu (float only on CPU)
+static void BM_ContribFastGelu(benchmark::State& state) {
+  const std::vector<int64_t> shape{state.range(0), state.range(1)};
+  SingleNodeRunner runner("FastGelu", kMSDomain, {{"X", shape, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT}},
+                          {{"Y", shape, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT}}, state.range(2));
+  RunAndReport(state, runner, shape[0] * shape[1]);
+}
+
+BENCHMARK(BM_ContribFastGelu)->Apply(ActivationArgs)->UseRealTime();
+
+// Reference: the same 4096-element chunked MlasComputeTanh loop called directly, with no session or kernel
+// dispatch. The gap to BM_MyCpuFastGelu<float> is the framework overhead.
+static void BM_MlasReferenceFastGelu(benchmark::State& state) {
+  const int64_t elements = state.range(0) * state.range(1);
+  const int64_t threads = state.range(2);
+  float* input = GenerateArrayWithRandomValue<float>(static_cast<size_t>(elements), -1.0f, 1.0f);
+  float* output = static_cast<float*>(aligned_alloc(sizeof(float) * static_cast<size_t>(elements), 64));
+
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = static_cast<int>(threads);
+  tpo.auto_set_affinity = true;
+  std::unique_ptr<concurrency::ThreadPool> tp(
+      concurrency::CreateThreadPool(&Env::Default(), tpo, concurrency::ThreadPoolType::INTRA_OP));
+
+  constexpr int64_t length_per_task = 4096;
+  const int64_t task_count = (elements + length_per_task - 1) / length_per_task;
+  constexpr float kAlpha = 0.7978845608028654f;
+  constexpr float kBeta = 0.035677408136300125f;
+
+  for (auto _ : state) {
+    concurrency::ThreadPool::TryBatchParallelFor(
+        tp.get(), static_cast<std::ptrdiff_t>(task_count),
+        [&](std::ptrdiff_t task_idx) {
+          const int64_t start = task_idx * length_per_task;
+          const int64_t count = std::min(length_per_task, elements - start);
+          const float* x = input + start;
+          float* y = output + start;
+          for (int64_t i = 0; i < count; ++i) {
+            y[i] = x[i] * (kBeta * x[i] * x[i] + kAlpha);
+          }
+          MlasComputeTanh(y, y, static_cast<size_t>(count));
+          for (int64_t i = 0; i < count; ++i) {
+            y[i] = 0.5f * x[i] * (y[i] + 1.0f);
+          }
+        },
+        0);
+  }
+
+  state.SetItemsProcessed(state.iterations() * elements);
+  state.SetBytesProcessed(state.iterations() * elements * 2 * static_cast<int64_t>(sizeof(float)));
+  aligned_free(input);
+  aligned_free(output);
+}
+
+BENCHMARK(BM_MlasReferenceFastGelu)->Apply(ActivationArgs)->UseRealTime();
+
+//
+// BiasGelu
+//
+
+static void RunBiasGelu(benchmark::State& state, const char* domain) {
+  const std::vector<int64_t> shape{state.range(0), state.range(1)};
+  SingleNodeRunner runner("BiasGelu", domain,
+                          {{"A", shape, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT},
+                           {"B", {shape[1]}, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT}},
+                          {{"C", shape, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT}}, state.range(2));
+  RunAndReport(state, runner, shape[0] * shape[1]);
+}
+
+static void BM_MyCpuBiasGelu(benchmark::State& state) {
+  RunBiasGelu(state, kMyCustomDomain);
+}
+
+static void BM_ContribBiasGelu(benchmark::State& state) {
+  RunBiasGelu(state, kMSDomain);
+}
+
+BENCHMARK(BM_MyCpuBiasGelu)->Apply(ActivationArgs)->UseRealTime();
+BENCHMARK(BM_ContribBiasGelu)->Apply(ActivationArgs)->UseRealTime();
+
+//
+// SkipLayerNormalization
+//
+
+template <typename T>
+static void RunSkipLayerNorm(benchmark::State& state, const char* domain) {
+  const std::vector<int64_t> shape{1, state.range(0), state.range(1)};
+  const std::vector<int64_t> hidden{state.range(1)};
+  const auto type = OrtTypeOf<T>();
+  SingleNodeRunner runner("SkipLayerNormalization", domain,
+                          {{"input", shape, type}, {"skip", shape, type}, {"gamma", hidden, type},
+                           {"beta", hidden, type}},
+                          {{"output", shape, type}}, state.range(2));
+  RunAndReport(state, runner, shape[1] * shape[2]);
+}
+
+template <typename T>
+static void BM_MyCpuSkipLayerNorm(benchmark::State& state) {
+  RunSkipLayerNorm<T>(state, kMyCustomDomain);
+}
+
+template <typename T>
+static void BM_ContribSkipLayerNorm(benchmark::State& state) {
+  RunSkipLayerNorm<T>(state, kMSDomain);
+}
+
+BENCHMARK_TEMPLATE(BM_MyCpuSkipLayerNorm, float)->Apply(ActivationArgs)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ContribSkipLayerNorm, float)->Apply(ActivationArgs)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ContribSkipLayerNorm, MLFloat16)->Apply(ActivationArgs)->UseRealTime();
+
+//
+// Attention (GPT-2 small heads: 12 x 64)
+//
+
+static void BM_MyCpuAttention(benchmark::State& state) {
+  const int64_t seq = state.range(0);
+  const int64_t causal = state.range(1);
+  const std::vector<int64_t> bnsh{1, 12, seq, 64};
+  SingleNodeRunner runner("Attention", kMyCustomDomain,
+                          {{"query", bnsh, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT},
+                           {"key", bnsh, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT},
+                           {"value", bnsh, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT}},
+                          {{"output", {1, seq, 12, 64}, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT}}, state.range(2),
+                          {MakeAttribute("unidirectional", causal)});
+  RunAndReport(state, runner, 12 * seq * 64);
+}
+
+BENCHMARK(BM_MyCpuAttention)
+    ->ArgNames({"seq", "causal", "threads"})
+    ->ArgsProduct({{64, 256, 1024}, {0, 1}, {1, 4}})
+    ->UseRealTime();
+
+//
+// DecoderMaskedAttention: one decode step against a 1024-slot cache, with present_* bound to the past_* buffers
+// as a decode loop does through IOBinding. Cost should track `past`, not the cache size.
+//
+
+static void BM_MyCpuDecoderMaskedAttention(benchmark::State& state) {
+  const int64_t past = state.range(0);
+  constexpr int64_t max_seq = 1024;
+  const std::vector<int64_t> step{1, 12, 1, 64};
+  const std::vector<int64_t> cache{1, 12, max_seq, 64};
+  SingleNodeRunner runner("DecoderMaskedAttention", kMyCustomDomain,
+                          {{"query", step, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT},
+                           {"key", step, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT},
+                           {"value", step, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT},
+                           {"past_key", cache, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT},
+                           {"past_value", cache, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT},
+                           {"past_sequence_length", {1}, ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32}},
+                          {{"output", {1, 1, 12, 64}, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT},
+                           {"present_key", cache, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, 3},
+                           {"present_value", cache, ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, 4}},
+                          state.range(1));
+  *static_cast<int32_t*>(runner.InputData(5)) = static_cast<int32_t>(past);
+
+  // Only the valid prefix of the cache plus the new row is touched.
+  const int64_t attended = 12 * (past + 1) * 64;
+  const int64_t step_bytes = 12 * 64 * static_cast<int64_t>(sizeof(float));
+  RunAndReport(state, runner, attended, 2 * attended * static_cast<int64_t>(sizeof(float)) + 4 * step_bytes);
+}
+
+BENCHMARK(BM_MyCpuDecoderMaskedAttention)
+    ->ArgNames({"past", "threads"})
+    ->ArgsProduct({{16, 128, 512, 1000}, {1, 4}})
+    ->UseRealTime();
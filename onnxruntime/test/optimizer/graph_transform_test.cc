@@ -63,6 +63,8 @@
 #include "core/optimizer/matmul_integer_to_float.h"
 #include "core/optimizer/matmul_scale_fusion.h"
 #include "core/optimizer/matmul_transpose_fusion.h"
+#include "core/optimizer/my_cpu_attention_fusion.h"
+#include "core/optimizer/my_cpu_bias_gelu_fusion.h"
 #include "core/optimizer/noop_elimination.h"
 #include "core/optimizer/not_where_fusion.h"
 #include "core/optimizer/pad_fusion.h"
@@ -3038,6 +3040,69 @@ TEST_F(GraphTransformationTests, Gemm_LeakyRelu_Fusion) {
   ASSERT_TRUE(op_to_count["Gemm"] == 0);
   ASSERT_TRUE(op_to_count["com.microsoft.FusedGemm"] == 1);
 }
+
+// The GELU variants are applied by MLAS to the FusedGemm output, which must match the unfused graph.
+TEST_F(GraphTransformationTests, Gemm_Gelu_Fusion) {
+  for (const char* activation : {"Gelu", "FastGelu", "QuickGelu"}) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>({{6, 40}}, -3.f, 3.f);
+      auto* weight_arg = builder.MakeInitializer<float>({40, 300}, -0.5f, 0.5f);
+      auto* bias_arg = builder.MakeInitializer<float>({300}, -1.f, 1.f);
+      auto* gemm_out_arg = builder.MakeIntermediate();
+      auto* output_arg = builder.MakeOutput();
+
+      builder.AddNode("Gemm", {input_arg, weight_arg, bias_arg}, {gemm_out_arg});
+      builder.AddNode(activation, {gemm_out_arg}, {output_arg}, kMSDomain);
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["Gemm"], 0);
+      EXPECT_EQ(op_to_count["com.microsoft.FusedGemm"], 1);
+    };
+
+    TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level2, 13,
+                      0.0001, 0.0001);
+  }
+}
+
+TEST_F(GraphTransformationTests, MatMul_Gelu_Fusion) {
+  for (const char* activation : {"Gelu", "FastGelu", "QuickGelu"}) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>({{2, 6, 40}}, -3.f, 3.f);
+      auto* weight_arg = builder.MakeInitializer<float>({40, 300}, -0.5f, 0.5f);
+      auto* matmul_out_arg = builder.MakeIntermediate();
+      auto* output_arg = builder.MakeOutput();
+
+      builder.AddNode("MatMul", {input_arg, weight_arg}, {matmul_out_arg});
+      builder.AddNode(activation, {matmul_out_arg}, {output_arg}, kMSDomain);
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["MatMul"], 0);
+      EXPECT_EQ(op_to_count["com.microsoft.FusedMatMulActivation"], 1);
+    };
+
+    auto enable_fusion = [](SessionOptions& session_options) {
+      ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(kOrtSessionOptionsEnableMatMulActivationFusion,
+                                                                     "1"));
+    };
+
+    TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level2, 13,
+                      0.0001, 0.0001, nullptr, enable_fusion);
+
+    // the CPU fusion is opt-in
+    auto check_unfused_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["MatMul"], 1);
+      EXPECT_EQ(op_to_count["com.microsoft.FusedMatMulActivation"], 0);
+    };
+
+    TransformerTester(build_test_case, check_unfused_graph, TransformerLevel::Level1, TransformerLevel::Level2, 13,
+                      0.0001, 0.0001);
+  }
+}
 #endif
 
 // (A')'B' = AB'
@@ -5023,6 +5088,116 @@ TEST_F(GraphTransformationTests, BiasOnnxFastGeluTest) {
   ASSERT_TRUE(op_to_count["com.microsoft.BiasGelu"] == 0);
 }
 
+TEST_F(GraphTransformationTests, MyCpuBiasGeluFusionTest) {
+  for (bool bias_first : {false, true}) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>({{2, 4, 8}});
+      auto* weight_arg = builder.MakeInitializer<float>({8, 16}, -1.0f, 1.0f);
+      auto* bias_arg = builder.MakeInitializer<float>({16}, -1.0f, 1.0f);
+      auto* matmul_out = builder.MakeIntermediate();
+      auto* add_out = builder.MakeIntermediate();
+      auto* gelu_out = builder.MakeOutput();
+
+      builder.AddNode("MatMul", {input_arg, weight_arg}, {matmul_out});
+      if (bias_first) {
+        builder.AddNode("Add", {bias_arg, matmul_out}, {add_out});
+      } else {
+        builder.AddNode("Add", {matmul_out, bias_arg}, {add_out});
+      }
+      builder.AddNode("FastGelu", {add_out}, {gelu_out}, kMyCustomDomain);
+    };
+
+    auto pre_graph_checker = [&](Graph& graph) {
+      auto op_to_count = CountOpsInGraph(graph);
+      TEST_RETURN_IF_NOT(op_to_count["Add"] == 1);
+      TEST_RETURN_IF_NOT(op_to_count["com.my_virtual_npu.FastGelu"] == 1);
+      return Status::OK();
+    };
+
+    auto post_graph_checker = [&](Graph& graph) {
+      auto op_to_count = CountOpsInGraph(graph);
+      TEST_RETURN_IF_NOT(op_to_count["MatMul"] == 1);
+      TEST_RETURN_IF_NOT(op_to_count["Add"] == 0);
+      TEST_RETURN_IF_NOT(op_to_count["com.my_virtual_npu.FastGelu"] == 0);
+      TEST_RETURN_IF_NOT(op_to_count["com.my_virtual_npu.BiasGelu"] == 1);
+      for (const Node& node : graph.Nodes()) {
+        if (node.OpType() == "BiasGelu") {
+          // The MatMul output must be plugged into the data input regardless of the Add input order.
+          const Node* producer = graph.GetProducerNode(node.InputDefs()[0]->Name());
+          TEST_RETURN_IF_NOT(producer != nullptr && producer->OpType() == "MatMul");
+        }
+      }
+      return Status::OK();
+    };
+
+    std::unique_ptr<GraphTransformer> transformer = std::make_unique<MyCpuBiasGeluFusion>();
+    ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_, std::move(transformer),
+                                          TransformerLevel::Level2, 1, pre_graph_checker, post_graph_checker));
+  }
+}
+
+TEST_F(GraphTransformationTests, MyCpuAttentionFusionTest) {
+  constexpr int64_t batch = 2, heads = 2, seq = 4, head_size = 8;
+  for (bool with_mask : {false, true}) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* q_arg = builder.MakeInput<float>({{batch, heads, seq, head_size}});
+      auto* k_arg = builder.MakeInput<float>({{batch, heads, seq, head_size}});
+      auto* v_arg = builder.MakeInput<float>({{batch, heads, seq, head_size}});
+      auto* kt_out = builder.MakeIntermediate();
+      auto* qk_out = builder.MakeIntermediate();
+      auto* div_out = builder.MakeIntermediate();
+      auto* mask_out = builder.MakeIntermediate();
+      auto* softmax_out = builder.MakeIntermediate();
+      auto* pv_out = builder.MakeIntermediate();
+      auto* output = builder.MakeOutput();
+
+      builder.AddNode("Transpose", {k_arg}, {kt_out}).AddAttribute("perm", std::vector<int64_t>{0, 1, 3, 2});
+      builder.AddNode("MatMul", {q_arg, kt_out}, {qk_out});
+      builder.AddNode("Div", {qk_out, builder.MakeScalarInitializer<float>(8.0f)}, {div_out});
+      if (with_mask) {
+        std::vector<float> mask(seq * seq);
+        for (int64_t i = 0; i < seq; ++i) {
+          for (int64_t j = 0; j < seq; ++j) {
+            mask[i * seq + j] = j <= i ? 0.0f : -10000.0f;
+          }
+        }
+        builder.AddNode("Add", {div_out, builder.MakeInitializer<float>({1, 1, seq, seq}, mask)}, {mask_out});
+      }
+      builder.AddNode("Softmax", {with_mask ? mask_out : div_out}, {softmax_out}).AddAttribute("axis", int64_t{-1});
+      builder.AddNode("MatMul", {softmax_out, v_arg}, {pv_out});
+      builder.AddNode("Transpose", {pv_out}, {output}).AddAttribute("perm", std::vector<int64_t>{0, 2, 1, 3});
+    };
+
+    auto pre_graph_checker = [&](Graph& graph) {
+      auto op_to_count = CountOpsInGraph(graph);
+      TEST_RETURN_IF_NOT(op_to_count["Softmax"] == 1);
+      TEST_RETURN_IF_NOT(op_to_count["MatMul"] == 2);
+      return Status::OK();
+    };
+
+    auto post_graph_checker = [&](Graph& graph) {
+      auto op_to_count = CountOpsInGraph(graph);
+      TEST_RETURN_IF_NOT(op_to_count["com.my_virtual_npu.Attention"] == 1);
+      TEST_RETURN_IF_NOT(op_to_count["Softmax"] == 0);
+      TEST_RETURN_IF_NOT(op_to_count["MatMul"] == 0);
+      TEST_RETURN_IF_NOT(op_to_count["Transpose"] == 0);
+      TEST_RETURN_IF_NOT(op_to_count["Div"] == 0);
+      TEST_RETURN_IF_NOT(op_to_count["Add"] == 0);
+      for (const Node& node : graph.Nodes()) {
+        if (node.OpType() == "Attention") {
+          TEST_RETURN_IF_NOT(graph_utils::GetNodeAttribute(node, "scale")->f() == 0.125f);
+          TEST_RETURN_IF_NOT(graph_utils::GetNodeAttribute(node, "unidirectional")->i() == (with_mask ? 1 : 0));
+        }
+      }
+      return Status::OK();
+    };
+
+    std::unique_ptr<GraphTransformer> transformer = std::make_unique<MyCpuAttentionFusion>();
+    ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_, std::move(transformer),
+                                          TransformerLevel::Level2, 1, pre_graph_checker, post_graph_checker));
+  }
+}
+
 // BiasGelu allows input switching based on input dimensions.
 // This test validates the input edges are plugged correct in the optimized graph.
 TEST_F(GraphTransformationTests, BiasGeluSwitchedInputOrder) {
@@ -5237,6 +5412,46 @@ TEST_F(GraphTransformationTests, FastGeluFusionTest) {
   ASSERT_TRUE(op_to_count["com.microsoft.FastGelu"] == 1);
 }
 
+TEST_F(GraphTransformationTests, FastGeluFusionMyCustomDomainTest) {
+  for (const ORTCHAR_T* model_uri : {MODEL_FOLDER "fusion/fast_gelu.onnx", MODEL_FOLDER "fusion/fast_gelu2.onnx"}) {
+    std::shared_ptr<Model> p_model;
+    ASSERT_STATUS_OK(Model::Load(model_uri, p_model, nullptr, *logger_));
+    Graph& graph = p_model->MainGraph();
+    for (auto& node : graph.Nodes()) {
+      node.SetExecutionProviderType(kCpuExecutionProvider);
+    }
+
+    onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+    ASSERT_STATUS_OK(graph_transformation_mgr.Register(
+        std::make_unique<FastGeluFusion>(InlinedHashSet<std::string_view>{}, kMyCustomDomain), TransformerLevel::Level2));
+    ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2, *logger_));
+
+    std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+    ASSERT_TRUE(op_to_count["Tanh"] == 0);
+    ASSERT_TRUE(op_to_count["com.microsoft.FastGelu"] == 0);
+    ASSERT_TRUE(op_to_count["com.my_virtual_npu.FastGelu"] == 1);
+  }
+}
+
+TEST_F(GraphTransformationTests, FastGeluFusionMyCustomDomainSkipsNonCpuEp) {
+  constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "fusion/fast_gelu.onnx";
+  std::shared_ptr<Model> p_model;
+  ASSERT_STATUS_OK(Model::Load(model_uri, p_model, nullptr, *logger_));
+  Graph& graph = p_model->MainGraph();
+  for (auto& node : graph.Nodes()) {
+    node.SetExecutionProviderType(kCudaExecutionProvider);
+  }
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(
+      std::make_unique<FastGeluFusion>(InlinedHashSet<std::string_view>{}, kMyCustomDomain), TransformerLevel::Level2));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level2, *logger_));
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["Tanh"] == 1);
+  ASSERT_TRUE(op_to_count["com.my_virtual_npu.FastGelu"] == 0);
+}
+
 TEST_F(GraphTransformationTests, FastGeluUseGraphInputFusionTest) {
   constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "fusion/fast_gelu_use_graph_input.onnx";
   std::shared_ptr<Model> p_model;
@@ -276,6 +276,37 @@ TEST(ThreadPoolTest, TestBatchParallelFor_2_Thread_81_Task_20_Batch) {
   TestBatchParallelFor("TestBatchParallelFor_2_Thread_81_Task_20_Batch", 2, 81, 20);
 }
 
+TEST(ThreadPoolTest, TestParallelForByNumaNode) {
+  // 4 worker threads on two (simulated) NUMA nodes, plus a placeholder for the main thread
+  onnxruntime::ThreadOptions thread_options;
+  thread_options.numa_nodes = {-1, 0, 0, 3, 3};
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), thread_options, nullptr, 5, true);
+  ASSERT_EQ(ThreadPool::NumNumaNodes(tp.get()), 2);
+  ASSERT_EQ(ThreadPool::NumNumaNodes(nullptr), 1);
+
+  for (int num_tasks : {1, 7, 50, 1000}) {
+    for (std::ptrdiff_t block_size : {1, 3, 64}) {
+      auto test_data = CreateTestData(num_tasks);
+      ThreadPool::TryParallelForByNumaNode(tp.get(), num_tasks, block_size,
+                                           [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+                                             for (std::ptrdiff_t i = first; i < last; ++i) {
+                                               IncrementElement(*test_data, i);
+                                             }
+                                           });
+      ValidateTestData(*test_data);
+
+      test_data = CreateTestData(num_tasks);
+      ThreadPool::TryParallelForByNumaNode(nullptr, num_tasks, block_size,
+                                           [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+                                             for (std::ptrdiff_t i = first; i < last; ++i) {
+                                               IncrementElement(*test_data, i);
+                                             }
+                                           });
+      ValidateTestData(*test_data);
+    }
+  }
+}
+
 TEST(ThreadPoolTest, TestConcurrentParallelFor_0Thread_1Conc_0Tasks) {
   TestConcurrentParallelFor("TestConcurrentParallelFor_0Thread_1Conc_0Tasks", 0, 1, 0);
 }
@@ -3,6 +3,7 @@
 
 #include "gtest/gtest.h"
 
+#include "core/mlas/inc/mlas.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/common/dnnl_op_test_utils.h"
 #include "test/common/cuda_op_test_utils.h"
@@ -482,6 +483,50 @@ TEST(MathOpTest, MatMul_Float16) {
 }
 #endif
 
+// The CPU EP only registers the MLFloat16 MatMul kernel when MLAS has an accelerated half gemm.
+TEST(MathOpTest, MatMulFloat16Cpu) {
+  if (!MlasHalfGemmSupported()) {
+    GTEST_SKIP() << "MLAS half precision GEMM is not accelerated on this CPU";
+  }
+
+  constexpr int64_t batch = 3, M = 5, K = 37, N = 21;
+  const std::vector<int64_t> a_dims{batch, M, K};
+  const std::vector<int64_t> b_dims{K, N};
+  RandomValueGenerator random{};
+  const std::vector<float> A = random.Uniform<float>(a_dims, -1.0f, 1.0f);
+  const std::vector<float> B = random.Uniform<float>(b_dims, -1.0f, 1.0f);
+
+  // Compute the expected output from the fp16 rounded inputs.
+  const std::vector<MLFloat16> f_A = FloatsToMLFloat16s(A);
+  const std::vector<MLFloat16> f_B = FloatsToMLFloat16s(B);
+  std::vector<float> Y(batch * M * N, 0.0f);
+  for (int64_t b = 0; b < batch; b++) {
+    for (int64_t m = 0; m < M; m++) {
+      for (int64_t n = 0; n < N; n++) {
+        float sum = 0.0f;
+        for (int64_t k = 0; k < K; k++) {
+          sum += f_A[(b * M + m) * K + k].ToFloat() * f_B[k * N + n].ToFloat();
+        }
+        Y[(b * M + m) * N + n] = sum;
+      }
+    }
+  }
+
+  auto run_test = [&](bool B_is_constant) {
+    OpTester test("MatMul", 13);
+    test.AddInput<MLFloat16>("A", a_dims, f_A);
+    test.AddInput<MLFloat16>("B", b_dims, f_B, B_is_constant);
+    test.AddOutput<MLFloat16>("Y", {batch, M, N}, FloatsToMLFloat16s(Y));
+    test.SetOutputTolerance(0.01f, 0.01f);
+
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  };
+  run_test(true);
+  run_test(false);
+}
+
 #if defined(USE_CUDA) || defined(USE_ROCM) || defined(USE_DNNL)
 TEST(MathOpTest, MatMul_bfloat16) {
 #ifdef USE_CUDA
@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+#include "core/graph/constants.h"
+#include "core/graph/contrib_ops/contrib_defs.h"
+
+namespace onnxruntime {
+namespace test {
+
+// Naive softmax(scale * Q * K^T + causal_mask) * V with Q/K/V in BNSH and output in BSNH.
+static std::vector<float> ComputeAttentionReference(const std::vector<float>& q, const std::vector<float>& k,
+                                                    const std::vector<float>& v, int64_t batch, int64_t heads,
+                                                    int64_t seq, int64_t kv_seq, int64_t head_size,
+                                                    int64_t v_head_size, float scale, bool causal) {
+  std::vector<float> output(static_cast<size_t>(batch * seq * heads * v_head_size));
+  std::vector<float> scores(static_cast<size_t>(kv_seq));
+  const int64_t past = kv_seq - seq;
+
+  for (int64_t b = 0; b < batch; ++b) {
+    for (int64_t n = 0; n < heads; ++n) {
+      const float* q_bn = q.data() + (b * heads + n) * seq * head_size;
+      const float* k_bn = k.data() + (b * heads + n) * kv_seq * head_size;
+      const float* v_bn = v.data() + (b * heads + n) * kv_seq * v_head_size;
+      for (int64_t i = 0; i < seq; ++i) {
+        const int64_t visible = causal ? i + past + 1 : kv_seq;
+        float max_score = std::numeric_limits<float>::lowest();
+        for (int64_t j = 0; j < visible; ++j) {
+          float dot = 0.0f;
+          for (int64_t h = 0; h < head_size; ++h) dot += q_bn[i * head_size + h] * k_bn[j * head_size + h];
+          scores[j] = dot * scale;
+          max_score = std::max(max_score, scores[j]);
+        }
+
+        float sum = 0.0f;
+        for (int64_t j = 0; j < visible; ++j) {
+          scores[j] = std::exp(scores[j] - max_score);
+          sum += scores[j];
+        }
+
+        float* out = output.data() + ((b * seq + i) * heads + n) * v_head_size;
+        for (int64_t h = 0; h < v_head_size; ++h) {
+          float acc = 0.0f;
+          for (int64_t j = 0; j < visible; ++j) acc += scores[j] * v_bn[j * v_head_size + h];
+          out[h] = acc / sum;
+        }
+      }
+    }
+  }
+  return output;
+}
+
+static void RunAttentionTest(int64_t batch, int64_t heads, int64_t seq, int64_t kv_seq, int64_t head_size,
+                             int64_t v_head_size, bool causal, float scale = 0.0f) {
+  onnxruntime::contrib::RegisterMyVirtualNpuSchemas();
+
+  std::vector<float> q(static_cast<size_t>(batch * heads * seq * head_size));
+  std::vector<float> k(static_cast<size_t>(batch * heads * kv_seq * head_size));
+  std::vector<float> v(static_cast<size_t>(batch * heads * kv_seq * v_head_size));
+  for (size_t i = 0; i < q.size(); ++i) q[i] = static_cast<float>(i % 13) * 0.1f - 0.6f;
+  for (size_t i = 0; i < k.size(); ++i) k[i] = static_cast<float>(i % 11) * 0.1f - 0.5f;
+  for (size_t i = 0; i < v.size(); ++i) v[i] = static_cast<float>(i % 7) * 0.2f - 0.6f;
+
+  const float effective_scale = scale == 0.0f ? 1.0f / std::sqrt(static_cast<float>(head_size)) : scale;
+
+  OpTester test("Attention", 1, kMyCustomDomain);
+  if (scale != 0.0f) {
+    test.AddAttribute<float>("scale", scale);
+  }
+  test.AddAttribute<int64_t>("unidirectional", causal ? 1 : 0);
+  test.AddInput<float>("query", {batch, heads, seq, head_size}, q);
+  test.AddInput<float>("key", {batch, heads, kv_seq, head_size}, k);
+  test.AddInput<float>("value", {batch, heads, kv_seq, v_head_size}, v);
+  test.AddOutput<float>("output", {batch, seq, heads, v_head_size},
+                        ComputeAttentionReference(q, k, v, batch, heads, seq, kv_seq, head_size, v_head_size,
+                                                  effective_scale, causal));
+  test.SetOutputTolerance(1e-4f);
+  test.Run();
+}
+
+TEST(MyCpuAttentionTest, Causal) {
+  RunAttentionTest(2, 2, 4, 4, 8, 8, true);
+}
+
+TEST(MyCpuAttentionTest, Bidirectional) {
+  RunAttentionTest(2, 2, 4, 4, 8, 8, false);
+}
+
+TEST(MyCpuAttentionTest, ExplicitScale) {
+  RunAttentionTest(1, 3, 5, 5, 16, 16, true, 0.5f);
+}
+
+// kv_sequence_length > sequence_length: the causal mask is aligned to the end of the key sequence.
+TEST(MyCpuAttentionTest, CausalWithPastKeys) {
+  RunAttentionTest(1, 2, 3, 7, 8, 4, true);
+}
+
+// Long enough to span several q and kv tiles, so masked and partially masked tiles are exercised.
+TEST(MyCpuAttentionTest, CausalMultipleBlocks) {
+  RunAttentionTest(1, 2, 300, 300, 64, 64, true);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
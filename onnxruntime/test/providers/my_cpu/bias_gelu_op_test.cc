@@ -0,0 +1,57 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+#include "core/graph/constants.h"
+#include "core/graph/contrib_ops/contrib_defs.h"
+
+namespace onnxruntime {
+namespace test {
+
+static std::vector<float> ComputeBiasGeluReference(const std::vector<float>& input, const std::vector<float>& bias) {
+  constexpr float kAlpha = 0.7978845608028654f;
+  constexpr float kBeta = 0.044715f;
+
+  std::vector<float> output(input.size());
+  for (size_t i = 0; i < input.size(); ++i) {
+    float x = input[i] + bias[i % bias.size()];
+    float inner = kAlpha * (x + kBeta * x * x * x);
+    output[i] = 0.5f * x * (1.0f + std::tanh(inner));
+  }
+  return output;
+}
+
+static void RunBiasGeluTest(const std::vector<int64_t>& input_shape) {
+  onnxruntime::contrib::RegisterMyVirtualNpuSchemas();
+
+  const int64_t bias_len = input_shape.back();
+  int64_t input_size = 1;
+  for (auto dim : input_shape) input_size *= dim;
+
+  std::vector<float> input(static_cast<size_t>(input_size));
+  std::vector<float> bias(static_cast<size_t>(bias_len));
+  for (size_t i = 0; i < input.size(); ++i) input[i] = static_cast<float>(i % 61) / 10.0f - 3.0f;
+  for (size_t i = 0; i < bias.size(); ++i) bias[i] = static_cast<float>(i % 9) * 0.1f - 0.4f;
+
+  OpTester test("BiasGelu", 1, kMyCustomDomain);
+  test.AddInput<float>("A", input_shape, input);
+  test.AddInput<float>("B", {bias_len}, bias);
+  test.AddOutput<float>("C", input_shape, ComputeBiasGeluReference(input, bias));
+  test.Run();
+}
+
+TEST(MyCpuBiasGeluTest, Basic) {
+  RunBiasGeluTest({2, 3, 4});
+}
+
+TEST(MyCpuBiasGeluTest, OddHiddenSize) {
+  RunBiasGeluTest({3, 37});
+}
+
+TEST(MyCpuBiasGeluTest, GPT2Intermediate) {
+  RunBiasGeluTest({1, 8, 3072});
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,376 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+#include "test/test_environment.h"
+#include "test/unittest_util/framework_test_utils.h"
+#include "test/util/include/asserts.h"
+#include "core/graph/constants.h"
+#include "core/graph/contrib_ops/contrib_defs.h"
+#include "core/graph/model.h"
+#include "core/session/inference_session.h"
+#include "core/session/IOBinding.h"
+
+namespace onnxruntime {
+namespace test {
+
+// Naive causal attention of `seq` new queries over the first `total` rows of each head of the cache.
+static std::vector<float> ComputeDecoderAttentionReference(const std::vector<float>& q,
+                                                           const std::vector<float>& k_cache,
+                                                           const std::vector<float>& v_cache, int64_t batch,
+                                                           int64_t heads, int64_t seq, int64_t past, int64_t max_seq,
+                                                           int64_t head_size, float scale) {
+  std::vector<float> output(static_cast<size_t>(batch * seq * heads * head_size));
+  std::vector<float> scores(static_cast<size_t>(max_seq));
+
+  for (int64_t b = 0; b < batch; ++b) {
+    for (int64_t n = 0; n < heads; ++n) {
+      const float* q_bn = q.data() + (b * heads + n) * seq * head_size;
+      const float* k_bn = k_cache.data() + (b * heads + n) * max_seq * head_size;
+      const float* v_bn = v_cache.data() + (b * heads + n) * max_seq * head_size;
+      for (int64_t i = 0; i < seq; ++i) {
+        const int64_t visible = past + i + 1;
+        float max_score = std::numeric_limits<float>::lowest();
+        for (int64_t j = 0; j < visible; ++j) {
+          float dot = 0.0f;
+          for (int64_t h = 0; h < head_size; ++h) dot += q_bn[i * head_size + h] * k_bn[j * head_size + h];
+          scores[j] = dot * scale;
+          max_score = std::max(max_score, scores[j]);
+        }
+
+        float sum = 0.0f;
+        for (int64_t j = 0; j < visible; ++j) {
+          scores[j] = std::exp(scores[j] - max_score);
+          sum += scores[j];
+        }
+
+        float* out = output.data() + ((b * seq + i) * heads + n) * head_size;
+        for (int64_t h = 0; h < head_size; ++h) {
+          float acc = 0.0f;
+          for (int64_t j = 0; j < visible; ++j) acc += scores[j] * v_bn[j * head_size + h];
+          out[h] = acc / sum;
+        }
+      }
+    }
+  }
+  return output;
+}
+
+// Wraps `data` in an OrtValue without copying it.
+template <typename T>
+static OrtValue WrapBuffer(const std::vector<int64_t>& dims, std::vector<T>& data) {
+  OrtValue value;
+  CreateMLValue<T>(dims, data.data(), OrtMemoryInfo(CPU, OrtDeviceAllocator), &value);
+  return value;
+}
+
+// Runs the model built by `test` the way a decode loop drives it: present_<name> is bound onto the past_<name> feed
+// through IOBinding for every name in `cache_names`. Checks that each present_* output is the fed buffer, i.e. the
+// step appended to the cache in place without copying it, and returns the attention output.
+static void RunWithSharedCache(OpTester& test, const std::unordered_map<std::string, OrtValue>& feeds,
+                               const std::vector<std::string>& cache_names, std::vector<float>& output) {
+  std::string serialized;
+  ASSERT_TRUE(test.BuildModel().ToProto().SerializeToString(&serialized));
+  std::stringstream model_stream(serialized);
+
+  SessionOptions so;
+  InferenceSession session{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session.Load(model_stream));
+  ASSERT_STATUS_OK(session.Initialize());
+
+  std::unique_ptr<IOBinding> io_binding;
+  ASSERT_STATUS_OK(session.NewIOBinding(&io_binding));
+  for (const auto& [name, value] : feeds) {
+    ASSERT_STATUS_OK(io_binding->BindInput(name, value));
+  }
+  ASSERT_STATUS_OK(io_binding->BindOutput("output"));
+  for (const auto& name : cache_names) {
+    ASSERT_STATUS_OK(io_binding->BindOutput("present_" + name, feeds.at("past_" + name)));
+  }
+
+  RunOptions run_options;
+  ASSERT_STATUS_OK(session.Run(run_options, *io_binding));
+
+  const auto& output_names = io_binding->GetOutputNames();
+  const auto& outputs = io_binding->GetOutputs();
+  for (size_t i = 0; i < output_names.size(); ++i) {
+    const Tensor& tensor = outputs[i].Get<Tensor>();
+    if (output_names[i] == "output") {
+      const auto values = tensor.DataAsSpan<float>();
+      output.assign(values.begin(), values.end());
+    } else {
+      const std::string past_name = "past_" + output_names[i].substr(sizeof("present_") - 1);
+      EXPECT_EQ(tensor.DataRaw(), feeds.at(past_name).Get<Tensor>().DataRaw()) << output_names[i];
+    }
+  }
+}
+
+static void ExpectOutputNear(const std::vector<float>& expected, const std::vector<float>& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_NEAR(expected[i], actual[i], 1e-4f) << "at index " << i;
+  }
+}
+
+static void RunDecoderMaskedAttentionTest(int64_t batch, int64_t heads, int64_t seq, int64_t past,
+                                          int64_t max_seq, int64_t head_size) {
+  onnxruntime::contrib::RegisterMyVirtualNpuSchemas();
+
+  const std::vector<int64_t> new_shape{batch, heads, seq, head_size};
+  const std::vector<int64_t> cache_shape{batch, heads, max_seq, head_size};
+
+  std::vector<float> q(static_cast<size_t>(batch * heads * seq * head_size));
+  std::vector<float> k(q.size());
+  std::vector<float> v(q.size());
+  for (size_t i = 0; i < q.size(); ++i) q[i] = static_cast<float>(i % 13) * 0.1f - 0.6f;
+  for (size_t i = 0; i < k.size(); ++i) k[i] = static_cast<float>(i % 11) * 0.1f - 0.5f;
+  for (size_t i = 0; i < v.size(); ++i) v[i] = static_cast<float>(i % 7) * 0.2f - 0.6f;
+
+  // Positions past the valid prefix hold a large sentinel; any read of them would blow up the softmax.
+  std::vector<float> past_k(static_cast<size_t>(batch * heads * max_seq * head_size), 100.0f);
+  std::vector<float> past_v(past_k.size(), 100.0f);
+  std::vector<float> present_k;
+  std::vector<float> present_v;
+  for (int64_t bn = 0; bn < batch * heads; ++bn) {
+    for (int64_t s = 0; s < past; ++s) {
+      for (int64_t h = 0; h < head_size; ++h) {
+        const size_t idx = static_cast<size_t>((bn * max_seq + s) * head_size + h);
+        past_k[idx] = static_cast<float>((idx * 7) % 17) * 0.05f - 0.4f;
+        past_v[idx] = static_cast<float>((idx * 5) % 19) * 0.05f - 0.45f;
+      }
+    }
+  }
+
+  present_k = past_k;
+  present_v = past_v;
+  for (int64_t bn = 0; bn < batch * heads; ++bn) {
+    std::copy_n(k.begin() + bn * seq * head_size, seq * head_size,
+                present_k.begin() + (bn * max_seq + past) * head_size);
+    std::copy_n(v.begin() + bn * seq * head_size, seq * head_size,
+                present_v.begin() + (bn * max_seq + past) * head_size);
+  }
+
+  const float scale = 1.0f / std::sqrt(static_cast<float>(head_size));
+  const std::vector<float> expected_output =
+      ComputeDecoderAttentionReference(q, present_k, present_v, batch, heads, seq, past, max_seq, head_size, scale);
+
+  OpTester test("DecoderMaskedAttention", 1, kMyCustomDomain);
+  test.AddInput<float>("query", new_shape, q);
+  test.AddInput<float>("key", new_shape, k);
+  test.AddInput<float>("value", new_shape, v);
+  test.AddInput<float>("past_key", cache_shape, past_k);
+  test.AddInput<float>("past_value", cache_shape, past_v);
+  test.AddInput<int32_t>("past_sequence_length", {1}, {static_cast<int32_t>(past)});
+  test.AddOutput<float>("output", {batch, seq, heads, head_size}, expected_output);
+  test.AddOutput<float>("present_key", cache_shape, present_k);
+  test.AddOutput<float>("present_value", cache_shape, present_v);
+
+  // present_* share the past_* buffers, so the updated cache is read back from past_k/past_v.
+  std::vector<int32_t> past_seq_len{static_cast<int32_t>(past)};
+  std::unordered_map<std::string, OrtValue> feeds{
+      {"query", WrapBuffer(new_shape, q)},
+      {"key", WrapBuffer(new_shape, k)},
+      {"value", WrapBuffer(new_shape, v)},
+      {"past_key", WrapBuffer(cache_shape, past_k)},
+      {"past_value", WrapBuffer(cache_shape, past_v)},
+      {"past_sequence_length", WrapBuffer({1}, past_seq_len)}};
+  std::vector<float> output;
+  RunWithSharedCache(test, feeds, {"key", "value"}, output);
+  ExpectOutputNear(expected_output, output);
+  EXPECT_EQ(present_k, past_k);
+  EXPECT_EQ(present_v, past_v);
+}
+
+TEST(MyCpuDecoderMaskedAttentionTest, SingleTokenStep) {
+  RunDecoderMaskedAttentionTest(2, 2, 1, 5, 8, 16);
+}
+
+TEST(MyCpuDecoderMaskedAttentionTest, Prefill) {
+  RunDecoderMaskedAttentionTest(1, 2, 4, 0, 8, 8);
+}
+
+TEST(MyCpuDecoderMaskedAttentionTest, FillsCache) {
+  RunDecoderMaskedAttentionTest(1, 3, 2, 6, 8, 8);
+}
+
+// int8 cache: the new rows are exact multiples of 0.01 with a +-1.27 element per row, so the kernel's
+// symmetric quantization reproduces them exactly and the expected cache can be written down directly.
+static void RunQuantizedDecoderMaskedAttentionTest(int64_t batch, int64_t heads, int64_t seq, int64_t past,
+                                                   int64_t max_seq, int64_t head_size) {
+  onnxruntime::contrib::RegisterMyVirtualNpuSchemas();
+
+  const std::vector<int64_t> new_shape{batch, heads, seq, head_size};
+  const std::vector<int64_t> cache_shape{batch, heads, max_seq, head_size};
+  const std::vector<int64_t> scale_shape{batch, heads, max_seq};
+  const int64_t new_rows = batch * heads * seq;
+
+  std::vector<float> q(static_cast<size_t>(new_rows * head_size));
+  std::vector<int8_t> k_int(q.size());
+  std::vector<int8_t> v_int(q.size());
+  for (size_t i = 0; i < q.size(); ++i) {
+    q[i] = static_cast<float>(i % 13) * 0.1f - 0.6f;
+    k_int[i] = static_cast<int8_t>(static_cast<int>((i * 37) % 201) - 100);
+    v_int[i] = static_cast<int8_t>(static_cast<int>((i * 53) % 211) - 105);
+  }
+  for (int64_t r = 0; r < new_rows; ++r) {
+    k_int[static_cast<size_t>(r * head_size)] = (r % 2) ? 127 : -127;
+    v_int[static_cast<size_t>(r * head_size + head_size - 1)] = (r % 2) ? -127 : 127;
+  }
+
+  std::vector<float> k(k_int.size());
+  std::vector<float> v(v_int.size());
+  for (size_t i = 0; i < k.size(); ++i) {
+    k[i] = static_cast<float>(k_int[i]) * 0.01f;
+    v[i] = static_cast<float>(v_int[i]) * 0.01f;
+  }
+  const float new_scale = (127.0f * 0.01f) / 127.0f;
+
+  // Positions past the valid prefix hold a large sentinel scale; any read of them would blow up the softmax.
+  std::vector<int8_t> past_k(static_cast<size_t>(batch * heads * max_seq * head_size), 127);
+  std::vector<int8_t> past_v(past_k.size(), 127);
+  std::vector<float> past_k_scale(static_cast<size_t>(batch * heads * max_seq), 100.0f);
+  std::vector<float> past_v_scale(past_k_scale.size(), 100.0f);
+  for (int64_t bn = 0; bn < batch * heads; ++bn) {
+    for (int64_t s = 0; s < past; ++s) {
+      const size_t row = static_cast<size_t>(bn * max_seq + s);
+      past_k_scale[row] = 0.004f * static_cast<float>(1 + row % 3);
+      past_v_scale[row] = 0.005f * static_cast<float>(1 + row % 4);
+      for (int64_t h = 0; h < head_size; ++h) {
+        const size_t idx = row * static_cast<size_t>(head_size) + static_cast<size_t>(h);
+        past_k[idx] = static_cast<int8_t>(static_cast<int>((idx * 7) % 255) - 127);
+        past_v[idx] = static_cast<int8_t>(static_cast<int>((idx * 5) % 255) - 127);
+      }
+    }
+  }
+
+  std::vector<int8_t> present_k = past_k;
+  std::vector<int8_t> present_v = past_v;
+  std::vector<float> present_k_scale = past_k_scale;
+  std::vector<float> present_v_scale = past_v_scale;
+  for (int64_t bn = 0; bn < batch * heads; ++bn) {
+    std::copy_n(k_int.begin() + bn * seq * head_size, seq * head_size,
+                present_k.begin() + (bn * max_seq + past) * head_size);
+    std::copy_n(v_int.begin() + bn * seq * head_size, seq * head_size,
+                present_v.begin() + (bn * max_seq + past) * head_size);
+    std::fill_n(present_k_scale.begin() + bn * max_seq + past, seq, new_scale);
+    std::fill_n(present_v_scale.begin() + bn * max_seq + past, seq, new_scale);
+  }
+
+  // The reference attends over the dequantized cache.
+  std::vector<float> k_cache(present_k.size());
+  std::vector<float> v_cache(present_v.size());
+  for (size_t i = 0; i < k_cache.size(); ++i) {
+    const size_t row = i / static_cast<size_t>(head_size);
+    k_cache[i] = static_cast<float>(present_k[i]) * present_k_scale[row];
+    v_cache[i] = static_cast<float>(present_v[i]) * present_v_scale[row];
+  }
+
+  const float scale = 1.0f / std::sqrt(static_cast<float>(head_size));
+  const std::vector<float> expected_output =
+      ComputeDecoderAttentionReference(q, k_cache, v_cache, batch, heads, seq, past, max_seq, head_size, scale);
+
+  OpTester test("DecoderMaskedAttention", 1, kMyCustomDomain);
+  test.AddInput<float>("query", new_shape, q);
+  test.AddInput<float>("key", new_shape, k);
+  test.AddInput<float>("value", new_shape, v);
+  test.AddInput<int8_t>("past_key", cache_shape, past_k);
+  test.AddInput<int8_t>("past_value", cache_shape, past_v);
+  test.AddInput<int32_t>("past_sequence_length", {1}, {static_cast<int32_t>(past)});
+  test.AddInput<float>("past_key_scale", scale_shape, past_k_scale);
+  test.AddInput<float>("past_value_scale", scale_shape, past_v_scale);
+  test.AddOutput<float>("output", {batch, seq, heads, head_size}, expected_output);
+  test.AddOutput<int8_t>("present_key", cache_shape, present_k);
+  test.AddOutput<int8_t>("present_value", cache_shape, present_v);
+  test.AddOutput<float>("present_key_scale", scale_shape, present_k_scale);
+  test.AddOutput<float>("present_value_scale", scale_shape, present_v_scale);
+
+  std::vector<int32_t> past_seq_len{static_cast<int32_t>(past)};
+  std::unordered_map<std::string, OrtValue> feeds{
+      {"query", WrapBuffer(new_shape, q)},
+      {"key", WrapBuffer(new_shape, k)},
+      {"value", WrapBuffer(new_shape, v)},
+      {"past_key", WrapBuffer(cache_shape, past_k)},
+      {"past_value", WrapBuffer(cache_shape, past_v)},
+      {"past_sequence_length", WrapBuffer({1}, past_seq_len)},
+      {"past_key_scale", WrapBuffer(scale_shape, past_k_scale)},
+      {"past_value_scale", WrapBuffer(scale_shape, past_v_scale)}};
+  std::vector<float> output;
+  RunWithSharedCache(test, feeds, {"key", "value", "key_scale", "value_scale"}, output);
+  ExpectOutputNear(expected_output, output);
+  EXPECT_EQ(present_k, past_k);
+  EXPECT_EQ(present_v, past_v);
+  EXPECT_EQ(present_k_scale, past_k_scale);
+  EXPECT_EQ(present_v_scale, past_v_scale);
+}
+
+TEST(MyCpuDecoderMaskedAttentionTest, Int8CacheSingleTokenStep) {
+  RunQuantizedDecoderMaskedAttentionTest(2, 2, 1, 5, 8, 16);
+}
+
+TEST(MyCpuDecoderMaskedAttentionTest, Int8CachePrefill) {
+  RunQuantizedDecoderMaskedAttentionTest(1, 2, 4, 0, 8, 8);
+}
+
+TEST(MyCpuDecoderMaskedAttentionTest, Int8CacheMissingScales) {
+  onnxruntime::contrib::RegisterMyVirtualNpuSchemas();
+
+  const std::vector<int64_t> new_shape{1, 1, 1, 4};
+  const std::vector<int64_t> cache_shape{1, 1, 4, 4};
+  OpTester test("DecoderMaskedAttention", 1, kMyCustomDomain);
+  test.AddInput<float>("query", new_shape, std::vector<float>(4, 0.1f));
+  test.AddInput<float>("key", new_shape, std::vector<float>(4, 0.1f));
+  test.AddInput<float>("value", new_shape, std::vector<float>(4, 0.1f));
+  test.AddInput<int8_t>("past_key", cache_shape, std::vector<int8_t>(16, 0));
+  test.AddInput<int8_t>("past_value", cache_shape, std::vector<int8_t>(16, 0));
+  test.AddInput<int32_t>("past_sequence_length", {1}, {1});
+  test.AddOutput<float>("output", {1, 1, 1, 4}, std::vector<float>(4, 0.0f));
+  test.AddOutput<int8_t>("present_key", cache_shape, std::vector<int8_t>(16, 0));
+  test.AddOutput<int8_t>("present_value", cache_shape, std::vector<int8_t>(16, 0));
+  test.Run(OpTester::ExpectResult::kExpectFailure, "are required with an int8 cache");
+}
+
+// Without the cache bound onto the past buffers the step would have to copy the whole cache; it fails instead.
+TEST(MyCpuDecoderMaskedAttentionTest, CacheNotShared) {
+  onnxruntime::contrib::RegisterMyVirtualNpuSchemas();
+
+  const std::vector<int64_t> new_shape{1, 1, 1, 4};
+  const std::vector<int64_t> cache_shape{1, 1, 4, 4};
+  OpTester test("DecoderMaskedAttention", 1, kMyCustomDomain);
+  test.AddInput<float>("query", new_shape, std::vector<float>(4, 0.1f));
+  test.AddInput<float>("key", new_shape, std::vector<float>(4, 0.1f));
+  test.AddInput<float>("value", new_shape, std::vector<float>(4, 0.1f));
+  test.AddInput<float>("past_key", cache_shape, std::vector<float>(16, 0.0f));
+  test.AddInput<float>("past_value", cache_shape, std::vector<float>(16, 0.0f));
+  test.AddInput<int32_t>("past_sequence_length", {1}, {1});
+  test.AddOutput<float>("output", {1, 1, 1, 4}, std::vector<float>(4, 0.0f));
+  test.AddOutput<float>("present_key", cache_shape, std::vector<float>(16, 0.0f));
+  test.AddOutput<float>("present_value", cache_shape, std::vector<float>(16, 0.0f));
+  test.Run(OpTester::ExpectResult::kExpectFailure, "present_key must share the buffer of past_key");
+}
+
+TEST(MyCpuDecoderMaskedAttentionTest, CacheOverflow) {
+  onnxruntime::contrib::RegisterMyVirtualNpuSchemas();
+
+  const std::vector<int64_t> new_shape{1, 1, 2, 4};
+  const std::vector<int64_t> cache_shape{1, 1, 4, 4};
+  OpTester test("DecoderMaskedAttention", 1, kMyCustomDomain);
+  test.AddInput<float>("query", new_shape, std::vector<float>(8, 0.1f));
+  test.AddInput<float>("key", new_shape, std::vector<float>(8, 0.1f));
+  test.AddInput<float>("value", new_shape, std::vector<float>(8, 0.1f));
+  test.AddInput<float>("past_key", cache_shape, std::vector<float>(16, 0.0f));
+  test.AddInput<float>("past_value", cache_shape, std::vector<float>(16, 0.0f));
+  test.AddInput<int32_t>("past_sequence_length", {1}, {3});
+  test.AddOutput<float>("output", {1, 2, 1, 4}, std::vector<float>(8, 0.0f));
+  test.AddOutput<float>("present_key", cache_shape, std::vector<float>(16, 0.0f));
+  test.AddOutput<float>("present_value", cache_shape, std::vector<float>(16, 0.0f));
+  test.Run(OpTester::ExpectResult::kExpectFailure, "must be within the cache capacity");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
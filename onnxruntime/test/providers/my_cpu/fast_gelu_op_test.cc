@@ -5,6 +5,8 @@
 #include "test/providers/provider_test_utils.h"
 #include "core/graph/constants.h"
 #include "core/graph/contrib_ops/contrib_defs.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/unittest_util/function_test_util.h"
 
 namespace onnxruntime {
 namespace test {
@@ -146,14 +148,114 @@ TEST(FastGeluTest, LargeTensor) {
   test.Run();
 }
 
-// TODO-OPTIMIZE: [Test] Add performance benchmark test
-/*
-TEST(FastGeluTest, DISABLED_BenchmarkPerformance) {
-  // Compare basic implementation vs optimized version
-  // Measure throughput (GB/s) and latency (ms)
-  // Test different tensor sizes: small, medium, large
+// Test a size that spans several thread pool chunks and leaves a vector tail
+TEST(FastGeluTest, MultiChunkOddSize) {
+  OpTester test("FastGelu", 1, kMyCustomDomain);
+
+  std::vector<int64_t> shape = {3, 4099};
+  size_t count = 3 * 4099;
+
+  std::vector<float> input(count);
+  std::vector<float> expected_output(count);
+
+  for (size_t i = 0; i < count; ++i) {
+    float x = static_cast<float>(i % 997) / 83.0f - 6.0f;  // Range [-6, 6]
+    input[i] = x;
+
+    constexpr float kAlpha = 0.7978845608028654f;
+    constexpr float kBeta = 0.044715f;
+    float inner = kAlpha * (x + kBeta * x * x * x);
+    expected_output[i] = 0.5f * x * (1.0f + std::tanh(inner));
+  }
+
+  test.AddInput<float>("X", shape, input);
+  test.AddOutput<float>("Y", shape, expected_output);
+  test.Run();
+}
+
+static std::vector<float> MakeGeluTestInput(size_t count) {
+  std::vector<float> input(count);
+  for (size_t i = 0; i < count; ++i) {
+    input[i] = static_cast<float>(i % 89) / 11.0f - 4.0f;  // Range [-4, 4]
+  }
+  return input;
+}
+
+static std::vector<float> ComputeGeluReference(const std::vector<float>& input) {
+  constexpr double kAlpha = 0.7978845608028654;
+  constexpr double kBeta = 0.044715;
+  std::vector<float> output(input.size());
+  for (size_t i = 0; i < input.size(); ++i) {
+    double x = input[i];
+    output[i] = static_cast<float>(0.5 * x * (1.0 + std::tanh(kAlpha * (x + kBeta * x * x * x))));
+  }
+  return output;
+}
+
+// Test float16 (spans several chunks to exercise per-chunk conversion)
+TEST(FastGeluTest, MyCpuFloat16) {
+  OpTester test("FastGelu", 1, kMyCustomDomain);
+
+  std::vector<int64_t> shape = {2, 4100};
+  std::vector<float> input = MakeGeluTestInput(2 * 4100);
+
+  test.AddInput<MLFloat16>("X", shape, ToFloat16(input));
+  test.AddOutput<MLFloat16>("Y", shape, ToFloat16(ComputeGeluReference(input)));
+  test.SetOutputTolerance(0.005f);
+  test.Run();
+}
+
+// Test bfloat16
+TEST(FastGeluTest, MyCpuBFloat16) {
+  OpTester test("FastGelu", 1, kMyCustomDomain);
+
+  std::vector<int64_t> shape = {3, 768};
+  std::vector<float> input = MakeGeluTestInput(3 * 768);
+
+  test.AddInput<BFloat16>("X", shape, FloatsToBFloat16s(input));
+  test.AddOutput<BFloat16>("Y", shape, FloatsToBFloat16s(ComputeGeluReference(input)));
+  test.SetOutputTolerance(0.05f);
+  test.Run();
+}
+
+// Test double
+TEST(FastGeluTest, MyCpuDouble) {
+  OpTester test("FastGelu", 1, kMyCustomDomain);
+
+  std::vector<int64_t> shape = {4, 33};
+  std::vector<float> input = MakeGeluTestInput(4 * 33);
+  std::vector<float> expected = ComputeGeluReference(input);
+
+  test.AddInput<double>("X", shape, std::vector<double>(input.begin(), input.end()));
+  test.AddOutput<double>("Y", shape, std::vector<double>(expected.begin(), expected.end()));
+  test.SetOutputTolerance(1e-6f);
+  test.Run();
+}
+
+// The function body is what EPs without a kMyCustomDomain kernel inline; it must agree with the kernel.
+template <typename T, bool RunTest = true>
+static void CheckMyCpuFastGeluFunctionBody() {
+  EnsureSchemasRegistered();
+  FunctionTestCase test_case("FastGelu", kMyCustomDomain);
+  test_case.AddOpset(kOnnxDomain, 13);
+  test_case.AddOpset(kMyCustomDomain, 1);
+  test_case.AddInput<T, RunTest>("x", {8, 16});
+  test_case.AddOutput("y");
+
+  if (RunTest)
+    test_case.RunTest();
+  else
+    test_case.CreateModel(true);
+}
+
+TEST(FastGeluTest, MyCpuFunctionBody) {
+  // Expand and compare against the kernel
+  CheckMyCpuFastGeluFunctionBody<float>();
+  // Expand and check only
+  CheckMyCpuFastGeluFunctionBody<double, false>();
+  CheckMyCpuFastGeluFunctionBody<MLFloat16, false>();
+  CheckMyCpuFastGeluFunctionBody<BFloat16, false>();
 }
-*/
 
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,162 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+#include "core/graph/constants.h"
+#include "core/graph/contrib_ops/contrib_defs.h"
+
+namespace onnxruntime {
+namespace test {
+
+// Reference implementation: LayerNorm(input + skip + bias) * gamma + beta
+static void ComputeReference(const std::vector<float>& input,
+                             const std::vector<float>& skip,
+                             const std::vector<float>& gamma,
+                             const std::vector<float>& beta,
+                             const std::vector<float>& bias,
+                             int64_t hidden_size,
+                             float epsilon,
+                             std::vector<float>& output,
+                             std::vector<float>& sum) {
+  const size_t hidden = static_cast<size_t>(hidden_size);
+  const size_t rows = input.size() / hidden;
+  output.resize(input.size());
+  sum.resize(input.size());
+
+  for (size_t r = 0; r < rows; ++r) {
+    double mean = 0.0;
+    for (size_t h = 0; h < hidden; ++h) {
+      size_t i = r * hidden + h;
+      float val = input[i] + skip[i % skip.size()];
+      if (!bias.empty()) {
+        val += bias[h];
+      }
+      sum[i] = val;
+      mean += val;
+    }
+    mean /= hidden;
+
+    double variance = 0.0;
+    for (size_t h = 0; h < hidden; ++h) {
+      double diff = sum[r * hidden + h] - mean;
+      variance += diff * diff;
+    }
+    variance /= hidden;
+
+    for (size_t h = 0; h < hidden; ++h) {
+      size_t i = r * hidden + h;
+      double val = (sum[i] - mean) / std::sqrt(variance + epsilon) * gamma[h];
+      if (!beta.empty()) {
+        val += beta[h];
+      }
+      output[i] = static_cast<float>(val);
+    }
+  }
+}
+
+static void RunSkipLayerNormTest(const std::vector<int64_t>& input_shape,
+                                 const std::vector<int64_t>& skip_shape,
+                                 bool has_beta,
+                                 bool has_bias,
+                                 bool output_sum) {
+  onnxruntime::contrib::RegisterMyVirtualNpuSchemas();
+
+  const int64_t hidden_size = input_shape.back();
+  int64_t input_size = 1;
+  for (auto dim : input_shape) input_size *= dim;
+  int64_t skip_size = 1;
+  for (auto dim : skip_shape) skip_size *= dim;
+
+  std::vector<float> input(static_cast<size_t>(input_size));
+  std::vector<float> skip(static_cast<size_t>(skip_size));
+  std::vector<float> gamma(static_cast<size_t>(hidden_size));
+  std::vector<float> beta;
+  std::vector<float> bias;
+
+  for (size_t i = 0; i < input.size(); ++i) input[i] = static_cast<float>(i % 13) * 0.25f - 1.5f;
+  for (size_t i = 0; i < skip.size(); ++i) skip[i] = static_cast<float>(i % 7) * 0.1f - 0.3f;
+  for (size_t i = 0; i < gamma.size(); ++i) gamma[i] = 1.0f + static_cast<float>(i % 5) * 0.05f;
+  if (has_beta) {
+    beta.resize(static_cast<size_t>(hidden_size));
+    for (size_t i = 0; i < beta.size(); ++i) beta[i] = static_cast<float>(i % 3) * 0.2f - 0.2f;
+  }
+  if (has_bias) {
+    bias.resize(static_cast<size_t>(hidden_size));
+    for (size_t i = 0; i < bias.size(); ++i) bias[i] = static_cast<float>(i % 4) * 0.05f;
+  }
+
+  constexpr float epsilon = 1e-5f;
+  std::vector<float> expected_output;
+  std::vector<float> expected_sum;
+  ComputeReference(input, skip, gamma, beta, bias, hidden_size, epsilon, expected_output, expected_sum);
+
+  OpTester test("SkipLayerNormalization", 1, kMyCustomDomain);
+  test.AddAttribute("epsilon", epsilon);
+  test.AddInput<float>("input", input_shape, input);
+  test.AddInput<float>("skip", skip_shape, skip);
+  test.AddInput<float>("gamma", {hidden_size}, gamma);
+  if (has_beta) {
+    test.AddInput<float>("beta", {hidden_size}, beta);
+  } else if (has_bias) {
+    test.AddOptionalInputEdge<float>();
+  }
+  if (has_bias) {
+    test.AddInput<float>("bias", {hidden_size}, bias);
+  }
+
+  test.AddOutput<float>("output", input_shape, expected_output);
+  if (output_sum) {
+    test.AddOutput<float>("input_skip_bias_sum", input_shape, expected_sum);
+  }
+  test.Run();
+}
+
+TEST(MyCpuSkipLayerNormTest, Basic) {
+  RunSkipLayerNormTest({2, 3, 8}, {2, 3, 8}, true, false, false);
+}
+
+TEST(MyCpuSkipLayerNormTest, WithBiasAndSum) {
+  RunSkipLayerNormTest({2, 4, 16}, {2, 4, 16}, true, true, true);
+}
+
+TEST(MyCpuSkipLayerNormTest, NoBeta) {
+  RunSkipLayerNormTest({1, 5, 12}, {1, 5, 12}, false, true, true);
+}
+
+TEST(MyCpuSkipLayerNormTest, BroadcastSkip) {
+  RunSkipLayerNormTest({3, 4, 8}, {4, 8}, true, true, false);
+}
+
+TEST(MyCpuSkipLayerNormTest, BroadcastSkipBatchOfOne) {
+  RunSkipLayerNormTest({3, 4, 8}, {1, 4, 8}, true, false, false);
+}
+
+TEST(MyCpuSkipLayerNormTest, BroadcastSkipHiddenOnly) {
+  RunSkipLayerNormTest({2, 3, 8}, {8}, false, true, true);
+}
+
+// skip shapes whose size divides the input size but that do not broadcast over the rows
+TEST(MyCpuSkipLayerNormTest, InvalidSkipShape) {
+  onnxruntime::contrib::RegisterMyVirtualNpuSchemas();
+
+  const std::vector<std::vector<int64_t>> skip_shapes = {{1, 8}, {2, 1, 8}, {6, 8}, {2, 2, 3, 8}};
+  for (const auto& skip_shape : skip_shapes) {
+    int64_t skip_size = 1;
+    for (auto dim : skip_shape) skip_size *= dim;
+
+    OpTester test("SkipLayerNormalization", 1, kMyCustomDomain);
+    test.AddInput<float>("input", {2, 3, 8}, std::vector<float>(48, 1.0f));
+    test.AddInput<float>("skip", skip_shape, std::vector<float>(static_cast<size_t>(skip_size), 1.0f));
+    test.AddInput<float>("gamma", {8}, std::vector<float>(8, 1.0f));
+    test.AddOutput<float>("output", {2, 3, 8}, std::vector<float>(48, 0.0f));
+    test.Run(OpTester::ExpectResult::kExpectFailure, "skip is expected to have shape");
+  }
+}
+
+TEST(MyCpuSkipLayerNormTest, GPT2HiddenSize) {
+  RunSkipLayerNormTest({1, 8, 768}, {1, 8, 768}, true, true, true);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -2676,5 +2676,156 @@ class TestGQA(unittest.TestCase):
         )
 
 
+def create_group_query_attention_graph_int8_cache(batch_size, sequence_length, num_heads, kv_num_heads, head_size,
+                                                  past_seqlen, present_seqlen, cache_type):
+    quantized = cache_type == TensorProto.INT8
+    inputs = ["query", "key", "value", "past_key", "past_value", "seqlens_k", "total_sequence_length"]
+    outputs = ["output", "present_key", "present_value"]
+    if quantized:
+        inputs += ["", "", "", "", "", "past_key_scale", "past_value_scale"]
+        outputs += ["", "present_key_scale", "present_value_scale"]
+
+    node = helper.make_node(
+        "GroupQueryAttention",
+        inputs,
+        outputs,
+        "GroupQueryAttention_0",
+        num_heads=num_heads,
+        kv_num_heads=kv_num_heads,
+        domain="com.microsoft",
+    )
+
+    graph_input = [
+        helper.make_tensor_value_info("query", TensorProto.FLOAT, [batch_size, sequence_length, num_heads * head_size]),
+        helper.make_tensor_value_info("key", TensorProto.FLOAT, [batch_size, sequence_length, kv_num_heads * head_size]),
+        helper.make_tensor_value_info(
+            "value", TensorProto.FLOAT, [batch_size, sequence_length, kv_num_heads * head_size]
+        ),
+        helper.make_tensor_value_info("past_key", cache_type, [batch_size, kv_num_heads, past_seqlen, head_size]),
+        helper.make_tensor_value_info("past_value", cache_type, [batch_size, kv_num_heads, past_seqlen, head_size]),
+        helper.make_tensor_value_info("seqlens_k", TensorProto.INT32, [batch_size]),
+        helper.make_tensor_value_info("total_sequence_length", TensorProto.INT32, [1]),
+    ]
+    graph_output = [
+        helper.make_tensor_value_info("output", TensorProto.FLOAT, [batch_size, sequence_length, num_heads * head_size]),
+        helper.make_tensor_value_info("present_key", cache_type, [batch_size, kv_num_heads, present_seqlen, head_size]),
+        helper.make_tensor_value_info(
+            "present_value", cache_type, [batch_size, kv_num_heads, present_seqlen, head_size]
+        ),
+    ]
+    if quantized:
+        for name in ["past_key_scale", "past_value_scale"]:
+            graph_input.append(helper.make_tensor_value_info(name, TensorProto.FLOAT, [batch_size, kv_num_heads, past_seqlen]))
+        for name in ["present_key_scale", "present_value_scale"]:
+            graph_output.append(
+                helper.make_tensor_value_info(name, TensorProto.FLOAT, [batch_size, kv_num_heads, present_seqlen])
+            )
+
+    graph = helper.make_graph([node], "GroupQueryAttention_Graph", graph_input, graph_output)
+    model = helper.make_model(graph)
+    return model.SerializeToString()
+
+
+def quantize_cache_rows(cache):
+    scale = numpy.abs(cache).max(axis=-1) / 127.0
+    scale[scale == 0.0] = 1.0
+    quantized = numpy.clip(numpy.round(cache / scale[..., None]), -128, 127).astype(numpy.int8)
+    return quantized, scale.astype(numpy.float32)
+
+
+class TestGQAInt8Cache(unittest.TestCase):
+    batch_size = 2
+    sequence_length = 1
+    num_heads = 4
+    kv_num_heads = 2
+    head_size = 16
+    past_seqlen = 5
+    max_seqlen = 8
+
+    def inputs(self):
+        rng = numpy.random.default_rng(0)
+        b, s, h = self.batch_size, self.sequence_length, self.head_size
+        query = rng.standard_normal((b, s, self.num_heads * h)).astype(numpy.float32)
+        key = rng.standard_normal((b, s, self.kv_num_heads * h)).astype(numpy.float32)
+        value = rng.standard_normal((b, s, self.kv_num_heads * h)).astype(numpy.float32)
+        past_key = numpy.zeros((b, self.kv_num_heads, self.max_seqlen, h), dtype=numpy.float32)
+        past_value = numpy.zeros_like(past_key)
+        past_key[:, :, : self.past_seqlen] = rng.standard_normal((b, self.kv_num_heads, self.past_seqlen, h))
+        past_value[:, :, : self.past_seqlen] = rng.standard_normal((b, self.kv_num_heads, self.past_seqlen, h))
+        total = self.past_seqlen + s
+        seqlens_k = numpy.full((b,), total - 1, dtype=numpy.int32)
+        total_sequence_length = numpy.array([total], dtype=numpy.int32)
+        return query, key, value, past_key, past_value, seqlens_k, total_sequence_length
+
+    def test_int8_cache_matches_float_cache(self):
+        query, key, value, past_key, past_value, seqlens_k, total_sequence_length = self.inputs()
+        past_key_q, past_key_scale = quantize_cache_rows(past_key)
+        past_value_q, past_value_scale = quantize_cache_rows(past_value)
+        # the float reference uses the same past rows as the int8 cache
+        past_key_ref = past_key_q.astype(numpy.float32) * past_key_scale[..., None]
+        past_value_ref = past_value_q.astype(numpy.float32) * past_value_scale[..., None]
+
+        args = (self.batch_size, self.sequence_length, self.num_heads, self.kv_num_heads, self.head_size)
+        float_session = InferenceSession(
+            create_group_query_attention_graph_int8_cache(
+                *args, self.max_seqlen, self.max_seqlen, TensorProto.FLOAT
+            ),
+            providers=["CPUExecutionProvider"],
+        )
+        output_ref, present_key_ref, _ = float_session.run(
+            None,
+            {
+                "query": query,
+                "key": key,
+                "value": value,
+                "past_key": past_key_ref,
+                "past_value": past_value_ref,
+                "seqlens_k": seqlens_k,
+                "total_sequence_length": total_sequence_length,
+            },
+        )
+
+        int8_session = InferenceSession(
+            create_group_query_attention_graph_int8_cache(*args, self.max_seqlen, self.max_seqlen, TensorProto.INT8),
+            providers=["CPUExecutionProvider"],
+        )
+        feeds = {
+            "query": query,
+            "key": key,
+            "value": value,
+            "past_key": past_key_q,
+            "past_value": past_value_q,
+            "seqlens_k": seqlens_k,
+            "total_sequence_length": total_sequence_length,
+            "past_key_scale": past_key_scale,
+            "past_value_scale": past_value_scale,
+        }
+
+        # separate past and present buffers
+        output, present_key, _, present_key_scale, _ = int8_session.run(None, feeds)
+        numpy.testing.assert_allclose(output, output_ref, rtol=0, atol=5e-2)
+        total = self.past_seqlen + self.sequence_length
+        present_key_dequant = present_key.astype(numpy.float32) * present_key_scale[..., None]
+        numpy.testing.assert_allclose(present_key_dequant[:, :, :total], present_key_ref[:, :, :total], atol=2e-2)
+
+        # present shares the past buffers, so the new row is appended in place
+        io_binding = int8_session.io_binding()
+        cache = {name: OrtValue.ortvalue_from_numpy(feeds[name]) for name in
+                 ["past_key", "past_value", "past_key_scale", "past_value_scale"]}
+        for name in ["query", "key", "value", "seqlens_k", "total_sequence_length"]:
+            io_binding.bind_cpu_input(name, feeds[name])
+        for name, ort_value in cache.items():
+            io_binding.bind_ortvalue_input(name, ort_value)
+            io_binding.bind_ortvalue_output(name.replace("past", "present"), ort_value)
+        io_binding.bind_output("output")
+        int8_session.run_with_iobinding(io_binding)
+
+        numpy.testing.assert_allclose(io_binding.copy_outputs_to_cpu()[0], output_ref, rtol=0, atol=5e-2)
+        numpy.testing.assert_array_equal(cache["past_key"].numpy()[:, :, :total], present_key[:, :, :total])
+        numpy.testing.assert_array_equal(
+            cache["past_key_scale"].numpy()[:, :, :total], present_key_scale[:, :, :total]
+        )
+
+
 if __name__ == "__main__":
     unittest.main()
@@ -3,9 +3,12 @@
 
 #include <algorithm>
 #include <atomic>
+#include <cmath>
+#include <cstdio>
 #include <fstream>
 #include <future>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <mutex>
 #include <sstream>
@@ -4576,6 +4579,137 @@ TEST(CApiTest, RunAsyncFail) {
   EXPECT_THROW(session.RunAsync(run_options, input_names, input_tensors, 1, output_names, output_values, 1, CallbackFail, nullptr), std::exception);
 }
 
+namespace {
+struct DynamicBatchingRequest {
+  std::vector<float> x;
+  std::vector<int64_t> x_dims;
+  Ort::Value input{nullptr};
+  Ort::Value output{nullptr};
+  std::atomic_bool done{false};
+};
+
+void CallbackDynamicBatching(void* user_data, OrtValue** outputs, size_t num_outputs, OrtStatusPtr status_ptr) {
+  auto* request = reinterpret_cast<DynamicBatchingRequest*>(user_data);
+  Ort::Status status(status_ptr);
+  EXPECT_TRUE(status.IsOK()) << status.GetErrorMessage();
+  EXPECT_EQ(num_outputs, 1UL);
+  if (status.IsOK() && num_outputs == 1) {
+    Ort::ConstValue output{outputs[0]};
+    EXPECT_EQ(output.GetTensorTypeAndShapeInfo().GetShape(), request->x_dims);
+    const float* y = output.GetTensorData<float>();
+    for (size_t i = 0; i < request->x.size(); ++i) {
+      EXPECT_EQ(y[i], std::abs(request->x[i]));
+    }
+  }
+  request->done.store(true);
+}
+}  // namespace
+
+TEST(CApiTest, RunAsyncDynamicBatching) {
+  Ort::SessionOptions session_options;
+  session_options.SetIntraOpNumThreads(2);
+  session_options.AddConfigEntry(kOrtSessionOptionsDynamicBatchingMaxBatchSize, "4");
+  // Long enough for all requests to be queued before the timeout flushes a partial batch.
+  session_options.AddConfigEntry(kOrtSessionOptionsDynamicBatchingTimeoutUs, "200000");
+  // Every Run records a model_run event, which shows how many runs served the requests.
+#ifdef _WIN32
+  session_options.EnableProfiling(L"dynamic_batching_profile");
+#else
+  session_options.EnableProfiling("dynamic_batching_profile");
+#endif
+  // y = Abs(x) with x of shape [Dim1, Dim2, 5]
+  Ort::Session session(*ort_env, TSTR("testdata/abs_free_dimensions.onnx"), session_options);
+
+  const char* input_names[] = {"x"};
+  const char* output_names[] = {"y"};
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+  Ort::RunOptions run_options;
+
+  // Batch sizes 1 + 2 + 1 fill one batch of 4. The last request pre-allocates its output.
+  const int64_t batch_sizes[] = {1, 2, 1};
+  std::vector<float> preallocated(2 * 5);
+  DynamicBatchingRequest requests[3];
+  for (size_t r = 0; r < 3; ++r) {
+    auto& request = requests[r];
+    request.x_dims = {batch_sizes[r], 2, 5};
+    request.x.resize(static_cast<size_t>(batch_sizes[r] * 2 * 5));
+    for (size_t i = 0; i < request.x.size(); ++i) {
+      request.x[i] = (i % 2 == 0 ? -1.f : 1.f) * static_cast<float>(r * 100 + i);
+    }
+    request.input = Ort::Value::CreateTensor<float>(memory_info, request.x.data(), request.x.size(),
+                                                    request.x_dims.data(), request.x_dims.size());
+    if (r == 2) {
+      request.output = Ort::Value::CreateTensor<float>(memory_info, preallocated.data(), preallocated.size(),
+                                                       request.x_dims.data(), request.x_dims.size());
+    }
+  }
+
+  for (auto& request : requests) {
+    EXPECT_NO_THROW(session.RunAsync(run_options, input_names, &request.input, 1, output_names, &request.output, 1,
+                                     CallbackDynamicBatching, &request));
+  }
+
+  std::chrono::duration<double, std::milli> dur{100};
+  for (auto& request : requests) {
+    // timeout in about 10 secs
+    for (int i = 0; i < 100 && !request.done.load(); ++i) {
+      std::this_thread::sleep_for(dur);
+    }
+    EXPECT_TRUE(request.done.load());
+  }
+
+  for (size_t i = 0; i < preallocated.size(); ++i) {
+    EXPECT_EQ(preallocated[i], std::abs(requests[2].x[i]));
+  }
+
+  // The three requests were coalesced into a single Run.
+  Ort::AllocatorWithDefaultOptions allocator;
+  auto profile_file = session.EndProfilingAllocated(allocator);
+  std::ifstream profile(profile_file.get());
+  ASSERT_TRUE(profile.good());
+  const std::string profile_json{std::istreambuf_iterator<char>(profile), std::istreambuf_iterator<char>()};
+  profile.close();
+  size_t num_runs = 0;
+  for (size_t pos = profile_json.find("\"model_run\""); pos != std::string::npos;
+       pos = profile_json.find("\"model_run\"", pos + 1)) {
+    ++num_runs;
+  }
+  EXPECT_EQ(num_runs, 1u);
+  std::remove(profile_file.get());
+}
+
+TEST(CApiTest, RunAsyncDynamicBatchingFixedBatch) {
+  Ort::SessionOptions session_options;
+  session_options.SetIntraOpNumThreads(2);
+  session_options.AddConfigEntry(kOrtSessionOptionsDynamicBatchingMaxBatchSize, "4");
+  // X has the fixed shape [3, 2], so batching is disabled with a warning and RunAsync runs the request as is.
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  const char* input_names[] = {"X"};
+  float x_value[] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  int64_t x_dim[] = {3, 2};
+  auto memory_info = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+  Ort::Value input_tensors[1] = {
+      Ort::Value::CreateTensor<float>(memory_info, x_value, 6, x_dim, 2),
+  };
+
+  const char* output_names[] = {"Y"};
+  Ort::RunOptions run_options;
+  Ort::Value output_values[1] = {Ort::Value{nullptr}};
+
+  atomic_wait.store(false);
+  EXPECT_NO_THROW(session.RunAsync(run_options, input_names, input_tensors, 1, output_names, output_values, 1,
+                                   CallbackSucceed, &caller_tid));
+
+  std::chrono::duration<double, std::milli> dur{100};
+  // timeout in about 10 secs
+  for (int i = 0; i < 100 && !atomic_wait.load(); ++i) {
+    std::this_thread::sleep_for(dur);
+  }
+
+  EXPECT_EQ(atomic_wait.load(), true);
+}
+
 static void TestRunWithLoraAdapter(const Ort::LoraAdapter& adapter) {
   constexpr const ORTCHAR_T* model_path = TSTR("testdata/lora/two_params_lora_model.onnx");
 